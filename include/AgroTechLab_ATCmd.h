@@ -0,0 +1,57 @@
+/**
+ * @file AgroTechLab_ATCmd.h
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief AgroTechLab AT command builder.
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#ifndef __AGROTECHLAB_ATCMD_H__
+#define __AGROTECHLAB_ATCMD_H__
+
+#include <Arduino.h>
+
+/**
+ * \def AT_CMD_BUFFER_SIZE
+ * AT command buffer size (in bytes, including the string terminator). It must hold the longest command sent to the
+ * modem, that is an <tt>AT+CMSGHEX="..."</tt> carrying the largest hexadecimal payload.
+ */
+#define AT_CMD_BUFFER_SIZE              128
+
+/**
+ * @class ATCmd
+ * @brief Fixed-capacity AT command builder.
+ *
+ * The command is assembled into an internal buffer, so no dynamic memory is used. Command prefixes are read
+ * from flash (use the \c F() macro). When an append does not fit, the command is truncated and marked as
+ * overflowed, see \ref ATCmd::overflow().
+ */
+class ATCmd {
+    private:
+        char buf[AT_CMD_BUFFER_SIZE];
+        uint8_t len = 0;
+        bool overflowed = false;
+        ATCmd& put(char c);
+
+    public:
+        ATCmd();
+        ATCmd& begin(const __FlashStringHelper* prefix);
+        ATCmd& append(const char* str);
+        ATCmd& append(const __FlashStringHelper* str);
+        ATCmd& append(char c);
+        ATCmd& appendUInt(uint16_t value);
+        ATCmd& appendQuoted(const char* str);
+        ATCmd& appendHex(const uint8_t* data, uint8_t size);
+        const char* c_str() const { return buf; }
+        uint8_t length() const { return len; }
+        bool overflow() const { return overflowed; }
+};
+#endif // __AGROTECHLAB_ATCMD_H__
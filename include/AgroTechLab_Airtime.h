@@ -0,0 +1,279 @@
+/**
+ * @file AgroTechLab_Airtime.h
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief AgroTechLab LoRa time-on-air calculator and airtime budget.
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#ifndef __AGROTECHLAB_AIRTIME_H__
+#define __AGROTECHLAB_AIRTIME_H__
+
+#include <stdint.h>
+#include "AgroTechLab_LoRaTypes.h"
+
+/**
+ * \def LORA_PREAMBLE_SYMBOLS
+ * LoRaWAN preamble length (in symbols).
+ */
+#define LORA_PREAMBLE_SYMBOLS           8
+
+/**
+ * \def LORA_CODING_RATE
+ * LoRaWAN coding rate \c CR of <tt>4/(4+CR)</tt> (1 is 4/5).
+ */
+#define LORA_CODING_RATE                1
+
+/**
+ * \def LORAWAN_OVERHEAD
+ * LoRaWAN frame bytes around the application payload: MHDR (1), FHDR without options (7), FPort (1) and MIC (4).
+ */
+#define LORAWAN_OVERHEAD                13
+
+/**
+ * \def LORA_BUDGET_WINDOW
+ * Rolling window of the airtime budget (in ms).
+ */
+#define LORA_BUDGET_WINDOW              3600000UL
+
+/**
+ * \def LORA_BUDGET_BUCKETS
+ * Buckets of the rolling window (the budget is released one bucket at a time).
+ */
+#define LORA_BUDGET_BUCKETS             12
+
+/**
+ * \def LORA_BUDGET_EU868
+ * Airtime allowed per window (in ms) in EU868: the 1 % duty cycle of the g/g1 sub-bands.
+ */
+#define LORA_BUDGET_EU868               36000UL
+
+/**
+ * \def LORA_BUDGET_FAIR_USE
+ * Airtime allowed per window (in ms) in bands without duty cycle limits: the community network fair use policy
+ * (30 s per day).
+ */
+#define LORA_BUDGET_FAIR_USE            1250UL
+
+/**
+ * @struct LoRaModulation_t
+ * @brief LoRa modulation of a data rate.
+ */
+typedef struct {
+    uint8_t sf;             /**< Spreading factor (7 to 12). */
+    uint16_t bw;            /**< Bandwidth (in kHz). */
+} LoRaModulation_t;
+
+/**
+ * @fn    loraModulation
+ * @brief LoRa modulation of the data rate \p dr in \p band (see \ref LoRaDR_e). AU920 follows the data rates of
+ * the RHF0M003 firmware, the US915-like plan before the Regional Parameters 1.0.2 (DR0 is SF10/125 kHz).
+ * @retval true - LoRa data rate.
+ * @retval false - FSK or reserved data rate.
+ */
+inline bool loraModulation(LoRaBand_e band, LoRaDR_e dr, LoRaModulation_t& modulation) {
+    if (band == EU868) {
+        if (dr <= DR5) {
+            modulation.sf = (uint8_t) (12 - dr);
+            modulation.bw = 125;
+            return true;
+        }
+        if (dr == DR6) {
+            modulation.sf = 7;
+            modulation.bw = 250;
+            return true;
+        }
+        return false;
+    }
+    if (dr <= DR3) {
+        modulation.sf = (uint8_t) (10 - dr);
+        modulation.bw = 125;
+        return true;
+    }
+    if (dr == DR4) {
+        modulation.sf = 8;
+        modulation.bw = 500;
+        return true;
+    }
+    if ((dr >= DR8) && (dr <= DR13)) {
+        modulation.sf = (uint8_t) (12 - (dr - DR8));
+        modulation.bw = 500;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @fn    loraMaxPayload
+ * @brief Largest application payload (in bytes) of an uplink at the data rate \p dr in \p band: the \c N of the
+ * LoRaWAN Regional Parameters (no FOpts, no repeater). Larger messages are rejected by the modem.
+ * @return uint8_t - maximum payload size (0 for reserved data rates).
+ */
+inline uint8_t loraMaxPayload(LoRaBand_e band, LoRaDR_e dr) {
+    if (band == EU868) {
+        if (dr <= DR2) {
+            return 51;
+        }
+        if (dr == DR3) {
+            return 115;
+        }
+        return (dr <= DR7) ? 242 : 0;
+    }
+    switch (dr) {
+        case DR0:
+            return 11;
+        case DR1:
+        case DR8:
+            return 53;
+        case DR2:
+            return 125;
+        case DR9:
+            return 129;
+        case DR3:
+        case DR4:
+        case DR10:
+        case DR11:
+        case DR12:
+        case DR13:
+            return 242;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @fn    loraAirtimeUs
+ * @brief LoRa time-on-air (in us) of a PHY payload of \p len bytes, from the Semtech formula (AN1200.13):
+ * <tt>(preamble + 4.25 + 8 + max(ceil((8 len - 4 SF + 28 + 16 CRC - 20 IH) / (4 (SF - 2 DE))) (CR + 4), 0)) x Tsym</tt>,
+ * with low data rate optimization (\c DE) above 16 ms symbols. Integer math only: the symbol time is a whole number
+ * of us for the 125, 250 and 500 kHz bandwidths.
+ * @param[in] modulation - spreading factor and bandwidth.
+ * @param[in] len - PHY payload size (in bytes).
+ * @param[in] preamble - preamble length (in symbols).
+ * @param[in] cr - coding rate \c CR of <tt>4/(4+CR)</tt>.
+ * @param[in] explicitHeader - explicit PHY header.
+ * @param[in] crc - payload CRC present (uplinks).
+ */
+inline uint32_t loraAirtimeUs(const LoRaModulation_t& modulation, uint8_t len, uint8_t preamble = LORA_PREAMBLE_SYMBOLS,
+                              uint8_t cr = LORA_CODING_RATE, bool explicitHeader = true, bool crc = true) {
+    uint32_t symbolUs = (1UL << modulation.sf) * (1000UL / modulation.bw);
+    uint8_t de = (symbolUs > 16000UL) ? 1 : 0;
+    int32_t bits = (8L * len) - (4L * modulation.sf) + 28 + (crc ? 16 : 0) - (explicitHeader ? 0 : 20);
+    int32_t perBlock = 4L * (modulation.sf - (2 * de));
+    uint32_t payloadSymbols = 8;
+    if (bits > 0) {
+        payloadSymbols += (uint32_t) ((bits + perBlock - 1) / perBlock) * (cr + 4);
+    }
+    // Preamble plus 4.25 symbols of sync word, in quarter symbols
+    return ((((4UL * preamble) + 17) * symbolUs) / 4) + (payloadSymbols * symbolUs);
+}
+
+/**
+ * @fn    loraWanAirtimeMs
+ * @brief Time-on-air (in ms, rounded up) of a LoRaWAN uplink with \p len application bytes at \p dr.
+ * @return uint32_t - airtime (0 for FSK or reserved data rates).
+ */
+inline uint32_t loraWanAirtimeMs(LoRaBand_e band, LoRaDR_e dr, uint8_t len) {
+    LoRaModulation_t modulation;
+    if (!loraModulation(band, dr, modulation)) {
+        return 0;
+    }
+    return (loraAirtimeUs(modulation, (uint8_t) (len + LORAWAN_OVERHEAD)) + 999UL) / 1000UL;
+}
+
+/**
+ * @fn    loraConfirmedTransmissions
+ * @brief Transmissions a confirmed uplink may take: the first one plus the retries set by <tt>AT+RETRY</tt>.
+ * @param[in] retry - retry times, as written to the modem (ex.: \c "3"; \c NULL or empty for none).
+ * @return uint8_t - transmissions (1 to 255).
+ */
+inline uint8_t loraConfirmedTransmissions(const char* retry) {
+    uint16_t retries = 0;
+    while ((retry != NULL) && (*retry >= '0') && (*retry <= '9') && (retries < UINT8_MAX)) {
+        retries = (uint16_t) ((retries * 10) + (*retry++ - '0'));
+    }
+    return (retries >= UINT8_MAX) ? UINT8_MAX : (uint8_t) (retries + 1);
+}
+
+/**
+ * @class AirtimeBudget
+ * @brief Rolling airtime budget: at most \c limit ms of transmissions in the last \ref LORA_BUDGET_WINDOW ms. The
+ * window is split into \ref LORA_BUDGET_BUCKETS buckets, so it costs a few bytes and constant time per check.
+ */
+class AirtimeBudget {
+    private:
+        static const uint32_t BUCKET_MS = LORA_BUDGET_WINDOW / LORA_BUDGET_BUCKETS;
+        uint16_t used[LORA_BUDGET_BUCKETS] = {0};
+        uint32_t limit = LORA_BUDGET_FAIR_USE;
+        uint32_t total = 0;
+        uint32_t bucketStart = 0;
+        uint8_t current = 0;
+
+        /** Release the buckets that left the window at \p now (in ms). */
+        void advance(uint32_t now) {
+            uint8_t steps = 0;
+            while (((uint32_t) (now - bucketStart) >= BUCKET_MS) && (steps < LORA_BUDGET_BUCKETS)) {
+                current = (uint8_t) ((current + 1) % LORA_BUDGET_BUCKETS);
+                total -= used[current];
+                used[current] = 0;
+                bucketStart += BUCKET_MS;
+                steps++;
+            }
+            if ((uint32_t) (now - bucketStart) >= BUCKET_MS) {
+                bucketStart = now;
+            }
+        }
+
+    public:
+        /** Set the airtime allowed per window (in ms), starting a window at \p now (in ms). */
+        void begin(uint32_t limitMs, uint32_t now) {
+            for (uint8_t i = 0; i < LORA_BUDGET_BUCKETS; i++) {
+                used[i] = 0;
+            }
+            limit = limitMs;
+            total = 0;
+            current = 0;
+            bucketStart = now;
+        }
+
+        /** Change the airtime allowed per window (in ms), keeping the airtime already spent. */
+        void setLimit(uint32_t limitMs) { limit = limitMs; }
+
+        /** Airtime (in ms) still available at \p now. */
+        uint32_t available(uint32_t now) {
+            advance(now);
+            return (total < limit) ? (limit - total) : 0;
+        }
+
+        /** A transmission of \p airtime ms fits the budget at \p now. */
+        bool allows(uint32_t now, uint32_t airtime) { return airtime <= available(now); }
+
+        /** Account a transmission of \p airtime ms started at \p now. */
+        void spend(uint32_t now, uint32_t airtime) {
+            advance(now);
+            uint32_t room = UINT16_MAX - used[current];
+            if (airtime > room) {
+                airtime = room;
+            }
+            used[current] = (uint16_t) (used[current] + airtime);
+            total += airtime;
+        }
+};
+
+/**
+ * @fn    loraBudgetLimit
+ * @brief Airtime allowed per \ref LORA_BUDGET_WINDOW (in ms) in \p band.
+ */
+inline uint32_t loraBudgetLimit(LoRaBand_e band) {
+    return (band == EU868) ? LORA_BUDGET_EU868 : LORA_BUDGET_FAIR_USE;
+}
+
+#endif // __AGROTECHLAB_AIRTIME_H__
@@ -0,0 +1,161 @@
+/**
+ * @file AgroTechLab_DataRate.h
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief AgroTechLab LoRa uplink data rate controller.
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#ifndef __AGROTECHLAB_DATARATE_H__
+#define __AGROTECHLAB_DATARATE_H__
+
+#include <stdint.h>
+#include "AgroTechLab_Airtime.h"
+
+/**
+ * \def DR_MARGIN_HISTORY
+ * Link margins kept by the controller. The data rate only steps up when all of them allow it.
+ */
+#define DR_MARGIN_HISTORY               4
+
+/**
+ * \def DR_INSTALLATION_MARGIN_DB
+ * Link margin (in dB) kept above the demodulation floor against fading (the LoRaWAN ADR default).
+ */
+#define DR_INSTALLATION_MARGIN_DB       10
+
+/**
+ * \def DR_STEP_DB
+ * Demodulation floor change (in dB, rounded up) of one spreading factor step (2.5 dB).
+ */
+#define DR_STEP_DB                      3
+
+/**
+ * \def DR_DOWN_MARGIN_DB
+ * Link margin (in dB) below which the data rate steps down. Together with the step up threshold
+ * (<tt>DR_INSTALLATION_MARGIN_DB + DR_STEP_DB</tt>) it sets the hysteresis band.
+ */
+#define DR_DOWN_MARGIN_DB               5
+
+/**
+ * \def DR_LINK_CHECK_PERIOD
+ * Uplinks without downlink feedback before a link check is requested (and again every such period).
+ */
+#define DR_LINK_CHECK_PERIOD            8
+
+/**
+ * \def DR_BACKOFF_UPLINKS
+ * Uplinks without downlink feedback (link checks included) before the data rate steps down.
+ */
+#define DR_BACKOFF_UPLINKS              24
+
+/**
+ * @fn    loraRequiredSnr
+ * @brief Demodulation floor (SNR in 0.1 dB) of a spreading factor: -7.5 dB at SF7, 2.5 dB lower per step.
+ */
+inline int16_t loraRequiredSnr(uint8_t sf) {
+    return (int16_t) (-75 - (25 * ((int16_t) sf - 7)));
+}
+
+/**
+ * @class DataRateController
+ * @brief Device side data rate control (the network ADR must be off). Each uplink feeds the link margin measured
+ * on its downlink (the downlink SNR above the demodulation floor of the current spreading factor, or the margin of
+ * a link check answer) into a short history. The data rate steps up one step when the whole history is above
+ * <tt>DR_INSTALLATION_MARGIN_DB + DR_STEP_DB</tt>, and steps down as soon as a margin falls below
+ * \ref DR_DOWN_MARGIN_DB (or after \ref DR_BACKOFF_UPLINKS uplinks without feedback). The history restarts at every
+ * change, so it never oscillates between two rates.
+ */
+class DataRateController {
+    private:
+        int8_t margins[DR_MARGIN_HISTORY];
+        uint8_t count = 0;
+        uint8_t head = 0;
+        uint8_t silent = 0;
+        uint32_t fed = 0;           /**< Uplink results fed (see \ref results()). */
+        LoRaBand_e band = EU868;
+        LoRaDR_e dr = DR0;
+        LoRaDR_e maxDr = DR5;
+
+        /** Move to \p next and restart the history. */
+        void change(LoRaDR_e next) {
+            dr = next;
+            count = 0;
+            head = 0;
+            silent = 0;
+        }
+
+    public:
+        /** Start at \p initial in \p band (only 125 kHz data rates are used). */
+        void begin(LoRaBand_e loraBand, LoRaDR_e initial) {
+            band = loraBand;
+            maxDr = (band == EU868) ? DR5 : DR3;
+            change((initial > maxDr) ? maxDr : initial);
+        }
+
+        /** Data rate of the next uplinks. */
+        LoRaDR_e dataRate() const { return dr; }
+
+        /** Uplink results fed so far: margins (SNRs included) and uplinks without feedback, one per uplink. */
+        uint32_t results() const { return fed; }
+
+        /** Add the margin (in dB) reported by a link check answer. */
+        void addMargin(int16_t marginDb) {
+            margins[head] = (int8_t) ((marginDb > INT8_MAX) ? INT8_MAX : (marginDb < INT8_MIN) ? INT8_MIN : marginDb);
+            head = (uint8_t) ((head + 1) % DR_MARGIN_HISTORY);
+            if (count < DR_MARGIN_HISTORY) {
+                count++;
+            }
+            silent = 0;
+            fed++;
+
+            if ((marginDb < DR_DOWN_MARGIN_DB) && (dr > DR0)) {
+                // Enough steps down to get the installation margin back
+                int16_t steps = (int16_t) ((DR_INSTALLATION_MARGIN_DB - marginDb + DR_STEP_DB - 1) / DR_STEP_DB);
+                change((steps >= dr) ? DR0 : (LoRaDR_e) (dr - steps));
+                return;
+            }
+            if ((count == DR_MARGIN_HISTORY) && (dr < maxDr)) {
+                for (uint8_t i = 0; i < DR_MARGIN_HISTORY; i++) {
+                    if (margins[i] < (DR_INSTALLATION_MARGIN_DB + DR_STEP_DB)) {
+                        return;
+                    }
+                }
+                change((LoRaDR_e) (dr + 1));
+            }
+        }
+
+        /** Add the downlink SNR (in 0.1 dB) received after an uplink at the current data rate. */
+        void addSnr(int16_t snr) {
+            LoRaModulation_t modulation;
+            if (!loraModulation(band, dr, modulation)) {
+                return;
+            }
+            int16_t margin = (int16_t) (snr - loraRequiredSnr(modulation.sf));
+            addMargin((int16_t) ((margin >= 0) ? (margin / 10) : -((9 - margin) / 10)));
+        }
+
+        /** An uplink ended without downlink feedback. */
+        void noFeedback() {
+            fed++;
+            if (silent < UINT8_MAX) {
+                silent++;
+            }
+            if ((silent >= DR_BACKOFF_UPLINKS) && (dr > DR0)) {
+                change((LoRaDR_e) (dr - 1));
+            }
+        }
+
+        /** The next uplink should carry a link check request. */
+        bool wantsLinkCheck() const { return (silent > 0) && ((silent % DR_LINK_CHECK_PERIOD) == 0); }
+};
+
+#endif // __AGROTECHLAB_DATARATE_H__
@@ -18,203 +18,105 @@
 #define __AGROTECHLAB_LORA_H__
 
 #include <Arduino.h>
+#include "AgroTechLab_ATCmd.h"
+#include "AgroTechLab_Airtime.h"
+#include "AgroTechLab_DataRate.h"
+#include "AgroTechLab_ModemParser.h"
+#include "AgroTechLab_LoRaTypes.h"
 
 /**
- * @enum LoRaBand_e
- * @brief LoRa band operation.
- * @var EU868
- * European band operation.
- * @var US915
- * America band operation.
- * @var AU920
- * Australia band operation.
+ * \def LORA_CMD_TIMEOUT
+ * Maximum time (in ms) waiting for the modem to accept a command (the reply usually comes in a few ms).
  */
-enum LoRaBand_e {
-    EU868,
-    US915,
-    AU920
-};
-
-/**
- * @enum LoRaOpClass_e
- * @brief LoRa operation class.
- * @var A
- * LoRa class "A".
- * @var C
- * LoRa class "C".
- */
-enum LoRaOpClass_e {
-    A,
-    C
-};
-
-/**
- * @enum LoRaTxPower_e
- * @brief LoRa transmission power (in dBm).
- * @var A
- * LoRa class "A".
- * @var C
- * LoRa class "C".
- */
-enum LoRaTxPower_e {
-    dBm30,
-    dBm28,
-    dBm26,
-    dBm24,
-    dBm22,
-    dBm20,
-    dBm18,
-    dBm16,
-    dBm14,
-    dBm12,
-    dBm10
-};
-
-/**
- * @enum LoRaDR_e
- * @brief LoRa data rate.
- * @var DR0
- * [EU868/EU434] - LoRa SF12/125KHz.\n
- * [US915/AU920] - LoRa SF10/125KHz.
- * @var DR1
- * [EU868/EU434] - LoRa SF11/125KHz.\n
- * [US915/AU920] - LoRa SF9/125KHz.
- * @var DR2
- * [EU868/EU434] - LoRa SF10/125KHz.\n
- * [US915/AU920] - LoRa SF8/125KHz.
- * @var DR3
- * [EU868/EU434] - LoRa SF9/125KHz.\n
- * [US915/AU920] - LoRa SF7/125KHz.
- * @var DR4
- * [EU868/EU434] - LoRa SF8/125KHz.\n
- * [US915/AU920] - LoRa SF8/500KHz.
- * @var DR5
- * [EU868/EU434] - LoRa SF7/125KHz.\n
- * [US915/AU920] - RFU.
- * @var DR6
- * [EU868/EU434] - LoRa SF7/250KHz.\n
- * [US915/AU920] - RFU.
- * @var DR7
- * [EU868/EU434] - FSK 50Kbps.\n
- * [US915/AU920] - RFU.
- * @var DR8
- * [EU868/EU434] - RFU.\n
- * [US915/AU920] - LoRa SF12/500KHz.
- * @var DR9
- * [EU868/EU434] - RFU.\n
- * [US915/AU920] - LoRa SF11/500KHz.
- * @var DR10
- * [EU868/EU434] - RFU.\n
- * [US915/AU920] - LoRa SF10/500KHz.
- * @var DR11
- * [EU868/EU434] - RFU.\n
- * [US915/AU920] - LoRa SF9/500KHz.
- * @var DR12
- * [EU868/EU434] - RFU.\n
- * [US915/AU920] - LoRa SF8/500KHz.
- * @var DR13
- * [EU868/EU434] - RFU.\n
- * [US915/AU920] - LoRa SF7/500KHz.
- * @var DR14
- * [EU868/EU434] - RFU.\n
- * [US915/AU920] - RFU.
- * @var DR15
- * [EU868/EU434] - RFU.\n
- * [US915/AU920] - RFU.
- */
-enum LoRaDR_e {
-    DR0,
-    DR1,
-    DR2,
-    DR3,
-    DR4,
-    DR5,
-    DR6,
-    DR7,
-    DR8,
-    DR9,
-    DR10,
-    DR11,
-    DR12,
-    DR13,
-    DR14,
-    DR15
-};
+#define LORA_CMD_TIMEOUT                1000UL
 
 /**
- * @enum LoRaBool_e
- * @brief LoRa boolean.
- * @var ON
- * parameter is ON.
- * @var OFF
- * parameter is OFF.
+ * \def LORA_TX_TIMEOUT
+ * Maximum time (in ms) waiting for an unconfirmed transmission to be done.
  */
-enum LoRaBool_e {
-    ON,
-    OFF
-};
+#define LORA_TX_TIMEOUT                 15000UL
 
 /**
- * @enum LoRaAuthMode_e
- * @brief LoRa authentication mode.
- * @var LWABP
- * Authentication by Personalisation.
- * @var LWOTAA
- * Over the Air Authentication.
- * @var LWTEST
- * Test mode.
+ * \def LORA_ACK_TX_TIMEOUT
+ * Maximum time (in ms) waiting for a confirmed transmission (with retries) to be done.
  */
-enum LoRaAuthMode_e {
-    LWABP,
-    LWOTAA,
-    LWTEST
-};
+#define LORA_ACK_TX_TIMEOUT             60000UL
 
 /**
- * @struct LoRaConfig_t
- * @brief LoRa configuration struct.
+ * \def LORA_JOIN_TIMEOUT
+ * Maximum time (in ms) waiting for the OTAA join procedure to be done.
  */
-struct LoRaConfig_t {
-    LoRaBand_e band;            /**< LoRa band. */
-    LoRaOpClass_e op_class;     /**< LoRa operation class. */
-    LoRaTxPower_e tx_power;     /**< LoRa transmission power. */
-    LoRaDR_e uplink_dr;         /**< LoRa uplink datarate. */
-    LoRaBool_e adr;             /**< LoRa ADR (Automatic Data Rate). */
-    LoRaAuthMode_e auth_mode;   /**< LoRa authentication mode. */
-    String dev_eui;             /**< LoRa DevEUI. */
-    String app_eui;             /**< LoRa AppEUI. */
-    String repeat;              /**< LoRa unconfirmed message repeat time. */
-    String retry;               /**< LoRa confirmed message retry times. */
-    String dev_addr;            /**< LoRa device address. */
-    String app_key;             /**< LoRa application key. */
-    String apps_key;            /**< LoRa application session key. */
-    String nwks_key;            /**< LoRa network session key. */
-    String rxwin2_freq;         /**< LoRa receive window 2 frequency. */
-    LoRaDR_e rxwin2_dr;         /**< LoRa receive window 2 datarate. */
-    String chan0_freq;          /**< LoRa channel 0 frequency. */
-    LoRaDR_e chan0_dr;          /**< LoRa channel 0 datarate. */
-    String chan1_freq;          /**< LoRa channel 1 frequency. */
-    LoRaDR_e chan1_dr;          /**< LoRa channel 1 datarate. */
-    bool debug;                 /**< Enable/disable LoRa debug. */
-};
+#define LORA_JOIN_TIMEOUT               30000UL
 
 class LoRa {
     private:
-        String loraReturn = "";
-        bool loraBusy = false;
-        String loraBand_toString(LoRaBand_e loraBand);
-        String loraOpClass_toString(LoRaOpClass_e loraOpClass);
-        String loraTxPower_toString(LoRaTxPower_e loraTxPower);
-        String loraDR_toString(LoRaDR_e loraDR);
-        String loraBool_toString(LoRaBool_e loraBool);
-        String loraAuthMode_toString(LoRaAuthMode_e loraAuthMode);
+        static const uint8_t SETUP_DR = 0x01;       /**< Data rate must be set before the message. */
+        static const uint8_t SETUP_LCR = 0x02;      /**< Link check must be requested before the message. */
+        Stream& modem;
+        Print& debugOut;
+        ModemParser parser;
+        ATCmd pendingCmd;
+        LoRaState_e state = LORA_IDLE;
+        unsigned long stageStart = 0;
+        unsigned long doneTimeout = 0;
+        unsigned long stageLatency[LORA_WAITING_DONE + 1] = {0};
+        unsigned long cmdLatency = 0;
+        bool txFailed = false;
+        bool debug = false;
+        AirtimeBudget budget;
+        uint32_t (*budgetClock)() = NULL;
+        uint32_t lastAirtime = 0;
+        uint8_t setupPending = 0;
+        uint8_t txPort = 0;
+        bool msgWritten = false;
+        LoRaDR_e txDr = DR0;
+        LoRaDR_e modemDr = DR0;
+        bool modemDrKnown = false;
+        bool linkCheckRequested = false;
+        bool rxQuality = false;
+        int16_t rxRssi = 0;
+        int16_t rxSnr = 0;
+        bool linkChecked = false;
+        uint8_t linkMargin = 0;
+        uint8_t linkGateways = 0;
+        uint8_t downlinkPort = 0;
+        uint8_t downlinkLen = 0;
+        const __FlashStringHelper* loraBand_toString(LoRaBand_e loraBand);
+        const __FlashStringHelper* loraOpClass_toString(LoRaOpClass_e loraOpClass);
+        const __FlashStringHelper* loraTxPower_toString(LoRaTxPower_e loraTxPower);
+        const __FlashStringHelper* loraDR_toString(LoRaDR_e loraDR);
+        const __FlashStringHelper* loraBool_toString(LoRaBool_e loraBool);
+        const __FlashStringHelper* loraAuthMode_toString(LoRaAuthMode_e loraAuthMode);
+        bool startTx(const LoRaConfig_t& loraCfg, uint8_t port, bool confirmed, uint8_t len);
+        bool startJoin(const LoRaConfig_t& loraCfg);
+        void enterState(LoRaState_e newState);
+        void writeNextCmd();
+        bool runCmd(const __FlashStringHelper* label, const ATCmd& at_cmd, unsigned long timeout = LORA_CMD_TIMEOUT);
+        void processEvent(const ModemEvent_t& event);
+        void update();
+        uint32_t budgetTime() { return (budgetClock != NULL) ? budgetClock() : millis(); }
 
     public:
-        bool initModem(LoRaConfig_t loraConfig);
-        bool sendNoAckMsg(LoRaConfig_t loraCfg, uint8_t port, String buf);
-        bool sendAckMsg(LoRaConfig_t loraCfg, uint8_t port, String buf);
-        bool sendNoAckMsgHex(LoRaConfig_t loraCfg, uint8_t port, String buf);
-        bool sendAckMsgHex(LoRaConfig_t loraCfg, uint8_t port, String buf);
+        LoRa(Stream& modemSerial, Print& debugOutput);
+        bool initModem(const LoRaConfig_t& loraConfig);
+        bool sendNoAckMsg(const LoRaConfig_t& loraCfg, uint8_t port, const char* buf);
+        bool sendAckMsg(const LoRaConfig_t& loraCfg, uint8_t port, const char* buf);
+        bool sendNoAckMsgHex(const LoRaConfig_t& loraCfg, uint8_t port, const char* buf);
+        bool sendAckMsgHex(const LoRaConfig_t& loraCfg, uint8_t port, const char* buf);
+        bool sendNoAckMsgBin(const LoRaConfig_t& loraCfg, uint8_t port, const uint8_t* data, uint8_t len);
+        bool sendAckMsgBin(const LoRaConfig_t& loraCfg, uint8_t port, const uint8_t* data, uint8_t len);
+        LoRaState_e poll();
+        LoRaState_e getState() const { return state; }
+        bool isBusy() const { return (state == LORA_SENDING) || (state == LORA_WAITING_DONE); }
+        unsigned long getStageLatency(LoRaState_e stage);
+        unsigned long getCmdLatency() const { return cmdLatency; }
+        uint32_t getLastAirtime() const { return lastAirtime; }
+        uint32_t getAirtimeAvailable() { return budget.available(budgetTime()); }
+        void setBudgetClock(uint32_t (*clock)()) { budgetClock = clock; }
+        void requestLinkCheck() { linkCheckRequested = true; }
+        bool getRxQuality(int16_t& rssi, int16_t& snr) const;
+        bool getLinkCheck(uint8_t& margin, uint8_t& gateways) const;
+        bool getDownlink(uint8_t& port, const uint8_t*& data, uint8_t& len) const;
         void callback_RX();
 };
 #endif // __AGROTECHLAB_LORA_H__
\ No newline at end of file
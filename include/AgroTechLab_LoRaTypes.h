@@ -0,0 +1,226 @@
+/**
+ * @file AgroTechLab_LoRaTypes.h
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief AgroTechLab LoRa library types (no Arduino dependency, also used by host tools).
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>). 
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at 
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,  
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or 
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing 
+ * permissions and limitations under the License.
+ */
+#ifndef __AGROTECHLAB_LORATYPES_H__
+#define __AGROTECHLAB_LORATYPES_H__
+
+#include <stdint.h>
+
+/**
+ * @enum LoRaBand_e
+ * @brief LoRa band operation.
+ * @var EU868
+ * European band operation.
+ * @var US915
+ * America band operation.
+ * @var AU920
+ * Australia band operation (the US915-like plan of the RHF0M003 firmware, see \ref LoRaDR_e).
+ */
+enum LoRaBand_e {
+    EU868,
+    US915,
+    AU920
+};
+
+/**
+ * @enum LoRaOpClass_e
+ * @brief LoRa operation class.
+ * @var A
+ * LoRa class "A".
+ * @var C
+ * LoRa class "C".
+ */
+enum LoRaOpClass_e {
+    A,
+    C
+};
+
+/**
+ * @enum LoRaTxPower_e
+ * @brief LoRa transmission power (in dBm).
+ * @var A
+ * LoRa class "A".
+ * @var C
+ * LoRa class "C".
+ */
+enum LoRaTxPower_e {
+    dBm30,
+    dBm28,
+    dBm26,
+    dBm24,
+    dBm22,
+    dBm20,
+    dBm18,
+    dBm16,
+    dBm14,
+    dBm12,
+    dBm10
+};
+
+/**
+ * @enum LoRaDR_e
+ * @brief LoRa data rate. The AU920 data rates are the ones of the RHF0M003 firmware: the US915-like plan of the
+ * LoRaWAN Regional Parameters before 1.0.2. The AU915 plan of the Regional Parameters 1.0.2 and later has other
+ * uplink data rates (DR0 is SF12/125KHz, DR6 is SF8/500KHz), which this firmware does not support.
+ * @var DR0
+ * [EU868/EU434] - LoRa SF12/125KHz.\n
+ * [US915/AU920] - LoRa SF10/125KHz.
+ * @var DR1
+ * [EU868/EU434] - LoRa SF11/125KHz.\n
+ * [US915/AU920] - LoRa SF9/125KHz.
+ * @var DR2
+ * [EU868/EU434] - LoRa SF10/125KHz.\n
+ * [US915/AU920] - LoRa SF8/125KHz.
+ * @var DR3
+ * [EU868/EU434] - LoRa SF9/125KHz.\n
+ * [US915/AU920] - LoRa SF7/125KHz.
+ * @var DR4
+ * [EU868/EU434] - LoRa SF8/125KHz.\n
+ * [US915/AU920] - LoRa SF8/500KHz.
+ * @var DR5
+ * [EU868/EU434] - LoRa SF7/125KHz.\n
+ * [US915/AU920] - RFU.
+ * @var DR6
+ * [EU868/EU434] - LoRa SF7/250KHz.\n
+ * [US915/AU920] - RFU.
+ * @var DR7
+ * [EU868/EU434] - FSK 50Kbps.\n
+ * [US915/AU920] - RFU.
+ * @var DR8
+ * [EU868/EU434] - RFU.\n
+ * [US915/AU920] - LoRa SF12/500KHz.
+ * @var DR9
+ * [EU868/EU434] - RFU.\n
+ * [US915/AU920] - LoRa SF11/500KHz.
+ * @var DR10
+ * [EU868/EU434] - RFU.\n
+ * [US915/AU920] - LoRa SF10/500KHz.
+ * @var DR11
+ * [EU868/EU434] - RFU.\n
+ * [US915/AU920] - LoRa SF9/500KHz.
+ * @var DR12
+ * [EU868/EU434] - RFU.\n
+ * [US915/AU920] - LoRa SF8/500KHz.
+ * @var DR13
+ * [EU868/EU434] - RFU.\n
+ * [US915/AU920] - LoRa SF7/500KHz.
+ * @var DR14
+ * [EU868/EU434] - RFU.\n
+ * [US915/AU920] - RFU.
+ * @var DR15
+ * [EU868/EU434] - RFU.\n
+ * [US915/AU920] - RFU.
+ */
+enum LoRaDR_e {
+    DR0,
+    DR1,
+    DR2,
+    DR3,
+    DR4,
+    DR5,
+    DR6,
+    DR7,
+    DR8,
+    DR9,
+    DR10,
+    DR11,
+    DR12,
+    DR13,
+    DR14,
+    DR15
+};
+
+/**
+ * @enum LoRaBool_e
+ * @brief LoRa boolean.
+ * @var ON
+ * parameter is ON.
+ * @var OFF
+ * parameter is OFF.
+ */
+enum LoRaBool_e {
+    ON,
+    OFF
+};
+
+/**
+ * @enum LoRaAuthMode_e
+ * @brief LoRa authentication mode.
+ * @var LWABP
+ * Authentication by Personalisation.
+ * @var LWOTAA
+ * Over the Air Authentication.
+ * @var LWTEST
+ * Test mode.
+ */
+enum LoRaAuthMode_e {
+    LWABP,
+    LWOTAA,
+    LWTEST
+};
+
+/**
+ * @enum LoRaState_e
+ * @brief LoRa transmission (or join) state. The results (\ref LORA_DONE and \ref LORA_ERROR) are one-shot:
+ * \c LoRa::poll() reports them once and goes back to \ref LORA_IDLE.
+ * @var LORA_IDLE
+ * No transmission started (or its result was already reported).
+ * @var LORA_SENDING
+ * Command written, waiting for the modem to accept it.
+ * @var LORA_WAITING_DONE
+ * Command accepted, waiting for the end of the transmission (TX and RX windows).
+ * @var LORA_DONE
+ * Transmission finished successfully.
+ * @var LORA_ERROR
+ * Transmission failed or timed out.
+ */
+enum LoRaState_e {
+    LORA_IDLE,
+    LORA_SENDING,
+    LORA_WAITING_DONE,
+    LORA_DONE,
+    LORA_ERROR
+};
+
+/**
+ * @struct LoRaConfig_t
+ * @brief LoRa configuration struct.
+ */
+struct LoRaConfig_t {
+    LoRaBand_e band;            /**< LoRa band. */
+    LoRaOpClass_e op_class;     /**< LoRa operation class. */
+    LoRaTxPower_e tx_power;     /**< LoRa transmission power. */
+    LoRaDR_e uplink_dr;         /**< LoRa uplink datarate. */
+    LoRaBool_e adr;             /**< LoRa ADR (Automatic Data Rate). */
+    LoRaAuthMode_e auth_mode;   /**< LoRa authentication mode. */
+    const char* dev_eui;        /**< LoRa DevEUI. */
+    const char* app_eui;        /**< LoRa AppEUI. */
+    const char* repeat;         /**< LoRa unconfirmed message repeat time. */
+    const char* retry;          /**< LoRa confirmed message retry times. */
+    const char* dev_addr;       /**< LoRa device address. */
+    const char* app_key;        /**< LoRa application key. */
+    const char* apps_key;       /**< LoRa application session key. */
+    const char* nwks_key;       /**< LoRa network session key. */
+    const char* rxwin2_freq;    /**< LoRa receive window 2 frequency. */
+    LoRaDR_e rxwin2_dr;         /**< LoRa receive window 2 datarate. */
+    const char* chan0_freq;     /**< LoRa channel 0 frequency. */
+    LoRaDR_e chan0_dr;          /**< LoRa channel 0 datarate. */
+    const char* chan1_freq;     /**< LoRa channel 1 frequency. */
+    LoRaDR_e chan1_dr;          /**< LoRa channel 1 datarate. */
+    bool debug;                 /**< Enable/disable LoRa debug. */
+};
+
+#endif // __AGROTECHLAB_LORATYPES_H__
@@ -0,0 +1,140 @@
+/**
+ * @file AgroTechLab_ModemEmulator.h
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief AgroTechLab RHF0M003 modem emulator for host builds.
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#ifndef __AGROTECHLAB_MODEMEMULATOR_H__
+#define __AGROTECHLAB_MODEMEMULATOR_H__
+
+#include <stdint.h>
+#include "AgroTechLab_LoRaTypes.h"
+
+/**
+ * \def MODEM_EMU_LINE_SIZE
+ * Longest command or reply line of the emulator (in bytes, including the string terminator).
+ */
+#define MODEM_EMU_LINE_SIZE             128
+
+/**
+ * \def MODEM_EMU_QUEUE_SIZE
+ * Reply lines waiting to be sent by the emulator.
+ */
+#define MODEM_EMU_QUEUE_SIZE            16
+
+/**
+ * \def MODEM_EMU_CMD_SIZE
+ * Longest command name of a fault (in bytes, including the string terminator, ex.: \c CMSGHEX).
+ */
+#define MODEM_EMU_CMD_SIZE              10
+
+/**
+ * @enum ModemFault_e
+ * @brief Fault injected into the reply of a command (see \ref ModemEmulator::inject()).
+ */
+enum ModemFault_e {
+    MODEM_FAULT_NONE,       /**< Normal reply. */
+    MODEM_FAULT_ERROR,      /**< <tt>+CMD: ERROR(code)</tt>. */
+    MODEM_FAULT_SILENT,     /**< No reply at all. */
+    MODEM_FAULT_BUSY,       /**< <tt>+CMD: LoRaWAN modem is busy</tt>. */
+    MODEM_FAULT_NO_CHANNEL  /**< Messages: <tt>+CMD: No free channel</tt> and <tt>+CMD: Done</tt>. */
+};
+
+/**
+ * @struct ModemEmulatorSettings_t
+ * @brief Timing and radio conditions of \ref ModemEmulator (times in ms).
+ */
+typedef struct {
+    unsigned long replyLatency;     /**< From the end of a command to its first reply line. */
+    unsigned long baud;             /**< Serial baudrate of the replies (0: lines are sent at once). */
+    unsigned long joinDelay;        /**< From <tt>+JOIN: Start</tt> to the join result. */
+    unsigned long rxWindows;        /**< From the end of an uplink to <tt>Done</tt> (receive windows). */
+    int16_t rssi;                   /**< RSSI of the downlinks (in dBm). */
+    int16_t snr;                    /**< SNR of the downlinks (in 0.1 dB). */
+    uint8_t linkMargin;             /**< Link check margin (in dB). */
+    uint8_t gateways;               /**< Link check gateway count. */
+} ModemEmulatorSettings_t;
+
+/**
+ * Settings of a modem close to a gateway, at 9600 baud.
+ */
+constexpr ModemEmulatorSettings_t MODEM_EMU_DEFAULT = { 5, 9600, 6000, 2000, -70, 85, 20, 1 };
+
+/**
+ * @class ModemEmulator
+ * @brief Scripted RHF0M003 for host builds. It answers the AT commands used by \ref LoRa (configuration, join,
+ * data rate, port, link check and the four message commands) with the modem reply lines, released at the times
+ * of \ref ModemEmulatorSettings_t: the reply latency, the join delay, the uplink time on air (see
+ * \ref loraWanAirtimeMs()) plus the receive windows, and the serial byte time. Downlinks and faults are queued by
+ * the test script. Time is given by the caller (ex.: \c millis() of the host), so runs are repeatable.
+ * Bytes are written with \ref write() and read with \ref available() / \ref read(); an Arduino \c Stream
+ * adapter of a host build only has to forward these calls, with the current time.
+ */
+class ModemEmulator {
+    private:
+        typedef struct {
+            unsigned long due;                  /**< Time of the first byte. */
+            char text[MODEM_EMU_LINE_SIZE];     /**< Line with terminator. */
+        } Line_t;
+
+        ModemEmulatorSettings_t settings;
+        Line_t queue[MODEM_EMU_QUEUE_SIZE];
+        uint8_t head = 0;
+        uint8_t count = 0;
+        uint8_t sent = 0;                       /**< Bytes of the head line already read. */
+        unsigned long lastEnd = 0;              /**< Time the last queued line is over. */
+        char line[MODEM_EMU_LINE_SIZE];
+        uint8_t lineLen = 0;
+        LoRaBand_e band = EU868;
+        LoRaDR_e dr = DR0;
+        bool otaa = false;
+        bool joined = false;
+        bool linkCheck = false;
+        uint8_t joinFailures = 0;
+        char faultCmd[MODEM_EMU_CMD_SIZE] = "";
+        ModemFault_e fault = MODEM_FAULT_NONE;
+        int16_t faultCode = 0;
+        uint8_t downlinkPort = 0;
+        uint8_t downlinkLen = 0;
+        uint8_t downlink[32];
+
+        void command(unsigned long now);
+        void message(const char* name, const char* arg, unsigned long now);
+        void reply(unsigned long due, const char* format, ...);
+        unsigned long byteTime(uint8_t bytes) const;
+        uint8_t arrived(const Line_t& entry, unsigned long now) const;
+
+    public:
+        uint32_t commands = 0;      /**< Commands received. */
+        uint32_t uplinks = 0;       /**< Messages sent over the air. */
+        uint32_t joins = 0;         /**< Join procedures started. */
+        uint32_t airtime = 0;       /**< Total uplink time on air (in ms). */
+        uint32_t rejected = 0;      /**< Messages longer than the data rate allows (not sent). */
+        uint32_t overflows = 0;     /**< Reply lines dropped (queue full). */
+
+        explicit ModemEmulator(const ModemEmulatorSettings_t& emulatorSettings = MODEM_EMU_DEFAULT);
+        void reset();
+        void write(uint8_t c, unsigned long now);
+        int available(unsigned long now) const;
+        int peek(unsigned long now) const;
+        int read(unsigned long now);
+        unsigned long nextDue() const;
+        void queueDownlink(uint8_t port, const uint8_t* data, uint8_t len);
+        void failJoins(uint8_t attempts) { joinFailures = attempts; }
+        void inject(const char* name, ModemFault_e kind, int16_t code = -1);
+        bool isJoined() const { return joined; }
+        LoRaBand_e loraBand() const { return band; }
+        LoRaDR_e dataRate() const { return dr; }
+};
+
+#endif // __AGROTECHLAB_MODEMEMULATOR_H__
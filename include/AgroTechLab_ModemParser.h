@@ -0,0 +1,165 @@
+/**
+ * @file AgroTechLab_ModemParser.h
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief AgroTechLab streaming parser of the RHF0M003 modem replies.
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#ifndef __AGROTECHLAB_MODEMPARSER_H__
+#define __AGROTECHLAB_MODEMPARSER_H__
+
+#include <stdint.h>
+
+/**
+ * \def MODEM_TAG_SIZE
+ * Longest reply tag kept by the parser (in bytes, including the string terminator, ex.: <tt>+CMSGHEX</tt>).
+ */
+#define MODEM_TAG_SIZE                  10
+
+/**
+ * \def MODEM_WORD_SIZE
+ * Longest word kept by the parser (in bytes, including the string terminator). Longer words are truncated.
+ */
+#define MODEM_WORD_SIZE                 10
+
+/**
+ * \def MODEM_DOWNLINK_SIZE
+ * Largest downlink payload kept by the parser (in bytes). Longer payloads are truncated.
+ */
+#define MODEM_DOWNLINK_SIZE             32
+
+/**
+ * @enum ModemTag_e
+ * @brief Command a reply line belongs to (the <tt>+TAG:</tt> prefix of the line).
+ */
+enum ModemTag_e {
+    MODEM_TAG_NONE,         /**< Line without tag. */
+    MODEM_TAG_AT,           /**< <tt>+AT:</tt> */
+    MODEM_TAG_MSG,          /**< <tt>+MSG:</tt> and <tt>+MSGHEX:</tt> */
+    MODEM_TAG_CMSG,         /**< <tt>+CMSG:</tt> and <tt>+CMSGHEX:</tt> */
+    MODEM_TAG_JOIN,         /**< <tt>+JOIN:</tt> */
+    MODEM_TAG_PORT,         /**< <tt>+PORT:</tt> */
+    MODEM_TAG_DR,           /**< <tt>+DR:</tt> */
+    MODEM_TAG_LW,           /**< <tt>+LW:</tt> */
+    MODEM_TAG_OTHER         /**< Any other tag. */
+};
+
+/**
+ * @enum ModemEventType_e
+ * @brief Meaning of a reply line.
+ */
+enum ModemEventType_e {
+    MODEM_EVENT_LINE,       /**< Other line (ex.: a setting echo). */
+    MODEM_EVENT_OK,         /**< <tt>OK</tt> */
+    MODEM_EVENT_ERROR,      /**< <tt>ERROR(n)</tt> (see \ref ModemEvent_t::error) or a rejected message. */
+    MODEM_EVENT_START,      /**< Transmission started. */
+    MODEM_EVENT_DONE,       /**< Command finished. */
+    MODEM_EVENT_FAILED,     /**< Transmission or join failed (ex.: <tt>No free channel</tt>, <tt>Join failed</tt>). */
+    MODEM_EVENT_JOINED,     /**< <tt>Network joined</tt> or <tt>Joined already</tt>. */
+    MODEM_EVENT_RX_QUALITY, /**< Downlink received: <tt>RXWIN1, RSSI -106, SNR 4.5</tt>. */
+    MODEM_EVENT_LINK_CHECK, /**< Link check answer: <tt>Link 20, 1</tt>. */
+    MODEM_EVENT_DOWNLINK    /**< Downlink payload: <tt>PORT: 1; RX: "0102"</tt>. */
+};
+
+/**
+ * @struct ModemEvent_t
+ * @brief Reply line decoded by \ref ModemParser. Only the fields of the event type are meaningful.
+ */
+typedef struct {
+    ModemEventType_e type;  /**< Event type. */
+    ModemTag_e tag;         /**< Command of the line. */
+    int16_t error;          /**< Modem error code. */
+    int16_t rssi;           /**< Downlink RSSI (in dBm). */
+    int16_t snr;            /**< Downlink SNR (in 0.1 dB). */
+    uint8_t margin;         /**< Link check margin (in dB). */
+    uint8_t gateways;       /**< Link check gateway count. */
+    uint8_t port;           /**< Downlink port. */
+    uint8_t len;            /**< Downlink payload size (in bytes, up to \ref MODEM_DOWNLINK_SIZE). */
+    const uint8_t* data;    /**< Downlink payload (valid until the next downlink). */
+} ModemEvent_t;
+
+/**
+ * @fn    parseTenths
+ * @brief Parse a signed decimal number with up to one decimal digit (ex.: <tt>-12.5</tt>) after optional spaces.
+ * Numbers out of the \c int16_t range (in tenths) saturate.
+ * @param[in] text - text to parse.
+ * @param[out] value - number (in tenths).
+ * @return bool - \c true if a number was found.
+ */
+inline bool parseTenths(const char* text, int16_t& value) {
+    bool negative = false;
+    bool digits = false;
+    int32_t number = 0;
+    while (*text == ' ') {
+        text++;
+    }
+    if (*text == '-') {
+        negative = true;
+        text++;
+    }
+    while ((*text >= '0') && (*text <= '9')) {
+        if (number <= INT16_MAX) {
+            number = (number * 10) + (*text - '0');
+        }
+        text++;
+        digits = true;
+    }
+    number *= 10;
+    if ((*text == '.') && (text[1] >= '0') && (text[1] <= '9')) {
+        number += text[1] - '0';
+    }
+    if (number > INT16_MAX) {
+        number = INT16_MAX;
+    }
+    value = (int16_t) (negative ? -number : number);
+    return digits;
+}
+
+/**
+ * @class ModemParser
+ * @brief Incremental tokenizer of the modem replies. Bytes are fed as they arrive and only the current tag and
+ * word are kept (numbers are converted and downlink hexadecimal is decoded on the fly), so no reply line is
+ * buffered. \ref feed() returns \c true at the end of every non-empty line, with its decoded \ref event().
+ * It has no Arduino dependency, so captured transcripts can be replayed on the host.
+ */
+class ModemParser {
+    private:
+        enum Expect_e { EXPECT_NONE, EXPECT_ERROR, EXPECT_RSSI, EXPECT_SNR, EXPECT_MARGIN, EXPECT_GATEWAYS, EXPECT_PORT };
+        enum Stage_e { STAGE_START, STAGE_TAG, STAGE_BODY, STAGE_HEX };
+
+        char tag[MODEM_TAG_SIZE];
+        char word[MODEM_WORD_SIZE];
+        uint8_t tagLen = 0;
+        uint8_t wordLen = 0;
+        uint8_t lineLen = 0;
+        uint16_t nibbles = 0;
+        bool lineDone = false;
+        Stage_e stage = STAGE_START;
+        Expect_e expect = EXPECT_NONE;
+        bool downlinkNext = false;
+        uint8_t downlink[MODEM_DOWNLINK_SIZE];
+        ModemEvent_t current;
+
+        void startLine();
+        void endTag();
+        void endWord();
+        void setType(ModemEventType_e type);
+        void hexDigit(char c);
+
+    public:
+        ModemParser();
+        bool feed(char c);
+        const ModemEvent_t& event() const { return current; }
+        bool isTag(const char* name, uint8_t len) const;
+};
+
+#endif // __AGROTECHLAB_MODEMPARSER_H__
@@ -0,0 +1,120 @@
+/**
+ * @file AgroTechLab_Uart.h
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief AgroTechLab interrupt-driven hardware UART transport of the LoRa modem.
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#ifndef __AGROTECHLAB_UART_H__
+#define __AGROTECHLAB_UART_H__
+
+#include <stdint.h>
+
+/**
+ * \def UART_RX_BUFFER_SIZE
+ * Receive ring buffer size (in bytes, power of two). At 9600 baud it holds about 130 ms of modem replies, longer
+ * than the slowest task.
+ */
+#define UART_RX_BUFFER_SIZE             128
+
+/**
+ * \def UART_TX_BUFFER_SIZE
+ * Transmit ring buffer size (in bytes, power of two). Longer commands block only for the bytes that do not fit.
+ */
+#define UART_TX_BUFFER_SIZE             64
+
+/**
+ * @class RingBuffer
+ * @brief Single producer, single consumer byte queue shared between an interrupt and the main loop. \c SIZE must be
+ * a power of two up to 128: the indexes are free-running bytes, so one side only writes \c head and the other only
+ * writes \c tail, and no critical section is needed on an 8-bit MCU. It does not touch the hardware, so it also runs
+ * on the host.
+ */
+template <uint8_t SIZE>
+class RingBuffer {
+    static_assert((SIZE > 0) && (SIZE <= 128) && ((SIZE & (SIZE - 1)) == 0), "Ring size must be a power of two up to 128");
+
+    private:
+        uint8_t data[SIZE];
+        volatile uint8_t head = 0;      /**< Next position written (producer). */
+        volatile uint8_t tail = 0;      /**< Next position read (consumer). */
+
+    public:
+        /** Bytes waiting. */
+        uint8_t count() const { return (uint8_t) (head - tail); }
+
+        bool empty() const { return head == tail; }
+
+        bool full() const { return count() >= SIZE; }
+
+        /** Free room (in bytes). */
+        uint8_t room() const { return (uint8_t) (SIZE - count()); }
+
+        /**
+         * Append a byte (producer side).
+         * @return bool - \c false if the buffer is full (the byte is dropped).
+         */
+        bool push(uint8_t value) {
+            if (full()) {
+                return false;
+            }
+            data[head & (SIZE - 1)] = value;
+            head = (uint8_t) (head + 1);
+            return true;
+        }
+
+        /** Oldest byte, or -1 if empty (consumer side). */
+        int peek() const {
+            return empty() ? -1 : data[tail & (SIZE - 1)];
+        }
+
+        /** Remove and return the oldest byte, or -1 if empty (consumer side). */
+        int pop() {
+            if (empty()) {
+                return -1;
+            }
+            uint8_t value = data[tail & (SIZE - 1)];
+            tail = (uint8_t) (tail + 1);
+            return value;
+        }
+
+        /** Discard every byte (consumer side). */
+        void clear() { tail = head; }
+};
+
+#if defined(__AVR__)
+#include <Arduino.h>
+
+/**
+ * @class AvrUart
+ * @brief ATmega328p USART0 (pins 0 and 1) behind interrupt-fed ring buffers: the receive interrupt stores every byte
+ * as it arrives, whatever the main loop is doing, and the data register empty interrupt drains the transmit buffer.
+ * It is an Arduino \c Stream, so \ref LoRa does not know which port it talks to. The core \c Serial object must not
+ * be used in the same program (it owns the same interrupt vectors).
+ */
+class AvrUart : public Stream {
+    public:
+        void begin(unsigned long baud);
+        void end();
+        int available() override;
+        int peek() override;
+        int read() override;
+        int availableForWrite() override;
+        void flush() override;
+        size_t write(uint8_t value) override;
+        using Print::write;
+        uint16_t getOverruns();
+        explicit operator bool() { return true; }
+};
+#endif
+
+#endif // __AGROTECHLAB_UART_H__
@@ -17,11 +17,14 @@
 #ifndef __ATS_01_H__
 #define __ATS_01_H__
 
-#include <DHT_U.h>
-#include <Adafruit_Sensor.h>
-#include <BH1750.h>
-#include <SoftwareSerial.h>
-#include "AgroTechLab_LoRa.h"
+#include "ats_01_station.h"
+#include "ats_01_data.h"
+#include "ats_01_history.h"
+#include "ats_01_payload.h"
+#include "ats_01_report.h"
+#include "ats_01_batch.h"
+#include "ats_01_tasks.h"
+#include "ats_01_uv.h"
 
 /**
  * \def DEV_TYPE 
@@ -55,9 +58,11 @@
 
 /**
  * \def SERIAL_DEBUG 
- * Enable/disable derial debug.
+ * Enable/disable derial debug (the native build turns it off, see \c platformio.ini).
  */
+#ifndef SERIAL_DEBUG
 #define SERIAL_DEBUG                    true
+#endif
 
 /**
  * \def LED_BUILTIN_ENABLED 
@@ -87,89 +92,211 @@
 
 /**
  * \def LORA_RX_PIN 
- * Define the LoRa module RX pin.
+ * LoRa module RX pin: the MCU hardware USART RX (see \ref AvrUart). The modem must be disconnected while the
+ * firmware is uploaded by the serial bootloader.
  */
-#define LORA_RX_PIN                   6
+#define LORA_RX_PIN                   0
 
 /**
  * \def LORA_TX_PIN 
- * Define the LoRa module TX pin.
+ * LoRa module TX pin: the MCU hardware USART TX.
+ */
+#define LORA_TX_PIN                   1
+
+/**
+ * \def LORA_BAUDRATE 
+ * Define the LoRa module serial baudrate.
  */
-#define LORA_TX_PIN                   7
+#define LORA_BAUDRATE                 9600
 
 /**
- * \def DHT_TYPE 
- * DHT sensor type.
+ * \def LORA_SENSORS_PORT 
+ * LoRa port used to send sensor data.
  */
-#define DHT_TYPE                        DHT22
+#define LORA_SENSORS_PORT             1
 
 /**
- * \def DHT_PIN 
- * DHT22 sensor device pin.
+ * \def LORA_BACKLOG_PORT 
+ * LoRa port used to send readings stored into the log.
  */
-#define DHT_PIN                         9
+#define LORA_BACKLOG_PORT             2
 
 /**
- * \def UVM30A_PIN 
- * UVM30A sensor pin.
+ * \def LORA_DEVICE_DR 
+ * Choose the uplink data rate on the device from the downlink link margin (see \ref DataRateController). The
+ * network ADR must be off.
  */
-#define UVM30A_PIN                      A0
+#define LORA_DEVICE_DR                true
 
+/*********************************************
+ *              SENSOR SCHEDULE
+ ********************************************/
 /**
- * \def VOLTAGE_SENSOR_PIN 
- * Voltage sensor pin.
+ * \def AIR_CLIMATE_PERIOD 
+ * Air temperature and humidity sampling period (in ms).
  */
-#define VOLTAGE_SENSOR_PIN              A1
+#define AIR_CLIMATE_PERIOD              60000UL
 
+/**
+ * \def LIGHT_PERIOD 
+ * Light sampling period (in ms).
+ */
+#define LIGHT_PERIOD                    60000UL
+
+/**
+ * \def UV_PERIOD 
+ * UV index sampling period (in ms).
+ */
+#define UV_PERIOD                       60000UL
+
+/**
+ * \def BATTERY_PERIOD 
+ * Battery voltage sampling period (in ms).
+ */
+#define BATTERY_PERIOD                  900000UL
+
+/**
+ * \def BATTERY_PHASE 
+ * Battery voltage sampling offset (in ms). Half a sampling period away from the uplinks, so the voltage is not
+ * measured while the radio is loading the battery.
+ */
+#define BATTERY_PHASE                   30000UL
+
+/**
+ * \def UPLINK_PERIOD 
+ * Sensor data uplink period (in ms).
+ */
+#define UPLINK_PERIOD                   60000UL
+
+/**
+ * \def HISTORY_SIZE 
+ * Number of recent readings kept in RAM (one per \ref AIR_CLIMATE_PERIOD).
+ */
+#define HISTORY_SIZE                    8
 
 /*********************************************
- *               DATA STRUCTS
+ *             REPORT ON CHANGE
  ********************************************/
 /**
- * \def STATION_SENSORS_T 
- * Struct with sensor data.
+ * Send a reading only when it changed significantly or after a heartbeat interval (see \ref ReportPolicy).
+ * Otherwise every \ref UPLINK_PERIOD.
+ */
+constexpr bool REPORT_ON_CHANGE = true;
+
+/**
+ * Report deadbands: 0.3 oC, 2 % RH, 10 % of light (at least 5 lux), any UV index change and 100 mV of battery,
+ * with a report at least every hour.
  */
-struct STATION_SENSORS_T {
-    float air_temperature = 0.0f;
-    float air_humidity = 0.0f;    
-    uint16_t light = 0;    
-    uint8_t uv_index = 0;
-    float battery_voltage = 0.0f;    
+constexpr ReportDeadband_t reportDeadband = {
+    { 30, 20, 5, 1, 100 },
+    { 0, 0, 10, 0, 0 },
+    3600000UL
 };
 
+/*********************************************
+ *              PAYLOAD FORMAT
+ ********************************************/
+/**
+ * Uplink payload format (see \ref PayloadFormat_e). Pick the smallest format accepted by the network server
+ * integration; only the selected encoder is compiled into the firmware.
+ */
+constexpr PayloadFormat_e PAYLOAD_FORMAT = PAYLOAD_PACKED;
+
+/**
+ * Send the mean of the readings since the last uplink (see \ref ReadingHistory) instead of the latest reading.
+ * Useful when \ref UPLINK_PERIOD is longer than the sampling periods.
+ */
+constexpr bool UPLINK_PERIOD_MEAN = false;
+
 /*********************************************
  *            FUNCTION PROTOTYPES
  ********************************************/
 #if (SERIAL_DEBUG == true)
     void printInitInfo();
 #endif
-float getAirTemperatureInC();
-float getAirHumidity();
-uint16_t getLightInLux();
-uint8_t getUVIndex();
-float getBatteryVoltage();
+uint32_t stationTime();
+bool readLightRaw(uint16_t& raw);
+bool getLightInLux(uint16_t& lux);
+uint8_t getUVIndex(uint16_t adcValue);
+uint16_t getBatteryVoltage(uint16_t adcValue);
+void handleUplinkResult(LoRaState_e state);
+void updateDataRate();
+void sendBacklog();
+void logEncoderReadings();
+void startAirClimate();
+void readAirClimate();
+void startLight();
+void readLight();
+void readUV();
+void readBattery();
+void recordReading();
+void sendReading();
 
 /*********************************************
  *             SYSTEM VARIABLES
  ********************************************/
+bool configError = false;                               /**< Configuration error found by setup(): no task runs. */
 STATION_SENSORS_T sensorsData;                          /**< Global variable with sensor values. */
-DHT_Unified dht(DHT_PIN, DHT_TYPE);                     /**< Global variable to access DHT sensor (DHT22). */
-BH1750 lightSensor;                                     /**< Global variable to access light sensor (GY30). */
-sensor_t dht_sensor;                                    /**< Global variable to access DHT sensor internal values. */
-sensors_event_t dht_sensor_event;                       /**< Global variable to access DHT sensor internal events. */
-LoRa lora;                                              /**< Global variable to access LoRaWAN module. */
-LoRaConfig_t loraCfg;                                   /**< Global variable with LoRa configurations. */
-SoftwareSerial loraSerial(LORA_RX_PIN, LORA_TX_PIN);    /**< Software Serial for LoRa module communication. */
+ReadingHistory<HISTORY_SIZE> history;                   /**< Global variable with recent readings and statistics. */
+ReportPolicy reportPolicy(reportDeadband);              /**< Global variable to decide which readings are sent. */
+PayloadEncoder<PAYLOAD_FORMAT> payloadEncoder;          /**< Global variable to encode uplink payload. */
+uint8_t payload[PayloadEncoder<PAYLOAD_FORMAT>::MAX_SIZE];  /**< Global variable with uplink payload. */
+bool readingInFlight = false;                           /**< Uplink in progress carries a payload of \ref payloadEncoder. */
+StationPins pins;                                       /**< Global variable to access digital pins. */
+StationEeprom stationEeprom;                            /**< Global variable to access EEPROM. */
+RecordLog<StationEeprom> recordLog(stationEeprom);      /**< Global variable with readings not sent yet. */
+uint16_t backlogSeq = 0;                                /**< Sequence number of the first log reading in progress. */
+uint8_t backlogInFlight = 0;                            /**< Log readings of the uplink in progress. */
+DhtDecoder dhtDecoder;                                  /**< Global variable with the DHT frame being captured. */
+StationDht dht(DHT_PIN, dhtDecoder);                    /**< Global variable to access DHT sensor (DHT22). */
+unsigned long dhtStart = 0;                             /**< Start of the DHT transaction in progress (in us). */
+SENSOR_STATS_T dhtStats;                                /**< Global variable with DHT sensor read statistics. */
+StationLight light(LIGHT_SENSOR_ADDR);                  /**< Global variable to access light sensor (GY30). */
+LightRanger lightRanger;                                /**< Global variable with the light sensor range. */
+ModemSerial loraSerial;                                 /**< Hardware serial (USART) for LoRa module communication. */
 #if (SERIAL_DEBUG == true)
-    SoftwareSerial debugSerial(SERIAL_RX_PIN, SERIAL_TX_PIN);   /**< Software Serial for DEBUG. */
+    DebugSerial debugSerial(SERIAL_RX_PIN, SERIAL_TX_PIN);  /**< Software Serial for DEBUG. */
+    LoRa lora(loraSerial, debugSerial);                 /**< Global variable to access LoRaWAN module. */
+#else
+    NullOutput debugSink;                               /**< Debug output of the drivers (dropped). */
+    LoRa lora(loraSerial, debugSink);                   /**< Global variable to access LoRaWAN module (no debug output). */
 #endif
+LoRaConfig_t loraCfg;                                   /**< Global variable with LoRa configurations. */
+DataRateController rateController;                      /**< Global variable to choose the uplink data rate. */
+StationAdc adc;                                         /**< Global variable to access the ADC (oversampled reads). */
+StationSleep sleepPlatform;                             /**< Global variable to access MCU sleep modes. */
+SleepScheduler<StationSleep> scheduler(sleepPlatform);  /**< Global variable with the logical clock and sleep control. */
 
 /*********************************************
  *             SYSTEM CONSTANTS
  ********************************************/
-const float voltageSensor_R1 = 6800.0;     /**< Voltage sensor resistor 1. */
-const float voltageSensor_R2 = 4700.0;     /**< Voltage sensor resistor 2. */
-const uint16_t uvIndexValue [12] = { 50, 227, 318, 408, 503, 606, 696, 795, 881, 976, 1079, 1170};
+/**
+ * Battery voltage (in mV) of one ADC step as a Q16 factor: the ADC scale and the voltage divider
+ * <tt>(R1 + R2) / R2</tt> folded at compile time, so a read costs one integer multiply.
+ */
+constexpr uint32_t batteryMvPerStepQ16 = (uint32_t) (((((uint64_t) adcVref_mV * (voltageSensor_R1 + voltageSensor_R2)) << 16) +
+    ((uint64_t) voltageSensor_R2 << (ADC_BITS + ADC_OVERSAMPLING_BITS - 1))) /
+    ((uint64_t) voltageSensor_R2 << (ADC_BITS + ADC_OVERSAMPLING_BITS)));
+static_assert(((uint64_t) batteryMvPerStepQ16 << (ADC_BITS + ADC_OVERSAMPLING_BITS)) < (1ULL << 32),
+    "battery voltage conversion overflows 32 bits");
+static_assert(((batteryMvPerStepQ16 * ((1UL << (ADC_BITS + ADC_OVERSAMPLING_BITS)) - 1)) >> 16) <
+    (1UL << RECORD_FIELD_WIDTH[SENSOR_BATTERY_VOLTAGE]), "battery voltage full scale does not fit the record field");
+/**
+ * Station task table: sensors are read with their own period and the uplink runs after the readings due at the
+ * same time (tasks due together run in table order). The light conversion and the DHT frame run in background
+ * while the other sensors are read, the slowest one (light, ~120 ms) is collected last.
+ */
+constexpr PeriodicTask_t stationTasks[] PROGMEM = {
+    { startLight,       LIGHT_PERIOD,       0 },
+    { startAirClimate,  AIR_CLIMATE_PERIOD, 0 },
+    { readUV,           UV_PERIOD,          0 },
+    { readBattery,      BATTERY_PERIOD,     BATTERY_PHASE },
+    { readAirClimate,   AIR_CLIMATE_PERIOD, 0 },
+    { readLight,        LIGHT_PERIOD,       0 },
+    { recordReading,    AIR_CLIMATE_PERIOD, 0 },
+    { sendReading,      UPLINK_PERIOD,      0 }
+};
+TaskDispatcher<sizeof(stationTasks) / sizeof(stationTasks[0])> dispatcher(stationTasks);  /**< Station task dispatcher. */
 // const unsigned long system_period = 1000;   /**< System run period (in ms). */
 // const unsigned long sampling_period = 2 * 60 * system_period;   /**< Sampling period (in ms). */
 // const unsigned long error_reset_period = 60 * system_period;   /**< Error reset period (in ms). */
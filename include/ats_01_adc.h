@@ -0,0 +1,137 @@
+/**
+ * @file ats_01_adc.h
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief AgroTechStation 01 oversampled analog reads.
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#ifndef __ATS_01_ADC_H__
+#define __ATS_01_ADC_H__
+
+#include <stdint.h>
+
+/**
+ * \def ADC_BITS
+ * ADC resolution (in bits).
+ */
+#define ADC_BITS                        10
+
+/**
+ * \def ADC_OVERSAMPLING_BITS
+ * Extra bits of an oversampled read: \c 4^n conversions are added and the sum is shifted right by \c n bits
+ * (reads have <tt>ADC_BITS + n</tt> bits).
+ */
+#define ADC_OVERSAMPLING_BITS           2
+
+/**
+ * \def ADC_MAX_CHANNELS
+ * Maximum number of channels of one sequence.
+ */
+#define ADC_MAX_CHANNELS                2
+
+/**
+ * \def ADC_CONVERSION_US
+ * Duration of one conversion (13 ADC clocks at 125 kHz, in us).
+ */
+#define ADC_CONVERSION_US               104
+
+/**
+ * \def ADC_WAIT_STOPS_IO_CLOCK
+ * \ref AvrAdc waits for the conversions in a sleep mode that stops the I/O clock (ADC noise reduction). It is
+ * \c false: the sequences run between the DHT22 start and its frame and while the modem may answer, so the edge
+ * capture (INT0), timer 0 (\c millis()) and the USART receiver must keep running (idle sleep).
+ */
+#define ADC_WAIT_STOPS_IO_CLOCK         false
+
+/**
+ * @class AdcSequence
+ * @brief Oversampling sequence over up to \ref ADC_MAX_CHANNELS channels. The channels are converted one after the
+ * other, each one \c 4^n times, and the first conversion after a channel switch is dropped (input settling).
+ * \ref add() is fed from the ADC interrupt; it does not touch the hardware, so it also runs on the host.
+ */
+class AdcSequence {
+    public:
+        static const uint16_t SAMPLES = 1U << (2 * ADC_OVERSAMPLING_BITS);
+
+    private:
+        uint8_t channels[ADC_MAX_CHANNELS];
+        volatile uint32_t sums[ADC_MAX_CHANNELS];
+        uint8_t count = 0;
+        volatile uint8_t current = 0;
+        volatile uint16_t samples = 0;
+        volatile bool settling = true;
+
+    public:
+        /** Start a sequence over \p n channels (MCU channel numbers). */
+        void begin(const uint8_t* list, uint8_t n) {
+            count = (n > ADC_MAX_CHANNELS) ? ADC_MAX_CHANNELS : n;
+            for (uint8_t i = 0; i < count; i++) {
+                channels[i] = list[i];
+                sums[i] = 0;
+            }
+            current = 0;
+            samples = 0;
+            settling = true;
+        }
+
+        /** Channel of the next conversion. */
+        uint8_t channel() const { return channels[current]; }
+
+        /** All conversions were done. */
+        bool done() const { return current >= count; }
+
+        /**
+         * Add a conversion result of \ref channel().
+         * @return bool - \c true if the channel changed (the multiplexer must be switched before the next conversion).
+         */
+        bool add(uint16_t sample) {
+            if (done()) {
+                return false;
+            }
+            if (settling) {
+                settling = false;
+                return false;
+            }
+            sums[current] += sample;
+            if (++samples < SAMPLES) {
+                return false;
+            }
+            samples = 0;
+            settling = true;
+            current++;
+            return true;
+        }
+
+        /** Number of conversions of a sequence over \p n channels (settling conversions included). */
+        static uint16_t conversions(uint8_t n) {
+            return (uint16_t) (((n > ADC_MAX_CHANNELS) ? ADC_MAX_CHANNELS : n) * (SAMPLES + 1));
+        }
+
+        /** Decimated read (<tt>ADC_BITS + ADC_OVERSAMPLING_BITS</tt> bits) of the channel \p i of the sequence. */
+        uint16_t result(uint8_t i) const {
+            return (uint16_t) ((sums[i] + ((1UL << ADC_OVERSAMPLING_BITS) >> 1)) >> ADC_OVERSAMPLING_BITS);
+        }
+};
+
+#if defined(__AVR__)
+/**
+ * @class AvrAdc
+ * @brief ATmega328p oversampled reads: the ADC interrupt chains the conversions of an \ref AdcSequence while the
+ * MCU waits in idle sleep (about 2 ms per channel, see \ref ADC_WAIT_STOPS_IO_CLOCK).
+ */
+class AvrAdc {
+    public:
+        void read(const uint8_t* pins, uint8_t n, uint16_t* results);
+};
+#endif
+
+#endif // __ATS_01_ADC_H__
@@ -0,0 +1,114 @@
+/**
+ * @file ats_01_batch.h
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief AgroTechStation 01 batched uplink payload (delta and run-length compression of consecutive readings).
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>). 
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at 
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,  
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or 
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing 
+ * permissions and limitations under the License.
+ */
+#ifndef __ATS_01_BATCH_H__
+#define __ATS_01_BATCH_H__
+
+#include <stdint.h>
+#include "ats_01_payload.h"
+
+/**
+ * \def BATCH_MAX_SAMPLES 
+ * Maximum number of readings sent into one batched uplink.
+ */
+#define BATCH_MAX_SAMPLES               6
+
+/**
+ * \def BATCH_MAX_PAYLOAD 
+ * Maximum batched payload size (in bytes). A batch is sent earlier when the next reading would not fit (or when
+ * the uplink of the data rate is smaller).
+ */
+#define BATCH_MAX_PAYLOAD               51
+
+/**
+ * \def BATCH_ZERO_RUN 
+ * Token of a run of unchanged values. It is followed by a varint with the run length minus one.
+ */
+#define BATCH_ZERO_RUN                  0
+
+uint8_t encodeBatch(const uint8_t frames[][PAYLOAD_SIZE], uint8_t count, uint8_t* buf, uint8_t size);
+uint8_t decodeBatch(const uint8_t* buf, uint8_t len, STATION_SENSORS_T* samples, uint8_t maxSamples);
+
+/**
+ * @brief Batch encoder. Readings are accumulated and \c encode() returns 0 until \ref BATCH_MAX_SAMPLES readings
+ * are reached or the next reading would not fit the uplink (\p size, the largest payload of the data rate, up to
+ * \ref BATCH_MAX_PAYLOAD bytes). The frame layout is:
+ * - 1 byte: number of readings;
+ * - \ref PAYLOAD_SIZE bytes: first reading (packed frame);
+ * - for each field, the zigzag varint deltas between consecutive readings, where runs of unchanged values are
+ *   replaced by \ref BATCH_ZERO_RUN plus the run length.
+ *
+ * The readings of a returned payload are held until \c delivered() or \c release(), so none is lost when the
+ * uplink is deferred or fails.
+ */
+template <>
+class PayloadEncoder<PAYLOAD_BATCH> {
+    private:
+        uint8_t frames[BATCH_MAX_SAMPLES][PAYLOAD_SIZE];
+        uint8_t count = 0;      /**< Readings held. */
+        uint8_t sent = 0;       /**< Readings of the last payload returned (the oldest ones held). */
+
+    public:
+        static const uint8_t MAX_SIZE = BATCH_MAX_PAYLOAD;
+        static const uint8_t MIN_UPLINK = 1 + PAYLOAD_SIZE;
+        static const uint8_t MAX_READINGS = BATCH_MAX_SAMPLES;
+
+        /** Add \p data to the batch (only after the last payload was delivered or released). */
+        uint8_t encode(const STATION_SENSORS_T& data, uint8_t* buf, uint8_t size = MAX_SIZE) {
+            if (size > MAX_SIZE) {
+                size = MAX_SIZE;
+            }
+            encodePayload(data, frames[count]);
+            count++;
+
+            // Last reading does not fit: send the previous ones and keep it for the next batch
+            uint8_t len = encodeBatch(frames, count, buf, size);
+            if (len == 0) {
+                sent = (uint8_t) (count - 1);
+                return encodeBatch(frames, sent, buf, size);
+            }
+
+            // Batch full, or a second reading never fits (it adds at least a run of zeros per field)
+            if ((count == BATCH_MAX_SAMPLES) || ((count == 1) && ((len + (2 * PAYLOAD_FIELDS)) > size))) {
+                sent = count;
+                return len;
+            }
+            return 0;
+        }
+
+        void delivered() {
+            count = (uint8_t) (count - sent);
+            memmove(frames[0], frames[sent], count * PAYLOAD_SIZE);
+            sent = 0;
+        }
+
+        uint8_t release(STATION_SENSORS_T* readings) {
+            uint8_t n = count;
+            for (uint8_t i = 0; i < n; i++) {
+                memcpy(readings[i].bytes, frames[i], PAYLOAD_SIZE);
+            }
+            reset();
+            return n;
+        }
+
+        /** Discard the readings not sent yet. */
+        void reset() {
+            count = 0;
+            sent = 0;
+        }
+};
+
+#endif // __ATS_01_BATCH_H__
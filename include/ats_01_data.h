@@ -0,0 +1,186 @@
+/**
+ * @file ats_01_data.h
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief AgroTechStation 01 data structs.
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>). 
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at 
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,  
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or 
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing 
+ * permissions and limitations under the License.
+ */
+#ifndef __ATS_01_DATA_H__
+#define __ATS_01_DATA_H__
+
+#include <stdint.h>
+
+/**
+ * @enum SensorField_e
+ * @brief Fields of a station record, in their order into the record (also the bit of their validity flag).
+ */
+enum SensorField_e {
+    SENSOR_AIR_TEMPERATURE,
+    SENSOR_AIR_HUMIDITY,
+    SENSOR_LIGHT,
+    SENSOR_UV_INDEX,
+    SENSOR_BATTERY_VOLTAGE,
+    SENSOR_FIELDS
+};
+
+/**
+ * \def STATION_RECORD_SIZE 
+ * Packed station record size (in bytes).
+ */
+#define STATION_RECORD_SIZE             8
+
+/**
+ * First bit of each field into the packed record (see \ref STATION_SENSORS_T), indexed by \ref SensorField_e. Bits
+ * <tt>0 .. SENSOR_FIELDS-1</tt> hold the validity flags.
+ */
+constexpr uint8_t RECORD_FIELD_OFFSET[SENSOR_FIELDS] = { 5, 19, 29, 45, 49 };
+
+/**
+ * Width (in bits) of each field into the packed record, indexed by \ref SensorField_e.
+ */
+constexpr uint8_t RECORD_FIELD_WIDTH[SENSOR_FIELDS] = { 14, 10, 16, 4, 14 };
+
+/**
+ * Fields stored in two's complement (bitmask of \ref SensorField_e).
+ */
+constexpr uint8_t RECORD_SIGNED_FIELDS = (1 << SENSOR_AIR_TEMPERATURE);
+
+static_assert(RECORD_FIELD_OFFSET[0] == SENSOR_FIELDS, "record: fields must follow the validity flags");
+static_assert(RECORD_FIELD_OFFSET[1] == (RECORD_FIELD_OFFSET[0] + RECORD_FIELD_WIDTH[0]), "record: fields overlap");
+static_assert(RECORD_FIELD_OFFSET[2] == (RECORD_FIELD_OFFSET[1] + RECORD_FIELD_WIDTH[1]), "record: fields overlap");
+static_assert(RECORD_FIELD_OFFSET[3] == (RECORD_FIELD_OFFSET[2] + RECORD_FIELD_WIDTH[2]), "record: fields overlap");
+static_assert(RECORD_FIELD_OFFSET[4] == (RECORD_FIELD_OFFSET[3] + RECORD_FIELD_WIDTH[3]), "record: fields overlap");
+static_assert((RECORD_FIELD_OFFSET[SENSOR_FIELDS - 1] + RECORD_FIELD_WIDTH[SENSOR_FIELDS - 1]) <= (8 * STATION_RECORD_SIZE),
+              "record: fields must fit into STATION_RECORD_SIZE bytes");
+
+/**
+ * @fn    recordGetBits
+ * @brief Read \p width bits (up to 16) starting at bit \p offset of a little-endian bit string.
+ */
+inline uint16_t recordGetBits(const uint8_t* bytes, uint8_t offset, uint8_t width) {
+    uint8_t i = offset / 8;
+    uint8_t shift = offset % 8;
+    uint32_t window = 0;
+    for (uint8_t n = 0; (n * 8) < (shift + width); n++) {
+        window |= (uint32_t) bytes[i + n] << (8 * n);
+    }
+    return (uint16_t) ((window >> shift) & ((1UL << width) - 1));
+}
+
+/**
+ * @fn    recordSetBits
+ * @brief Write the \p width lower bits (up to 16) of \p value starting at bit \p offset of a little-endian bit string.
+ */
+inline void recordSetBits(uint8_t* bytes, uint8_t offset, uint8_t width, uint16_t value) {
+    uint8_t i = offset / 8;
+    uint8_t shift = offset % 8;
+    uint32_t mask = ((1UL << width) - 1) << shift;
+    uint32_t bits = ((uint32_t) value << shift) & mask;
+    for (uint8_t n = 0; (n * 8) < (shift + width); n++) {
+        bytes[i + n] = (uint8_t) ((bytes[i + n] & ~(mask >> (8 * n))) | (bits >> (8 * n)));
+    }
+}
+
+/*********************************************
+ *               DATA STRUCTS
+ ********************************************/
+/**
+ * \def STATION_SENSORS_T 
+ * Packed station record (fixed-point, no float math on the MCU). The same bytes are kept in RAM, stored into the
+ * EEPROM log and sent as the packed uplink frame, with no conversion in between.\n
+ * Layout (little-endian bit string, bit 0 is the least significant bit of byte 0):
+ * Bits | Field | Unit | Range
+ * :----:|:----:|:----:|:----:
+ * 0-4 | validity flags (bit \ref SensorField_e) | - | -
+ * 5-18 | air temperature (int14) | 0.01 °C | -81.92 .. 81.91
+ * 19-28 | air humidity (uint10) | 0.1 % | 0 .. 102.3
+ * 29-44 | light (uint16) | 1 lux | 0 .. 65535
+ * 45-48 | UV index (uint4) | 1 | 0 .. 15
+ * 49-62 | battery voltage (uint14) | 1 mV | 0 .. 16383
+ * 63 | spare (0) | - | -
+ *
+ * An invalid field has its flag cleared and its bits set to 0, so equal readings always have equal bytes.
+ */
+struct STATION_SENSORS_T {
+    uint8_t bytes[STATION_RECORD_SIZE] = {0};   /**< Packed record (all fields invalid). */
+
+    /** The field \p field holds a reading. */
+    bool isValid(SensorField_e field) const { return (bytes[0] & (1 << field)) != 0; }
+
+    /** Mark the field \p field as not read. */
+    void invalidate(SensorField_e field) {
+        bytes[0] &= (uint8_t) ~(1 << field);
+        recordSetBits(bytes, RECORD_FIELD_OFFSET[field], RECORD_FIELD_WIDTH[field], 0);
+    }
+
+    /** Raw bits of the field \p field (two's complement for the signed ones). */
+    uint16_t get(SensorField_e field) const {
+        return recordGetBits(bytes, RECORD_FIELD_OFFSET[field], RECORD_FIELD_WIDTH[field]);
+    }
+
+    /**
+     * Store a reading of the field \p field.
+     * @return bool - \c false if \p value does not fit the field (the field is invalidated).
+     */
+    bool set(SensorField_e field, int32_t value) {
+        int32_t min = (RECORD_SIGNED_FIELDS & (1 << field)) ? -(1L << (RECORD_FIELD_WIDTH[field] - 1)) : 0;
+        int32_t max = (RECORD_SIGNED_FIELDS & (1 << field)) ? ((1L << (RECORD_FIELD_WIDTH[field] - 1)) - 1)
+                                                             : ((1L << RECORD_FIELD_WIDTH[field]) - 1);
+        if ((value < min) || (value > max)) {
+            invalidate(field);
+            return false;
+        }
+        bytes[0] |= (uint8_t) (1 << field);
+        recordSetBits(bytes, RECORD_FIELD_OFFSET[field], RECORD_FIELD_WIDTH[field], (uint16_t) value);
+        return true;
+    }
+
+    /** Value of the field \p field (signed fields are sign extended). */
+    int32_t value(SensorField_e field) const {
+        int32_t raw = get(field);
+        if (RECORD_SIGNED_FIELDS & (1 << field)) {
+            int32_t sign = 1L << (RECORD_FIELD_WIDTH[field] - 1);
+            raw = (raw ^ sign) - sign;
+        }
+        return raw;
+    }
+
+    /** Air temperature (in 0.01 oC). */
+    int16_t airTemperature() const { return (int16_t) value(SENSOR_AIR_TEMPERATURE); }
+
+    /** Air humidity (in 0.1 %). */
+    uint16_t airHumidity() const { return get(SENSOR_AIR_HUMIDITY); }
+
+    /** Light (in lux). */
+    uint16_t light() const { return get(SENSOR_LIGHT); }
+
+    /** UV index. */
+    uint8_t uvIndex() const { return (uint8_t) get(SENSOR_UV_INDEX); }
+
+    /** Battery voltage (in mV). */
+    uint16_t batteryVoltage() const { return get(SENSOR_BATTERY_VOLTAGE); }
+};
+
+static_assert(sizeof(STATION_SENSORS_T) == STATION_RECORD_SIZE, "STATION_SENSORS_T must be the packed record only");
+
+/**
+ * \def SENSOR_STATS_T 
+ * Struct with sensor read statistics.
+ */
+struct SENSOR_STATS_T {
+    uint16_t reads = 0;             /**< Read attempts. */
+    uint16_t failures = 0;          /**< Failed or out of range reads. */
+    uint16_t last_latency_us = 0;   /**< Duration of the last read (in us). */
+    uint16_t max_latency_us = 0;    /**< Longest read (in us). */
+};
+
+#endif // __ATS_01_DATA_H__
@@ -0,0 +1,155 @@
+/**
+ * @file ats_01_dht.h
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief AgroTechStation 01 interrupt-driven DHT22 reader.
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#ifndef __ATS_01_DHT_H__
+#define __ATS_01_DHT_H__
+
+#include <stdint.h>
+
+/**
+ * \def DHT_FRAME_BYTES
+ * DHT22 frame size (in bytes): humidity (2), temperature (2) and checksum (1).
+ */
+#define DHT_FRAME_BYTES                 5
+
+/**
+ * \def DHT_PULSES
+ * High pulses of a DHT22 transaction: the response pulse (~80 us) followed by one pulse per data bit.
+ */
+#define DHT_PULSES                      (1 + (DHT_FRAME_BYTES * 8))
+
+/**
+ * \def DHT_START_US
+ * Length of the start signal (in us), the data sheet asks for at least 1 ms.
+ */
+#define DHT_START_US                    1100
+
+/**
+ * \def DHT_RESPONSE_MIN_US
+ * Shortest accepted response pulse (in us). Shorter high pulses before it (the line released by the MCU) are
+ * ignored.
+ */
+#define DHT_RESPONSE_MIN_US             60
+
+/**
+ * \def DHT_BIT_THRESHOLD_US
+ * High pulse length (in us) between a 0 bit (~26 us) and a 1 bit (~70 us).
+ */
+#define DHT_BIT_THRESHOLD_US            48
+
+/**
+ * \def DHT_FRAME_TIMEOUT_MS
+ * Maximum time (in ms) from the start signal to the last bit (a frame lasts about 5 ms).
+ */
+#define DHT_FRAME_TIMEOUT_MS            10
+
+/**
+ * @class DhtDecoder
+ * @brief DHT22 frame decoder. \ref edge() is fed from the pin interrupt with the level and timestamp of every
+ * edge and only stores the high pulse lengths; the bits are decoded afterwards by \ref decode(), with interrupts
+ * enabled. It does not touch the hardware, so recorded edge traces can be replayed on the host.
+ */
+class DhtDecoder {
+    private:
+        volatile uint8_t widths[DHT_PULSES];    /**< High pulse lengths (in us, saturated at 255). */
+        volatile uint8_t count = 0;
+        volatile uint16_t riseUs = 0;
+        volatile bool high = false;
+
+    public:
+        /** Discard the captured pulses (call before the start signal). */
+        void reset() {
+            count = 0;
+            high = false;
+        }
+
+        /** Record an edge: \p level is the line level after the edge and \p nowUs its time (in us). */
+        void edge(bool level, uint16_t nowUs) {
+            if (level) {
+                riseUs = nowUs;
+                high = true;
+                return;
+            }
+            if (!high || (count >= DHT_PULSES)) {
+                return;
+            }
+            high = false;
+            uint16_t width = (uint16_t) (nowUs - riseUs);
+            if ((count == 0) && (width < DHT_RESPONSE_MIN_US)) {
+                return;
+            }
+            widths[count++] = (width > UINT8_MAX) ? UINT8_MAX : (uint8_t) width;
+        }
+
+        /** All pulses of the frame were captured. */
+        bool complete() const { return count >= DHT_PULSES; }
+
+        /** Number of pulses captured so far. */
+        uint8_t pulses() const { return count; }
+
+        /**
+         * Decode the captured frame.
+         * @param[out] data - humidity, temperature and checksum bytes.
+         * @return bool - \c true if the frame is complete and its checksum matches.
+         */
+        bool decode(uint8_t data[DHT_FRAME_BYTES]) const {
+            if (!complete()) {
+                return false;
+            }
+            for (uint8_t i = 0; i < (DHT_FRAME_BYTES * 8); i++) {
+                data[i / 8] = (uint8_t) ((data[i / 8] << 1) | ((widths[1 + i] > DHT_BIT_THRESHOLD_US) ? 1 : 0));
+            }
+            return (uint8_t) (data[0] + data[1] + data[2] + data[3]) == data[4];
+        }
+};
+
+/**
+ * @fn    dhtHumidity
+ * @brief Air humidity (in 0.1 %) of a DHT22 frame.
+ */
+inline uint16_t dhtHumidity(const uint8_t data[DHT_FRAME_BYTES]) {
+    return ((uint16_t) data[0] << 8) | data[1];
+}
+
+/**
+ * @fn    dhtTemperature
+ * @brief Air temperature (in 0.1 oC) of a DHT22 frame (sign and magnitude).
+ */
+inline int16_t dhtTemperature(const uint8_t data[DHT_FRAME_BYTES]) {
+    int16_t temperature = (int16_t) (((uint16_t) (data[2] & 0x7F) << 8) | data[3]);
+    return (data[2] & 0x80) ? -temperature : temperature;
+}
+
+#if defined(__AVR__)
+/**
+ * @class AvrDht
+ * @brief DHT22 edge capture with an external interrupt pin (INT0/INT1: the pin change vectors belong to
+ * SoftwareSerial). Interrupts stay enabled during the whole transaction.
+ */
+class AvrDht {
+    private:
+        uint8_t pin;
+        DhtDecoder& decoder;
+
+    public:
+        AvrDht(uint8_t dataPin, DhtDecoder& dhtDecoder) : pin(dataPin), decoder(dhtDecoder) { }
+        void begin();
+        void start();
+        void stop();
+};
+#endif
+
+#endif // __ATS_01_DHT_H__
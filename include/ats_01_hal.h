@@ -0,0 +1,346 @@
+/**
+ * @file ats_01_hal.h
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief AgroTechStation 01 hardware abstraction: device policies of the MCU and of the native (host) build.
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ *
+ * The station code only uses the policy types below, chosen at compile time (no virtual calls on the MCU):
+ * | Policy          | Device                      | MCU                 | Native                    |
+ * | :----:          | :----:                      | :----:              | :----:                    |
+ * | StationPins     | digital pins (LED)          | \ref AvrPins        | \ref SimulatedPins        |
+ * | StationAdc      | analog inputs               | \ref AvrAdc         | \ref SimulatedAdc         |
+ * | StationDht      | DHT22 edge capture          | \ref AvrDht         | \ref SimulatedDht         |
+ * | StationLight    | BH1750 on I2C               | \ref AvrLight       | \ref SimulatedLight       |
+ * | StationEeprom   | reading log storage         | \ref AvrEeprom      | \ref EmulatedEeprom       |
+ * | StationSleep    | time and sleep modes        | \ref AvrSleep       | \ref SimulatedSleep       |
+ * | ModemSerial     | LoRa modem serial port      | \ref AvrUart        | \ref EmulatedModemSerial  |
+ * | DebugSerial     | debug serial port           | \c SoftwareSerial   | \ref HostSerial           |
+ *
+ * The native build has no Arduino core: \c lib/NativeArduino provides the API subset used by the firmware, and
+ * its \c millis() / \c micros() are defined in \c ats_01.cpp from the simulated sleep clock.
+ */
+#ifndef __ATS_01_HAL_H__
+#define __ATS_01_HAL_H__
+
+#include <Arduino.h>
+#include "AgroTechLab_Uart.h"
+#include "ats_01_adc.h"
+#include "ats_01_dht.h"
+#include "ats_01_light.h"
+#include "ats_01_log.h"
+#include "ats_01_sleep.h"
+
+/**
+ * @class NullOutput
+ * @brief Output that drops every byte: the debug output of the drivers when the debug serial port is off (they
+ * must never write into the modem port).
+ */
+class NullOutput : public Print {
+    public:
+        size_t write(uint8_t value) override { (void) value; return 1; }
+        size_t write(const uint8_t* buffer, size_t size) override { (void) buffer; return size; }
+        using Print::write;
+};
+
+#if defined(__AVR__)
+#include <Wire.h>
+#include <SoftwareSerial.h>
+
+/**
+ * @class AvrPins
+ * @brief ATmega328p digital outputs.
+ */
+class AvrPins {
+    public:
+        void output(uint8_t pin) { pinMode(pin, OUTPUT); }
+        void write(uint8_t pin, bool level) { digitalWrite(pin, level ? HIGH : LOW); }
+};
+
+/**
+ * @class AvrLight
+ * @brief BH1750 one-time conversions over the I2C bus (Wire), driven with the opcodes of the datasheet (no
+ * driver library: nothing here may write to the hardware serial port, wired to the modem). The measurement time
+ * register is only written when it changes.
+ */
+class AvrLight {
+    private:
+        uint8_t address;
+        uint8_t mtreg = LIGHT_MTREG_DEFAULT;    /**< Measurement time register set into the sensor. */
+        unsigned long startMs = 0;              /**< Start of the conversion in progress (\c millis()). */
+
+        /**
+         * Send the one byte command \p opcode.
+         * @return bool - \c false on I2C error.
+         */
+        bool command(uint8_t opcode) {
+            Wire.beginTransmission(address);
+            Wire.write(opcode);
+            return (Wire.endTransmission() == 0);
+        }
+
+        /**
+         * Write \p value into the measurement time register.
+         * @return bool - \c false on I2C error.
+         */
+        bool writeMTreg(uint8_t value) {
+            bool ok = command(BH1750_MTREG_HIGH | (value >> 5));
+            return command(BH1750_MTREG_LOW | (value & 0x1F)) && ok;
+        }
+
+    public:
+        explicit AvrLight(uint8_t i2cAddress) : address(i2cAddress) { }
+
+        /**
+         * Start the I2C bus, power the sensor on and set the default MTreg (the sensor may have kept another one
+         * through an MCU reset).
+         * @return bool - \c false on I2C error.
+         */
+        bool begin() {
+            Wire.begin();
+            return command(BH1750_POWER_ON) && writeMTreg(LIGHT_MTREG_DEFAULT);
+        }
+
+        /**
+         * Start a one-time conversion with \p mtregValue in high resolution mode (2 if \p highRes2).
+         * @return bool - \c false on I2C error or if the sensor kept its previous MTreg (see \ref getMTreg()).
+         */
+        bool start(uint8_t mtregValue, bool highRes2) {
+            bool ok = true;
+            if (mtregValue != mtreg) {
+                if ((mtregValue >= LIGHT_MTREG_MIN) && (mtregValue <= LIGHT_MTREG_MAX) && writeMTreg(mtregValue)) {
+                    mtreg = mtregValue;
+                } else {
+                    ok = false;
+                }
+            }
+            startMs = millis();
+            return command(highRes2 ? BH1750_ONE_TIME_HIGH_RES_2 : BH1750_ONE_TIME_HIGH_RES) && ok;
+        }
+
+        /** Measurement time register of the conversion in progress. */
+        uint8_t getMTreg() const { return mtreg; }
+
+        /** The conversion is over (longest conversion time of the MTreg). */
+        bool ready() {
+            return ((millis() - startMs) >= ((LIGHT_CONVERSION_MAX_MS * mtreg) / LIGHT_MTREG_DEFAULT));
+        }
+
+        /**
+         * Read the raw count of the last conversion.
+         * @return bool - \c false on I2C error.
+         */
+        bool read(uint16_t& raw) {
+            if (Wire.requestFrom(address, (uint8_t) 2) != 2) {
+                return false;
+            }
+            raw = (uint16_t) Wire.read() << 8;
+            raw |= (uint16_t) Wire.read();
+            return true;
+        }
+};
+
+typedef AvrPins StationPins;
+typedef AvrAdc StationAdc;
+typedef AvrDht StationDht;
+typedef AvrLight StationLight;
+typedef AvrEeprom StationEeprom;
+typedef AvrSleep StationSleep;
+typedef AvrUart ModemSerial;
+typedef SoftwareSerial DebugSerial;
+
+#else
+#include <stdio.h>
+#include "AgroTechLab_ModemEmulator.h"
+
+/**
+ * \def NATIVE_EEPROM_SIZE
+ * EEPROM size of the native build (in bytes, as the ATmega328p).
+ */
+#define NATIVE_EEPROM_SIZE              1024
+
+/**
+ * @class SimulatedPins
+ * @brief Digital outputs of the native build: levels are kept and changes are counted.
+ */
+class SimulatedPins {
+    public:
+        bool levels[A0] = {false};      /**< Output levels of the digital pins. */
+        uint32_t changes = 0;           /**< Level changes of all pins. */
+
+        void output(uint8_t pin) { (void) pin; }
+        void write(uint8_t pin, bool level) {
+            if ((pin < A0) && (levels[pin] != level)) {
+                levels[pin] = level;
+                changes++;
+            }
+        }
+};
+
+/**
+ * @class SimulatedAdc
+ * @brief Analog inputs of the native build. The input codes are set by the simulation and go through the same
+ * \ref AdcSequence as \ref AvrAdc (settling conversion dropped, oversampling). The time the I/O clock is stopped
+ * by the sequences is counted (see \ref ADC_WAIT_STOPS_IO_CLOCK).
+ */
+class SimulatedAdc {
+    public:
+        uint16_t codes[8] = {0};        /**< Input of the analog pins A0 .. A7 (in ADC steps). */
+        uint32_t conversions = 0;       /**< Conversions done. */
+        uint32_t ioStoppedUs = 0;       /**< Total time the I/O clock was stopped by the sequences (in us). */
+
+        void read(const uint8_t* pins, uint8_t n, uint16_t* results) {
+            uint8_t channels[ADC_MAX_CHANNELS];
+            if (n > ADC_MAX_CHANNELS) {
+                n = ADC_MAX_CHANNELS;
+            }
+            for (uint8_t i = 0; i < n; i++) {
+                channels[i] = (uint8_t) ((pins[i] - A0) & 0x07);
+            }
+            AdcSequence sequence;
+            sequence.begin(channels, n);
+            while (!sequence.done()) {
+                sequence.add(codes[sequence.channel()]);
+                conversions++;
+            }
+            if (ADC_WAIT_STOPS_IO_CLOCK == true) {
+                ioStoppedUs += (uint32_t) AdcSequence::conversions(n) * ADC_CONVERSION_US;
+            }
+            for (uint8_t i = 0; i < n; i++) {
+                results[i] = sequence.result(i);
+            }
+        }
+};
+
+/**
+ * @class SimulatedDht
+ * @brief DHT22 of the native build. \ref start() feeds the edges of a whole frame (with the data sheet pulse
+ * lengths) into the \ref DhtDecoder, so the decoder runs as on the MCU. Every \c failEvery frame has a bad checksum.
+ */
+class SimulatedDht {
+    private:
+        DhtDecoder& decoder;
+        uint16_t t = 0;
+
+        /** Feed a low pulse of \p lowUs followed by a high pulse of \p highUs. */
+        void pulse(uint16_t lowUs, uint16_t highUs) {
+            t = (uint16_t) (t + lowUs);
+            decoder.edge(true, t);
+            t = (uint16_t) (t + highUs);
+            decoder.edge(false, t);
+        }
+
+    public:
+        int16_t temperature = 250;      /**< Air temperature (in 0.1 oC). */
+        uint16_t humidity = 600;        /**< Air humidity (in 0.1 %). */
+        uint32_t failEvery = 0;         /**< Period of the corrupted frames (0: none). */
+        uint32_t frames = 0;            /**< Frames sent. */
+
+        SimulatedDht(uint8_t dataPin, DhtDecoder& dhtDecoder) : decoder(dhtDecoder) { (void) dataPin; }
+        void begin() { }
+        void start() {
+            uint16_t magnitude = (uint16_t) ((temperature < 0) ? -temperature : temperature);
+            uint8_t data[DHT_FRAME_BYTES];
+            data[0] = (uint8_t) (humidity >> 8);
+            data[1] = (uint8_t) humidity;
+            data[2] = (uint8_t) ((magnitude >> 8) | ((temperature < 0) ? 0x80 : 0));
+            data[3] = (uint8_t) magnitude;
+            data[4] = (uint8_t) (data[0] + data[1] + data[2] + data[3]);
+            frames++;
+            if ((failEvery > 0) && ((frames % failEvery) == 0)) {
+                data[4] ^= 0x01;
+            }
+
+            decoder.reset();
+            t = 0;
+            pulse(0, 30);       // line released by the MCU
+            pulse(80, 80);      // response
+            for (uint8_t i = 0; i < (DHT_FRAME_BYTES * 8); i++) {
+                pulse(50, (data[i / 8] & (0x80 >> (i % 8))) ? 70 : 26);
+            }
+        }
+        void stop() { }
+};
+
+/**
+ * @class SimulatedLight
+ * @brief BH1750 of the native build (see \ref SimulatedBH1750): conversions are ready at once.
+ */
+class SimulatedLight {
+    private:
+        bool highRes2 = false;
+
+    public:
+        SimulatedBH1750 sensor;         /**< Sensor model (light set by the simulation). */
+
+        explicit SimulatedLight(uint8_t i2cAddress) { (void) i2cAddress; }
+        bool begin() { return true; }
+        bool start(uint8_t mtregValue, bool highRes2Mode) {
+            highRes2 = highRes2Mode;
+            return sensor.setMTreg(mtregValue);
+        }
+        uint8_t getMTreg() const { return sensor.mtreg; }
+        bool ready() { return true; }
+        bool read(uint16_t& raw) {
+            raw = sensor.convert(highRes2);
+            return true;
+        }
+};
+
+/**
+ * @class EmulatedModemSerial
+ * @brief Serial port of the native build connected to a \ref ModemEmulator, timed by \c millis().
+ */
+class EmulatedModemSerial : public Stream {
+    public:
+        ModemEmulator modem;            /**< Emulated modem (faults and downlinks are queued by the simulation). */
+
+        void begin(unsigned long baud) { (void) baud; }
+        int available() override { return modem.available(millis()); }
+        int peek() override { return modem.peek(millis()); }
+        int read() override { return modem.read(millis()); }
+        size_t write(uint8_t value) override {
+            modem.write(value, millis());
+            return 1;
+        }
+        using Print::write;
+        explicit operator bool() { return true; }
+};
+
+/**
+ * @class HostSerial
+ * @brief Debug serial port of the native build, written to the standard output.
+ */
+class HostSerial : public Stream {
+    public:
+        HostSerial(uint8_t rxPin, uint8_t txPin) { (void) rxPin; (void) txPin; }
+        void begin(unsigned long baud) { (void) baud; }
+        int available() override { return 0; }
+        int peek() override { return -1; }
+        int read() override { return -1; }
+        size_t write(uint8_t value) override { return (fputc(value, stdout) == EOF) ? 0 : 1; }
+        using Print::write;
+        void flush() override { fflush(stdout); }
+        explicit operator bool() { return true; }
+};
+
+typedef SimulatedPins StationPins;
+typedef SimulatedAdc StationAdc;
+typedef SimulatedDht StationDht;
+typedef SimulatedLight StationLight;
+typedef EmulatedEeprom<NATIVE_EEPROM_SIZE> StationEeprom;
+typedef SimulatedSleep StationSleep;
+typedef EmulatedModemSerial ModemSerial;
+typedef HostSerial DebugSerial;
+#endif
+
+#endif // __ATS_01_HAL_H__
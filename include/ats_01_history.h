@@ -0,0 +1,159 @@
+/**
+ * @file ats_01_history.h
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief AgroTechStation 01 history of recent readings and running statistics.
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#ifndef __ATS_01_HISTORY_H__
+#define __ATS_01_HISTORY_H__
+
+#include <stdint.h>
+#include "ats_01_data.h"
+
+/**
+ * @class RunningStats
+ * @brief Integer accumulator: count, minimum, maximum, mean and variance of a field, updated in constant time per
+ * sample. The samples are summed as deviations from the first one (shifted data), so the sums are exact: slow
+ * drifts over a long period are not lost to the truncation of an incremental mean, and the update needs no
+ * division (the mean and the variance are only computed when read).
+ */
+class RunningStats {
+    private:
+        uint16_t n = 0;
+        int32_t minValue = 0;
+        int32_t maxValue = 0;
+        int32_t shift = 0;          /**< First sample of the period. */
+        int64_t sum = 0;            /**< Sum of the deviations from \ref shift. */
+        uint64_t squares = 0;       /**< Sum of the squared deviations from \ref shift. */
+
+    public:
+        /** Discard the samples. */
+        void reset() {
+            n = 0;
+            sum = 0;
+            squares = 0;
+        }
+
+        /** Add a sample (up to 16 bits significant, so the sums of \c UINT16_MAX samples fit 64 bits). */
+        void add(int32_t value) {
+            if (n == UINT16_MAX) {
+                return;
+            }
+            if (n++ == 0) {
+                minValue = value;
+                maxValue = value;
+                shift = value;
+                return;
+            }
+            if (value < minValue) {
+                minValue = value;
+            } else if (value > maxValue) {
+                maxValue = value;
+            }
+            int32_t deviation = value - shift;
+            sum += deviation;
+            squares += (uint64_t) ((int64_t) deviation * deviation);
+        }
+
+        /** Number of samples. */
+        uint16_t count() const { return n; }
+
+        /** Smallest sample (0 without samples). */
+        int32_t min() const { return (n > 0) ? minValue : 0; }
+
+        /** Largest sample (0 without samples). */
+        int32_t max() const { return (n > 0) ? maxValue : 0; }
+
+        /** Mean, rounded to the field unit (halves up). */
+        int32_t mean() const {
+            if (n == 0) {
+                return 0;
+            }
+            int64_t rounded = sum + (n / 2);
+            return shift + (int32_t) ((rounded < 0) ? -((n - 1 - rounded) / n) : (rounded / n));
+        }
+
+        /** Sample variance (in field units squared, rounded; 0 with less than 2 samples). */
+        uint32_t variance() const {
+            if (n < 2) {
+                return 0;
+            }
+            uint64_t magnitude = (uint64_t) ((sum < 0) ? -sum : sum);
+            uint64_t correction = ((magnitude * magnitude) + (n / 2)) / n;
+            uint64_t spread = (squares > correction) ? (squares - correction) : 0;
+            uint64_t variance = (spread + ((n - 1) / 2)) / (n - 1);
+            return (variance > UINT32_MAX) ? UINT32_MAX : (uint32_t) variance;
+        }
+};
+
+/**
+ * @class ReadingHistory
+ * @brief Ring of the last \c N packed readings plus the running statistics of every field since the last
+ * \ref restartPeriod() (ex.: the last uplink). Invalid fields are kept in the ring but not counted in the
+ * statistics.
+ * @tparam N - number of readings kept.
+ */
+template <uint8_t N>
+class ReadingHistory {
+    private:
+        STATION_SENSORS_T ring[N];
+        uint8_t head = 0;
+        uint8_t count = 0;
+        RunningStats period[SENSOR_FIELDS];
+
+    public:
+        /** Store a reading, overwriting the oldest one when the ring is full. */
+        void push(const STATION_SENSORS_T& reading) {
+            ring[head] = reading;
+            head = (uint8_t) ((head + 1) % N);
+            if (count < N) {
+                count++;
+            }
+            for (uint8_t i = 0; i < SENSOR_FIELDS; i++) {
+                if (reading.isValid((SensorField_e) i)) {
+                    period[i].add(reading.value((SensorField_e) i));
+                }
+            }
+        }
+
+        /** Number of readings kept. */
+        uint8_t size() const { return count; }
+
+        /** Reading \p age pushes ago (0 is the latest one, up to \ref size() - 1). */
+        const STATION_SENSORS_T& at(uint8_t age) const {
+            return ring[(uint8_t) ((head + N - 1 - age) % N)];
+        }
+
+        /** Statistics of the field \p field since the last \ref restartPeriod(). */
+        const RunningStats& stats(SensorField_e field) const { return period[field]; }
+
+        /** Start a new aggregation period (the ring is kept). */
+        void restartPeriod() {
+            for (uint8_t i = 0; i < SENSOR_FIELDS; i++) {
+                period[i].reset();
+            }
+        }
+
+        /** Record with the mean of every field of the period (fields without samples are invalid). */
+        STATION_SENSORS_T mean() const {
+            STATION_SENSORS_T record;
+            for (uint8_t i = 0; i < SENSOR_FIELDS; i++) {
+                if (period[i].count() > 0) {
+                    record.set((SensorField_e) i, period[i].mean());
+                }
+            }
+            return record;
+        }
+};
+
+#endif // __ATS_01_HISTORY_H__
@@ -0,0 +1,191 @@
+/**
+ * @file ats_01_light.h
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief AgroTechStation 01 auto-ranging of the BH1750 light sensor.
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#ifndef __ATS_01_LIGHT_H__
+#define __ATS_01_LIGHT_H__
+
+#include <stdint.h>
+
+/**
+ * \def LIGHT_MTREG_DEFAULT
+ * BH1750 default measurement time register (1 count = 1 / 1.2 lux in high resolution mode).
+ */
+#define LIGHT_MTREG_DEFAULT             69
+
+/**
+ * \def LIGHT_MTREG_MIN
+ * Smallest measurement time register used (lowest sensitivity, ~118 klux full scale).
+ */
+#define LIGHT_MTREG_MIN                 32
+
+/**
+ * \def LIGHT_MTREG_MAX
+ * Largest measurement time register.
+ */
+#define LIGHT_MTREG_MAX                 254
+
+/**
+ * \def LIGHT_CONVERSION_MAX_MS
+ * Longest conversion time of the BH1750 at the default MTreg (in ms, high resolution modes), scaled by
+ * <tt>MTreg / 69</tt>.
+ */
+#define LIGHT_CONVERSION_MAX_MS         180UL
+
+/**
+ * \def BH1750_POWER_ON
+ * BH1750 opcode: power on (wait for a measurement command).
+ */
+#define BH1750_POWER_ON                 0x01
+
+/**
+ * \def BH1750_ONE_TIME_HIGH_RES
+ * BH1750 opcode: one-time conversion in high resolution mode (1 lux steps at the default MTreg).
+ */
+#define BH1750_ONE_TIME_HIGH_RES        0x20
+
+/**
+ * \def BH1750_ONE_TIME_HIGH_RES_2
+ * BH1750 opcode: one-time conversion in high resolution mode 2 (0.5 lux steps at the default MTreg).
+ */
+#define BH1750_ONE_TIME_HIGH_RES_2      0x21
+
+/**
+ * \def BH1750_MTREG_HIGH
+ * BH1750 opcode: set the 3 high bits of the MTreg (<tt>0x40 | MTreg >> 5</tt>).
+ */
+#define BH1750_MTREG_HIGH               0x40
+
+/**
+ * \def BH1750_MTREG_LOW
+ * BH1750 opcode: set the 5 low bits of the MTreg (<tt>0x60 | MTreg & 0x1F</tt>).
+ */
+#define BH1750_MTREG_LOW                0x60
+
+/**
+ * \def LIGHT_RAW_TARGET
+ * Raw count aimed by the next conversion: a quarter of the full scale, so the light can grow 4 times between two
+ * readings without saturating.
+ */
+#define LIGHT_RAW_TARGET                16384UL
+
+/**
+ * \def LIGHT_RAW_SATURATED
+ * Raw count of a saturated conversion.
+ */
+#define LIGHT_RAW_SATURATED             65535U
+
+/**
+ * @class LightRanger
+ * @brief BH1750 range control. The sensitivity is <tt>MTreg x 2</tt> in high resolution mode 2 (0.5 lux steps)
+ * and \c MTreg in high resolution mode, from \ref LIGHT_MTREG_MIN to <tt>2 x </tt>\ref LIGHT_MTREG_MAX. After
+ * every conversion the sensitivity of the next one is chosen so the same light gives \ref LIGHT_RAW_TARGET
+ * counts: a single conversion is in range unless the light changes more than 4 times between readings.
+ * The sensor may keep its previous MTreg (ex.: one rejected or an I2C error), so \ref started() records the MTreg
+ * of every conversion and the raw count is scaled with it.
+ */
+class LightRanger {
+    public:
+        static const uint16_t MIN_SENSITIVITY = LIGHT_MTREG_MIN;
+        static const uint16_t MAX_SENSITIVITY = 2 * LIGHT_MTREG_MAX;
+
+    private:
+        uint16_t sensitivity = LIGHT_MTREG_DEFAULT;    /**< Sensitivity of the next conversion. */
+        uint16_t converting = LIGHT_MTREG_DEFAULT;     /**< Sensitivity of the conversion in progress. */
+
+    public:
+        /** Measurement time register of the next conversion. */
+        uint8_t mtreg() const {
+            return (uint8_t) ((sensitivity > LIGHT_MTREG_MAX) ? (sensitivity / 2) : sensitivity);
+        }
+
+        /** The next conversion uses high resolution mode 2. */
+        bool highRes2() const { return sensitivity > LIGHT_MTREG_MAX; }
+
+        /** Sensitivity of the next conversion (see \ref LightRanger). */
+        uint16_t getSensitivity() const { return (uint16_t) mtreg() * (highRes2() ? 2 : 1); }
+
+        /**
+         * A conversion started in the mode of \ref highRes2() with \p mtregApplied, the MTreg actually held by
+         * the sensor.
+         */
+        void started(uint8_t mtregApplied) {
+            converting = (uint16_t) mtregApplied * (highRes2() ? 2 : 1);
+        }
+
+        /**
+         * Light (in lux, rounded) of the conversion in progress (see \ref started()):
+         * <tt>raw / 1.2 x 69 / sensitivity</tt>.
+         */
+        uint32_t toLux(uint16_t raw) const {
+            uint32_t den = 6UL * converting;
+            return (((uint32_t) raw * (LIGHT_MTREG_DEFAULT * 5UL)) + (den / 2)) / den;
+        }
+
+        /**
+         * Choose the settings of the next conversion from the raw count of the last one.
+         * @return bool - \c false if the conversion was saturated (the settings drop to the lowest sensitivity).
+         */
+        bool update(uint16_t raw) {
+            if (raw >= LIGHT_RAW_SATURATED) {
+                sensitivity = MIN_SENSITIVITY;
+                return false;
+            }
+            uint32_t next = (LIGHT_RAW_TARGET * converting) / ((raw > 0) ? raw : 1);
+            if (next < MIN_SENSITIVITY) {
+                next = MIN_SENSITIVITY;
+            } else if (next > MAX_SENSITIVITY) {
+                next = MAX_SENSITIVITY;
+            }
+            sensitivity = (uint16_t) next;
+            return true;
+        }
+};
+
+/**
+ * @class SimulatedBH1750
+ * @brief BH1750 model for host builds (typical 1.2 counts per lux at the default MTreg, 16 bits saturation,
+ * 120 ms conversions at the default MTreg), to check how fast the ranging converges. MTreg values out of
+ * \ref LIGHT_MTREG_MIN .. \ref LIGHT_MTREG_MAX are rejected as \c AvrLight does.
+ */
+class SimulatedBH1750 {
+    public:
+        uint32_t lux = 0;                       /**< Light on the sensor (in lux). */
+        uint32_t conversions = 0;               /**< Conversions done. */
+        uint32_t busyMs = 0;                    /**< Total conversion time (in ms). */
+        uint8_t mtreg = LIGHT_MTREG_DEFAULT;    /**< Measurement time register. */
+
+        /**
+         * Set the measurement time register.
+         * @return bool - \c false if \p value is out of range (the register is kept).
+         */
+        bool setMTreg(uint8_t value) {
+            if ((value < LIGHT_MTREG_MIN) || (value > LIGHT_MTREG_MAX)) {
+                return false;
+            }
+            mtreg = value;
+            return true;
+        }
+
+        /** Do a conversion in high resolution mode (2 if \p highRes2) and return the raw count. */
+        uint16_t convert(bool highRes2) {
+            uint32_t raw = (lux * 6UL * mtreg * (highRes2 ? 2 : 1)) / (LIGHT_MTREG_DEFAULT * 5UL);
+            conversions++;
+            busyMs += (120UL * mtreg) / LIGHT_MTREG_DEFAULT;
+            return (raw > LIGHT_RAW_SATURATED) ? LIGHT_RAW_SATURATED : (uint16_t) raw;
+        }
+};
+
+#endif // __ATS_01_LIGHT_H__
@@ -0,0 +1,283 @@
+/**
+ * @file ats_01_log.h
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief AgroTechStation 01 store-and-forward log of readings (wear-levelled circular log into EEPROM).
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#ifndef __ATS_01_LOG_H__
+#define __ATS_01_LOG_H__
+
+#include <stdint.h>
+#include <string.h>
+#include "ats_01_payload.h"
+
+#if defined(__AVR__)
+    #include <avr/eeprom.h>
+#endif
+
+/**
+ * \def LOG_SLOT_SIZE
+ * Log record size (in bytes).\n
+ * Layout:
+ * Byte | Field
+ * :----:|:----:
+ * 0 | state (\ref LOG_STATE_PENDING or \ref LOG_STATE_SENT)
+ * 1-2 | sequence number (little-endian)
+ * 3-10 | reading (packed frame, see \ref PAYLOAD_SIZE)
+ * 11 | CRC-8 of bytes 1 to 10
+ *
+ * Records are written one after the other around the whole EEPROM: per lap, the state and CRC bytes are written
+ * twice (pending then sent, invalidated then valid) and the other bytes once. No head/tail pointer is stored:
+ * \ref RecordLog::begin() rebuilds them from the sequence numbers.
+ */
+#define LOG_SLOT_SIZE                   (4 + PAYLOAD_SIZE)
+
+/**
+ * \def LOG_STATE_PENDING
+ * Record state: not sent yet (erased EEPROM value, so a record is pending from its first write).
+ */
+#define LOG_STATE_PENDING               0xFF
+
+/**
+ * \def LOG_STATE_SENT
+ * Record state: already sent.
+ */
+#define LOG_STATE_SENT                  0x00
+
+/**
+ * @fn    logCrc8
+ * @brief CRC-8 (polynomial 0x07, initial value 0xFF so erased or zeroed EEPROM is never a valid record) used
+ * to validate log records.
+ */
+inline uint8_t logCrc8(const uint8_t* data, uint8_t len) {
+    uint8_t crc = 0xFF;
+    while (len--) {
+        crc ^= *data++;
+        for (uint8_t i = 0; i < 8; i++) {
+            crc = (crc & 0x80) ? (uint8_t) ((crc << 1) ^ 0x07) : (uint8_t) (crc << 1);
+        }
+    }
+    return crc;
+}
+
+#if defined(__AVR__)
+/**
+ * @class AvrEeprom
+ * @brief ATmega internal EEPROM storage. Unchanged bytes are not rewritten (\c eeprom_update_byte).
+ */
+class AvrEeprom {
+    public:
+        static const uint16_t SIZE = E2END + 1;
+        uint8_t read(uint16_t addr) { return eeprom_read_byte((const uint8_t*) (uintptr_t) addr); }
+        void write(uint16_t addr, uint8_t value) { eeprom_update_byte((uint8_t*) (uintptr_t) addr, value); }
+};
+#endif
+
+/**
+ * @class EmulatedEeprom
+ * @brief RAM emulation of the EEPROM for host builds. It counts the writes of every cell (wear) and can simulate
+ * a power loss by dropping all writes after a given number of them.
+ */
+template <uint16_t BYTES>
+class EmulatedEeprom {
+    public:
+        static const uint16_t SIZE = BYTES;
+        uint8_t cells[BYTES];
+        uint32_t wear[BYTES];
+        uint32_t writes = 0;
+        uint32_t powerLossAfter = UINT32_MAX;   /**< Writes accepted before the simulated power loss. */
+
+        EmulatedEeprom() {
+            memset(cells, 0xFF, sizeof(cells));
+            memset(wear, 0, sizeof(wear));
+        }
+        uint8_t read(uint16_t addr) { return cells[addr]; }
+        void write(uint16_t addr, uint8_t value) {
+            if ((writes < powerLossAfter) && (cells[addr] != value)) {
+                cells[addr] = value;
+                wear[addr]++;
+            }
+            writes++;
+        }
+};
+
+/**
+ * @class RecordLog
+ * @brief Circular log of readings not sent yet. When the log is full the oldest pending reading is overwritten.
+ * @tparam STORAGE - storage policy with \c SIZE, \c read(addr) and \c write(addr, value).
+ */
+template <class STORAGE>
+class RecordLog {
+    public:
+        static const uint8_t SLOTS = STORAGE::SIZE / LOG_SLOT_SIZE;
+
+    private:
+        STORAGE& storage;
+        uint8_t head = 0;           /**< Next slot to write. */
+        uint8_t count = 0;          /**< Pending records (ending at head). */
+        uint16_t nextSeq = 0;       /**< Sequence number of the next record. */
+        uint16_t lost = 0;          /**< Pending records released because they failed their CRC. */
+
+        uint16_t slotAddr(uint8_t slot) const { return (uint16_t) slot * LOG_SLOT_SIZE; }
+        uint8_t prevSlot(uint8_t slot) const { return (slot == 0) ? (SLOTS - 1) : (slot - 1); }
+        uint8_t tailSlot() const { return (head >= count) ? (head - count) : (head + SLOTS - count); }
+
+        /** Read and validate a record. */
+        bool readSlot(uint8_t slot, uint8_t& state, uint16_t& seq, uint8_t* frame) {
+            uint8_t raw[LOG_SLOT_SIZE];
+            uint16_t addr = slotAddr(slot);
+            for (uint8_t i = 0; i < LOG_SLOT_SIZE; i++) {
+                raw[i] = storage.read(addr + i);
+            }
+            if (logCrc8(&raw[1], LOG_SLOT_SIZE - 2) != raw[LOG_SLOT_SIZE - 1]) {
+                return false;
+            }
+            state = raw[0];
+            seq = (uint16_t) raw[1] | ((uint16_t) raw[2] << 8);
+            if (frame != NULL) {
+                memcpy(frame, &raw[3], PAYLOAD_SIZE);
+            }
+            return true;
+        }
+
+        /** Release the oldest pending record (marked as sent). */
+        void release() {
+            storage.write(slotAddr(tailSlot()), LOG_STATE_SENT);
+            count--;
+        }
+
+    public:
+        RecordLog(STORAGE& eeprom) : storage(eeprom) { }
+
+        /**
+         * Rebuild the log state from the stored records (call at boot). A record interrupted by a power loss fails
+         * its CRC and is ignored.
+         */
+        void begin() {
+            uint8_t state;
+            uint16_t seq;
+            int16_t newest = -1;
+            uint16_t newestSeq = 0;
+
+            // Newest valid record
+            for (uint8_t slot = 0; slot < SLOTS; slot++) {
+                if (readSlot(slot, state, seq, NULL) && ((newest < 0) || ((int16_t) (seq - newestSeq) > 0))) {
+                    newest = slot;
+                    newestSeq = seq;
+                }
+            }
+            count = 0;
+            if (newest < 0) {
+                head = 0;
+                nextSeq = 0;
+                return;
+            }
+            head = (uint8_t) ((newest + 1) % SLOTS);
+            nextSeq = newestSeq + 1;
+
+            // Pending records are the consecutive ones ending at the newest
+            uint8_t slot = (uint8_t) newest;
+            uint16_t expected = newestSeq;
+            while ((count < SLOTS) && readSlot(slot, state, seq, NULL) && (seq == expected) &&
+                   (state == LOG_STATE_PENDING)) {
+                count++;
+                expected--;
+                slot = prevSlot(slot);
+            }
+        }
+
+        /**
+         * Store a reading. The CRC of the record overwritten is invalidated first, since the state byte is not
+         * covered by it (a sent record must never turn pending), and the new CRC is written last: an interrupted
+         * write leaves an invalid record.
+         */
+        void append(const STATION_SENSORS_T& data) {
+            uint8_t raw[LOG_SLOT_SIZE];
+            raw[0] = LOG_STATE_PENDING;
+            raw[1] = (uint8_t) nextSeq;
+            raw[2] = (uint8_t) (nextSeq >> 8);
+            encodePayload(data, &raw[3]);
+            raw[LOG_SLOT_SIZE - 1] = logCrc8(&raw[1], LOG_SLOT_SIZE - 2);
+
+            uint16_t addr = slotAddr(head);
+            uint16_t crcAddr = addr + LOG_SLOT_SIZE - 1;
+            storage.write(crcAddr, (uint8_t) ~storage.read(crcAddr));
+            for (uint8_t i = 0; i < LOG_SLOT_SIZE; i++) {
+                storage.write(addr + i, raw[i]);
+            }
+            head = (uint8_t) ((head + 1) % SLOTS);
+            nextSeq++;
+            if (count < SLOTS) {
+                count++;
+            }
+        }
+
+        /**
+         * Read the oldest pending readings (as packed frames) without removing them. Corrupted records (ex.: a
+         * write interrupted by a power loss) at the start of the log are released, so they never block it; the
+         * frames read stop before a corrupted record (released by the next call).
+         * @return uint8_t - number of frames read (0 only if nothing is pending).
+         */
+        uint8_t peek(uint8_t frames[][PAYLOAD_SIZE], uint8_t max, uint16_t& firstSeq) {
+            uint8_t state;
+            uint16_t seq;
+            while ((count > 0) && !readSlot(tailSlot(), state, seq, NULL)) {
+                release();
+                lost++;
+            }
+
+            uint8_t n = 0;
+            uint16_t first = 0;
+            uint8_t slot = tailSlot();
+            while ((n < max) && (n < count)) {
+                if (!readSlot(slot, state, seq, frames[n]) || ((n > 0) && (seq != (uint16_t) (first + n)))) {
+                    break;
+                }
+                if (n == 0) {
+                    first = seq;
+                }
+                n++;
+                slot = (uint8_t) ((slot + 1) % SLOTS);
+            }
+            if (n > 0) {
+                firstSeq = first;
+            }
+            return n;
+        }
+
+        /**
+         * Mark as sent the pending readings with sequence numbers below \p firstSeq + \p n (the ones returned by
+         * \ref peek(), even if some of them were overwritten meanwhile). Corrupted records met on the way are
+         * released too.
+         */
+        void commit(uint16_t firstSeq, uint8_t n) {
+            uint8_t state;
+            uint16_t seq;
+            uint16_t endSeq = firstSeq + n;
+            while (count > 0) {
+                if (!readSlot(tailSlot(), state, seq, NULL)) {
+                    lost++;
+                } else if ((int16_t) (seq - endSeq) >= 0) {
+                    break;
+                }
+                release();
+            }
+        }
+
+        uint8_t pending() const { return count; }
+
+        /** Pending records lost because they were corrupted. */
+        uint16_t corrupted() const { return lost; }
+};
+
+#endif // __ATS_01_LOG_H__
@@ -0,0 +1,333 @@
+/**
+ * @file ats_01_payload.h
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief AgroTechStation 01 uplink payload encoder/decoder.
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>). 
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at 
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,  
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or 
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing 
+ * permissions and limitations under the License.
+ */
+#ifndef __ATS_01_PAYLOAD_H__
+#define __ATS_01_PAYLOAD_H__
+
+#include <stdint.h>
+#include <string.h>
+#include "ats_01_data.h"
+
+/**
+ * \def PAYLOAD_SIZE 
+ * Binary payload size (in bytes): the packed station record itself (see \ref STATION_SENSORS_T for the layout).
+ */
+#define PAYLOAD_SIZE                    STATION_RECORD_SIZE
+
+uint8_t encodePayload(const STATION_SENSORS_T& data, uint8_t* buf);
+bool decodePayload(const uint8_t* buf, uint8_t len, STATION_SENSORS_T& data);
+
+/**
+ * \def PAYLOAD_FIELDS 
+ * Number of fields into the binary payload: the validity flags followed by the sensor fields.
+ */
+#define PAYLOAD_FIELDS                  (1 + SENSOR_FIELDS)
+
+void unpackPayloadFields(const uint8_t* buf, int32_t fields[PAYLOAD_FIELDS]);
+void packPayloadFields(const int32_t fields[PAYLOAD_FIELDS], uint8_t* buf);
+
+/**
+ * \def PAYLOAD_DELTA_KEYFRAME_PERIOD 
+ * Number of delta frames sent between two complete (key) frames, so the server recovers from lost uplinks.
+ */
+#define PAYLOAD_DELTA_KEYFRAME_PERIOD   8
+
+/**
+ * \def PAYLOAD_DELTA_KEYFRAME 
+ * Delta payload header flag for a complete (key) frame.
+ */
+#define PAYLOAD_DELTA_KEYFRAME          0x80
+
+/*********************************************
+ *          CAYENNE LPP IDENTIFIERS
+ ********************************************/
+#define LPP_CH_AIR_TEMPERATURE          1       /**< Cayenne LPP channel of air temperature. */
+#define LPP_CH_AIR_HUMIDITY             2       /**< Cayenne LPP channel of air humidity. */
+#define LPP_CH_LIGHT                    3       /**< Cayenne LPP channel of light. */
+#define LPP_CH_UV_INDEX                 4       /**< Cayenne LPP channel of UV index. */
+#define LPP_CH_BATTERY_VOLTAGE          5       /**< Cayenne LPP channel of battery voltage. */
+#define LPP_TYPE_ANALOG_INPUT           2       /**< Cayenne LPP analog input (2 bytes, 0.01 signed). */
+#define LPP_TYPE_LUMINOSITY             101     /**< Cayenne LPP luminosity (2 bytes, 1 lux unsigned). */
+#define LPP_TYPE_TEMPERATURE            103     /**< Cayenne LPP temperature (2 bytes, 0.1 oC signed). */
+#define LPP_TYPE_HUMIDITY               104     /**< Cayenne LPP humidity (1 byte, 0.5 % unsigned). */
+
+/**
+ * @enum PayloadFormat_e
+ * @brief Uplink payload format.
+ * @var PAYLOAD_PACKED
+ * Fixed-point packed frame (see \ref PAYLOAD_SIZE).
+ * @var PAYLOAD_CAYENNE_LPP
+ * Cayenne Low Power Payload (invalid fields are omitted).
+ * @var PAYLOAD_DELTA
+ * Header byte followed by the zigzag varint deltas of the changed fields (periodic packed key frames).
+ * @var PAYLOAD_BATCH
+ * Several readings compressed into one uplink (see ats_01_batch.h).
+ */
+enum PayloadFormat_e {
+    PAYLOAD_PACKED,
+    PAYLOAD_CAYENNE_LPP,
+    PAYLOAD_DELTA,
+    PAYLOAD_BATCH
+};
+
+/**
+ * @fn    divRound
+ * @brief Integer division rounding half away from zero (\p divisor must be positive).
+ */
+inline int32_t divRound(int32_t value, int32_t divisor) {
+    return ((value < 0) ? (value - (divisor / 2)) : (value + (divisor / 2))) / divisor;
+}
+
+/**
+ * @fn    zigzagEncode
+ * @brief Map a signed value to unsigned so small magnitudes give small codes (0, -1, 1, -2 => 0, 1, 2, 3).
+ */
+inline uint32_t zigzagEncode(int32_t value) {
+    return ((uint32_t) value << 1) ^ (uint32_t) (value >> 31);
+}
+
+/**
+ * @fn    zigzagDecode
+ * @brief Inverse of \ref zigzagEncode.
+ */
+inline int32_t zigzagDecode(uint32_t code) {
+    return (int32_t) (code >> 1) ^ -(int32_t) (code & 1);
+}
+
+/**
+ * @fn    putVarint
+ * @brief Write an unsigned value as a varint (7 bits per byte, least significant group first).
+ * @return uint8_t - bytes written.
+ */
+inline uint8_t putVarint(uint8_t* buf, uint32_t value) {
+    uint8_t n = 0;
+    while (value >= 0x80) {
+        buf[n++] = (uint8_t) (value | 0x80);
+        value >>= 7;
+    }
+    buf[n++] = (uint8_t) value;
+    return n;
+}
+
+/**
+ * @fn    getVarint
+ * @brief Read a varint written by \ref putVarint.
+ * @return uint8_t - bytes read (0 if the varint is truncated).
+ */
+inline uint8_t getVarint(const uint8_t* buf, uint8_t len, uint32_t& value) {
+    value = 0;
+    for (uint8_t n = 0; (n < len) && (n < 5); n++) {
+        value |= (uint32_t) (buf[n] & 0x7F) << (7 * n);
+        if ((buf[n] & 0x80) == 0) {
+            return n + 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @class PayloadEncoder
+ * @brief Uplink payload encoder selected at compile time. Only the specialization used by the station is
+ * instantiated, so the other formats cost no flash.\n
+ * Every specialization provides:
+ * - \c MAX_SIZE: largest payload, \c MIN_UPLINK: smallest uplink it works with and \c MAX_READINGS: readings it
+ *   holds;
+ * - \c encode(data, buf, size): payload size (0 when there is nothing to send yet) of at most \c size bytes;
+ * - \c delivered(): the last payload was sent, its readings are dropped;
+ * - \c release(readings): the readings held (oldest first, the ones of an undelivered payload included) are copied
+ *   and dropped, so they can be stored into the log;
+ * - \c reset(): the readings held are dropped and stateful formats restart.
+ */
+template <PayloadFormat_e FORMAT>
+class PayloadEncoder;
+
+/**
+ * @fn    payloadFits
+ * @brief The encoder \p FORMAT works with uplinks of \p maxPayload bytes (see \c loraMaxPayload()). The modem
+ * refuses longer messages, so a format that does not fit the smallest uplink of the station cannot be used.
+ */
+template <PayloadFormat_e FORMAT>
+inline bool payloadFits(uint8_t maxPayload) {
+    return PayloadEncoder<FORMAT>::MIN_UPLINK <= maxPayload;
+}
+
+/**
+ * @class PayloadSingleReading
+ * @brief Readings held by the encoders of one reading per payload: the reading of the last payload, until it is
+ * delivered or released.
+ */
+class PayloadSingleReading {
+    protected:
+        STATION_SENSORS_T last;
+        uint8_t held = 0;
+
+        /** Hold \p data, the reading of the payload being returned. */
+        void hold(const STATION_SENSORS_T& data) {
+            last = data;
+            held = 1;
+        }
+
+    public:
+        static const uint8_t MAX_READINGS = 1;
+
+        void delivered() { held = 0; }
+
+        uint8_t release(STATION_SENSORS_T* readings) {
+            uint8_t n = held;
+            if (held > 0) {
+                readings[0] = last;
+                held = 0;
+            }
+            return n;
+        }
+};
+
+/**
+ * @brief Fixed-point packed frame encoder (see \ref PAYLOAD_SIZE).
+ */
+template <>
+class PayloadEncoder<PAYLOAD_PACKED> : public PayloadSingleReading {
+    public:
+        static const uint8_t MAX_SIZE = PAYLOAD_SIZE;
+        static const uint8_t MIN_UPLINK = MAX_SIZE;
+
+        uint8_t encode(const STATION_SENSORS_T& data, uint8_t* buf, uint8_t size = MAX_SIZE) {
+            (void) size;
+            hold(data);
+            return encodePayload(data, buf);
+        }
+
+        void reset() { held = 0; }
+};
+
+/**
+ * @brief Cayenne LPP encoder. UV index and battery voltage use the analog input type (0.01 resolution).
+ */
+template <>
+class PayloadEncoder<PAYLOAD_CAYENNE_LPP> : public PayloadSingleReading {
+    private:
+        static uint8_t put(uint8_t* buf, uint8_t channel, uint8_t type, uint16_t value) {
+            buf[0] = channel;
+            buf[1] = type;
+            buf[2] = (uint8_t) (value >> 8);
+            buf[3] = (uint8_t) value;
+            return 4;
+        }
+
+    public:
+        static const uint8_t MAX_SIZE = 19;
+        static const uint8_t MIN_UPLINK = MAX_SIZE;
+
+        uint8_t encode(const STATION_SENSORS_T& data, uint8_t* buf, uint8_t size = MAX_SIZE) {
+            uint8_t len = 0;
+            (void) size;
+
+            if (data.isValid(SENSOR_AIR_TEMPERATURE)) {
+                len += put(&buf[len], LPP_CH_AIR_TEMPERATURE, LPP_TYPE_TEMPERATURE,
+                           (uint16_t) divRound(data.airTemperature(), 10));
+            }
+            if (data.isValid(SENSOR_AIR_HUMIDITY) && (data.airHumidity() <= 1000)) {
+                buf[len++] = LPP_CH_AIR_HUMIDITY;
+                buf[len++] = LPP_TYPE_HUMIDITY;
+                buf[len++] = (uint8_t) divRound(data.airHumidity(), 5);
+            }
+            if (data.isValid(SENSOR_LIGHT)) {
+                len += put(&buf[len], LPP_CH_LIGHT, LPP_TYPE_LUMINOSITY, data.light());
+            }
+            if (data.isValid(SENSOR_UV_INDEX)) {
+                len += put(&buf[len], LPP_CH_UV_INDEX, LPP_TYPE_ANALOG_INPUT, (uint16_t) (data.uvIndex() * 100));
+            }
+            if (data.isValid(SENSOR_BATTERY_VOLTAGE)) {
+                len += put(&buf[len], LPP_CH_BATTERY_VOLTAGE, LPP_TYPE_ANALOG_INPUT,
+                           (uint16_t) divRound(data.batteryVoltage(), 10));
+            }
+            if (len > 0) {
+                hold(data);
+            }
+            return len;
+        }
+
+        void reset() { held = 0; }
+};
+
+/**
+ * @brief Delta encoder. A key frame (\ref PAYLOAD_DELTA_KEYFRAME header followed by the packed frame) is sent
+ * first and then every \ref PAYLOAD_DELTA_KEYFRAME_PERIOD frames. The other frames carry a header with the bitmask
+ * of changed fields followed by their zigzag varint deltas against the previous frame.
+ */
+template <>
+class PayloadEncoder<PAYLOAD_DELTA> : public PayloadSingleReading {
+    private:
+        int32_t reference[PAYLOAD_FIELDS];
+        uint8_t deltaFrames = PAYLOAD_DELTA_KEYFRAME_PERIOD;
+
+    public:
+        static const uint8_t MAX_SIZE = 1 + (PAYLOAD_FIELDS * 3);
+        static const uint8_t MIN_UPLINK = MAX_SIZE;
+
+        uint8_t encode(const STATION_SENSORS_T& data, uint8_t* buf, uint8_t size = MAX_SIZE) {
+            int32_t fields[PAYLOAD_FIELDS];
+            uint8_t len = 1;
+            (void) size;
+
+            encodePayload(data, &buf[1]);
+            unpackPayloadFields(&buf[1], fields);
+            if (deltaFrames >= PAYLOAD_DELTA_KEYFRAME_PERIOD) {
+                buf[0] = PAYLOAD_DELTA_KEYFRAME;
+                len += PAYLOAD_SIZE;
+                deltaFrames = 0;
+            } else {
+                buf[0] = 0;
+                for (uint8_t i = 0; i < PAYLOAD_FIELDS; i++) {
+                    if (fields[i] != reference[i]) {
+                        buf[0] |= (1 << i);
+                        len += putVarint(&buf[len], zigzagEncode(fields[i] - reference[i]));
+                    }
+                }
+                deltaFrames++;
+            }
+            memcpy(reference, fields, sizeof(reference));
+            hold(data);
+            return len;
+        }
+
+        /** The next frame is a key frame: the server may have missed the released one. */
+        uint8_t release(STATION_SENSORS_T* readings) {
+            reset();
+            return PayloadSingleReading::release(readings);
+        }
+
+        /** Force the next frame to be a key frame (ex.: after a failed uplink). */
+        void reset() {
+            held = 0;
+            deltaFrames = PAYLOAD_DELTA_KEYFRAME_PERIOD;
+        }
+};
+
+/**
+ * @class PayloadDeltaDecoder
+ * @brief Decoder of \ref PAYLOAD_DELTA frames (server side / host tools). Frames must be fed in order.
+ */
+class PayloadDeltaDecoder {
+    private:
+        int32_t reference[PAYLOAD_FIELDS];
+        bool synced = false;
+
+    public:
+        bool decode(const uint8_t* buf, uint8_t len, STATION_SENSORS_T& data);
+};
+
+#endif // __ATS_01_PAYLOAD_H__
@@ -0,0 +1,120 @@
+/**
+ * @file ats_01_report.h
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief AgroTechStation 01 report-on-change policy.
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#ifndef __ATS_01_REPORT_H__
+#define __ATS_01_REPORT_H__
+
+#include <stdint.h>
+#include "ats_01_data.h"
+
+/**
+ * @struct ReportDeadband_t
+ * @brief Report-on-change settings. A field changed significantly when it moved from the last reported value by
+ * at least the largest of its absolute and relative deadbands, or when it became valid or invalid.
+ */
+typedef struct {
+    uint16_t absolute[SENSOR_FIELDS];       /**< Absolute deadband of each field (in field units). */
+    uint8_t relativePercent[SENSOR_FIELDS]; /**< Relative deadband of each field (in % of the last reported value). */
+    uint32_t heartbeat;                     /**< Longest interval without a report (in ms). */
+} ReportDeadband_t;
+
+/**
+ * @class ReportPolicy
+ * @brief Decide after each sampling pass if the reading must be reported: on a significant change of any field
+ * (see \ref ReportDeadband_t) or when the heartbeat interval elapsed since the last report.
+ */
+class ReportPolicy {
+    private:
+        const ReportDeadband_t& deadband;
+        STATION_SENSORS_T reference;
+        uint32_t lastReport = 0;
+        bool hasReference = false;
+
+    public:
+        ReportPolicy(const ReportDeadband_t& settings) : deadband(settings) { }
+
+        /** Some field of \p reading changed significantly since the last report. */
+        bool changed(const STATION_SENSORS_T& reading) const {
+            for (uint8_t i = 0; i < SENSOR_FIELDS; i++) {
+                SensorField_e field = (SensorField_e) i;
+                if (reading.isValid(field) != reference.isValid(field)) {
+                    return true;
+                }
+                if (!reading.isValid(field)) {
+                    continue;
+                }
+                int32_t last = reference.value(field);
+                int32_t delta = reading.value(field) - last;
+                uint32_t band = ((uint32_t) ((last < 0) ? -last : last) * deadband.relativePercent[i]) / 100;
+                if (band < deadband.absolute[i]) {
+                    band = deadband.absolute[i];
+                }
+                if ((uint32_t) ((delta < 0) ? -delta : delta) >= band) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /** \p reading must be reported at \p now (in ms). */
+        bool due(const STATION_SENSORS_T& reading, uint32_t now) const {
+            return !hasReference || ((uint32_t) (now - lastReport) >= deadband.heartbeat) || changed(reading);
+        }
+
+        /** \p reading was reported at \p now (in ms): it becomes the reference of the next decisions. */
+        void reported(const STATION_SENSORS_T& reading, uint32_t now) {
+            reference = reading;
+            lastReport = now;
+            hasReference = true;
+        }
+
+        /** Report the next reading whatever it is (ex.: after a lost uplink). */
+        void reset() { hasReference = false; }
+};
+
+/**
+ * @class ReportSimulator
+ * @brief Host tool: replay a trace of readings sampled every \c period ms through a \ref ReportPolicy and count
+ * the uplinks it needs, against one uplink per reading with the fixed cadence.
+ */
+class ReportSimulator {
+    private:
+        ReportPolicy policy;
+        uint32_t period;
+        uint32_t now = 0;
+
+    public:
+        uint32_t samples = 0;       /**< Readings replayed (uplinks of the fixed cadence). */
+        uint32_t uplinks = 0;       /**< Uplinks of the report-on-change policy. */
+        uint32_t heartbeats = 0;    /**< Uplinks sent only because of the heartbeat. */
+
+        ReportSimulator(const ReportDeadband_t& settings, uint32_t samplePeriod) : policy(settings), period(samplePeriod) { }
+
+        /** Replay the next reading of the trace. */
+        void feed(const STATION_SENSORS_T& reading) {
+            if (policy.due(reading, now)) {
+                if ((samples > 0) && !policy.changed(reading)) {
+                    heartbeats++;
+                }
+                policy.reported(reading, now);
+                uplinks++;
+            }
+            samples++;
+            now += period;
+        }
+};
+
+#endif // __ATS_01_REPORT_H__
@@ -0,0 +1,162 @@
+/**
+ * @file ats_01_sleep.h
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief AgroTechStation 01 deep-sleep scheduler.
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#ifndef __ATS_01_SLEEP_H__
+#define __ATS_01_SLEEP_H__
+
+#include <stdint.h>
+
+/**
+ * \def WDT_NOMINAL_US
+ * Nominal watchdog shortest timeout (in us): 2048 cycles of the 128 kHz oscillator. Timeout \c k lasts
+ * <tt>WDT_NOMINAL_US << k</tt> (k = 0 .. \ref WDT_MAX_TIMEOUT).
+ */
+#define WDT_NOMINAL_US                  16000UL
+
+/**
+ * \def WDT_MAX_TIMEOUT
+ * Longest watchdog timeout index (8 s).
+ */
+#define WDT_MAX_TIMEOUT                 9
+
+#if defined(__AVR__)
+/**
+ * @class AvrSleep
+ * @brief ATmega328p sleep platform: power-down with watchdog wakeup, idle sleep and watchdog calibration.
+ */
+class AvrSleep {
+    public:
+        void begin();
+        unsigned long millis();
+        void powerDown(uint8_t timeout);
+        void idle();
+        uint32_t measureWdtUs();
+};
+#endif
+
+/**
+ * @class SimulatedSleep
+ * @brief Simulated sleep platform for host builds. Like on the MCU, \c millis() stops while powered down, the
+ * watchdog period can be skewed to check the calibration and other interrupts can wake the MCU (which powers
+ * down again until the watchdog). \c realMs is the wall clock.
+ */
+class SimulatedSleep {
+    public:
+        unsigned long awakeMs = 0;      /**< Simulated millis() (runs only while awake). */
+        uint32_t realMs = 0;            /**< Wall clock (in ms). */
+        uint32_t wdtUs = WDT_NOMINAL_US;    /**< Real shortest watchdog timeout (in us). */
+        uint32_t powerDowns = 0;        /**< Number of power-down periods. */
+        uint32_t poweredDownMs = 0;     /**< Total time powered down (in ms). */
+        uint32_t poweredDownUs = 0;     /**< Time powered down below 1 ms. */
+        uint32_t interruptMs = 0;       /**< Period of the interrupts waking the MCU while powered down (0: none). */
+        uint32_t earlyWakes = 0;        /**< Wakeups by those interrupts. */
+
+        void begin() { }
+        unsigned long millis() { return awakeMs; }
+        void powerDown(uint8_t timeout) {
+            uint32_t us = (wdtUs << timeout) + poweredDownUs;
+            uint32_t ms = us / 1000;
+            poweredDownUs = us % 1000;
+            if (interruptMs > 0) {
+                earlyWakes += ((realMs % interruptMs) + ms) / interruptMs;
+            }
+            realMs += ms;
+            poweredDownMs += ms;
+            powerDowns++;
+        }
+        void idle() {
+            awakeMs++;
+            realMs++;
+        }
+        uint32_t measureWdtUs() { return wdtUs; }
+};
+
+/**
+ * @class SleepScheduler
+ * @brief Sleep until a given logical time using the longest watchdog power-down periods that fit, and finishing
+ * in idle sleep. The logical time (\ref now()) is \c millis() plus the calibrated time slept, because the
+ * timer behind \c millis() stops while powered down.
+ * @tparam PLATFORM - platform policy (\ref AvrSleep or \ref SimulatedSleep).
+ */
+template <class PLATFORM>
+class SleepScheduler {
+    private:
+        PLATFORM& platform;
+        uint32_t sleptMs = 0;
+        uint16_t sleptUs = 0;               /**< Slept time below 1 ms (carried to the next sleep). */
+        uint32_t wdtUs = WDT_NOMINAL_US;    /**< Calibrated shortest watchdog timeout (in us). */
+
+        /** Calibrated duration (in ms) of the watchdog timeout \p timeout. */
+        uint32_t wdtMs(uint8_t timeout) const {
+            return (wdtUs << timeout) / 1000;
+        }
+
+    public:
+        SleepScheduler(PLATFORM& sleepDriver) : platform(sleepDriver) { }
+
+        /** Configure the platform and calibrate the watchdog. */
+        void begin() {
+            platform.begin();
+            calibrate();
+        }
+
+        /** Measure the real watchdog period (the 128 kHz oscillator drifts with voltage and temperature). */
+        void calibrate() {
+            uint32_t us = platform.measureWdtUs();
+            if ((us > (WDT_NOMINAL_US / 2)) && (us < (WDT_NOMINAL_US * 2))) {
+                wdtUs = us;
+            }
+        }
+
+        /** Logical time (in ms), kept across power-down periods. */
+        uint32_t now() {
+            return platform.millis() + sleptMs;
+        }
+
+        /**
+         * Sleep until the logical time \p wakeTime. Every power-down lasts its whole watchdog timeout (see
+         * \ref AvrSleep::powerDown()), so the time slept is counted even when other interrupts woke the MCU.
+         */
+        void sleepUntil(uint32_t wakeTime) {
+            for (;;) {
+                int32_t remaining = (int32_t) (wakeTime - now());
+                if (remaining < (int32_t) wdtMs(0)) {
+                    break;
+                }
+                uint8_t timeout = WDT_MAX_TIMEOUT;
+                while ((timeout > 0) && (wdtMs(timeout) > (uint32_t) remaining)) {
+                    timeout--;
+                }
+                platform.powerDown(timeout);
+                uint32_t us = (wdtUs << timeout) + sleptUs;
+                sleptMs += us / 1000;
+                sleptUs = (uint16_t) (us % 1000);
+            }
+            while ((int32_t) (wakeTime - now()) > 0) {
+                platform.idle();
+            }
+        }
+
+        /** Sleep without stopping the clocks (peripherals and serial ports keep working). */
+        void idle() {
+            platform.idle();
+        }
+
+        /** Calibrated shortest watchdog timeout (in us, \ref WDT_NOMINAL_US is nominal). */
+        uint32_t getWdtUs() const { return wdtUs; }
+};
+
+#endif // __ATS_01_SLEEP_H__
@@ -0,0 +1,83 @@
+/**
+ * @file ats_01_station.h
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief AgroTechStation 01 wiring and station objects.
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ *
+ * The station objects are defined by \c ats_01.h, which is only included by \c ats_01.cpp. This header declares
+ * them for the native simulation (\c ats_01_sim.cpp) and the host tests.
+ */
+#ifndef __ATS_01_STATION_H__
+#define __ATS_01_STATION_H__
+
+#include "AgroTechLab_LoRa.h"
+#include "ats_01_hal.h"
+#include "ats_01_data.h"
+
+/*********************************************
+ *              STATION WIRING
+ ********************************************/
+/**
+ * \def DHT_PIN 
+ * DHT22 sensor device pin. It must be an external interrupt pin (2 or 3), see \ref AvrDht.
+ */
+#define DHT_PIN                         2
+static_assert(digitalPinToInterrupt(DHT_PIN) != NOT_AN_INTERRUPT, "DHT_PIN must be an external interrupt pin");
+
+/**
+ * \def LIGHT_SENSOR_ADDR 
+ * Light sensor (GY30) I2C address.
+ */
+#define LIGHT_SENSOR_ADDR               0x23
+
+/**
+ * \def UVM30A_PIN 
+ * UVM30A sensor pin.
+ */
+#define UVM30A_PIN                      A0
+
+/**
+ * \def VOLTAGE_SENSOR_PIN 
+ * Voltage sensor pin.
+ */
+#define VOLTAGE_SENSOR_PIN              A1
+
+/*********************************************
+ *             VOLTAGE SENSOR
+ ********************************************/
+constexpr uint32_t voltageSensor_R1 = 6800;    /**< Voltage sensor resistor 1 (in ohms). */
+constexpr uint32_t voltageSensor_R2 = 4700;    /**< Voltage sensor resistor 2 (in ohms). */
+constexpr uint32_t adcVref_mV = 5000;          /**< ADC reference voltage (in mV). */
+
+/*********************************************
+ *             STATION OBJECTS
+ ********************************************/
+extern bool configError;
+extern STATION_SENSORS_T sensorsData;
+extern StationPins pins;
+extern StationEeprom stationEeprom;
+extern RecordLog<StationEeprom> recordLog;
+extern DhtDecoder dhtDecoder;
+extern StationDht dht;
+extern SENSOR_STATS_T dhtStats;
+extern StationLight light;
+extern LightRanger lightRanger;
+extern ModemSerial loraSerial;
+extern LoRa lora;
+extern LoRaConfig_t loraCfg;
+extern DataRateController rateController;
+extern StationAdc adc;
+extern StationSleep sleepPlatform;
+extern SleepScheduler<StationSleep> scheduler;
+
+#endif // __ATS_01_STATION_H__
@@ -0,0 +1,112 @@
+/**
+ * @file ats_01_tasks.h
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief AgroTechStation 01 periodic task table and cooperative dispatcher.
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#ifndef __ATS_01_TASKS_H__
+#define __ATS_01_TASKS_H__
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__AVR__)
+    #include <avr/pgmspace.h>
+#endif
+
+/**
+ * @struct PeriodicTask_t
+ * @brief Entry of a task table. Task \c i first runs at <tt>phase</tt> ms after \ref TaskDispatcher::begin() and
+ * then every \c period ms. Tasks due at the same time run in table order.
+ */
+typedef struct {
+    void (*run)();          /**< Task function. */
+    uint32_t period;        /**< Run period (in ms). */
+    uint32_t phase;         /**< Offset of the first run (in ms). */
+} PeriodicTask_t;
+
+/**
+ * @class TaskDispatcher
+ * @brief Cooperative dispatcher of a constant task table (stored in flash on AVR). Tasks run to completion;
+ * runs missed while another task was running are skipped, keeping the task phase.
+ * @tparam N - number of tasks of the table.
+ */
+template <uint8_t N>
+class TaskDispatcher {
+    private:
+        const PeriodicTask_t* table;
+        uint32_t due[N];
+        uint32_t maxJitter[N];
+
+        /** Copy a table entry to RAM. */
+        static void load(const PeriodicTask_t* src, PeriodicTask_t& dst) {
+            #if defined(__AVR__)
+                memcpy_P(&dst, src, sizeof(PeriodicTask_t));
+            #else
+                dst = *src;
+            #endif
+        }
+
+    public:
+        TaskDispatcher(const PeriodicTask_t (&tasks)[N]) : table(tasks) { }
+
+        /** Schedule the first run of every task relative to \p now (in ms). */
+        void begin(uint32_t now) {
+            PeriodicTask_t task;
+            for (uint8_t i = 0; i < N; i++) {
+                load(&table[i], task);
+                due[i] = now + task.phase;
+                maxJitter[i] = 0;
+            }
+        }
+
+        /**
+         * Run the tasks due at \p now (in ms), in table order.
+         * @return uint8_t - number of tasks run.
+         */
+        uint8_t dispatch(uint32_t now) {
+            PeriodicTask_t task;
+            uint8_t count = 0;
+            for (uint8_t i = 0; i < N; i++) {
+                if ((int32_t) (due[i] - now) > 0) {
+                    continue;
+                }
+                load(&table[i], task);
+                if ((now - due[i]) > maxJitter[i]) {
+                    maxJitter[i] = now - due[i];
+                }
+                task.run();
+                count++;
+                do {
+                    due[i] += task.period;
+                } while ((int32_t) (due[i] - now) <= 0);
+            }
+            return count;
+        }
+
+        /** Earliest due time among all tasks (in ms). */
+        uint32_t nextDue(uint32_t now) const {
+            uint32_t next = due[0];
+            for (uint8_t i = 1; i < N; i++) {
+                if ((int32_t) (due[i] - now) < (int32_t) (next - now)) {
+                    next = due[i];
+                }
+            }
+            return next;
+        }
+
+        /** Largest delay (in ms) between the due time and the run of task \p i. */
+        uint32_t getMaxJitter(uint8_t i) const { return maxJitter[i]; }
+};
+
+#endif // __ATS_01_TASKS_H__
@@ -0,0 +1,136 @@
+/**
+ * @file ats_01_uv.h
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief AgroTechStation 01 UV index lookup table (UVM30A).
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#ifndef __ATS_01_UV_H__
+#define __ATS_01_UV_H__
+
+#include <stdint.h>
+#include "ats_01_adc.h"
+
+#if defined(__AVR__)
+    #include <avr/pgmspace.h>
+#else
+    #ifndef PROGMEM
+        #define PROGMEM
+    #endif
+    #ifndef pgm_read_byte
+        #define pgm_read_byte(addr) (*(const uint8_t*) (addr))
+    #endif
+#endif
+
+/**
+ * \def UV_ADC_VREF_MV
+ * ADC reference voltage (in mV) of the UV sensor reads (AVcc).
+ */
+#define UV_ADC_VREF_MV                  5000UL
+
+/**
+ * \def UV_ADC_CODES
+ * Number of ADC codes of the lookup table (\ref ADC_BITS bits).
+ */
+#define UV_ADC_CODES                    (1U << ADC_BITS)
+
+/**
+ * UVM30A output upper bound (in mV) of each UV index (see \ref uvm30a_page): index \c i goes up to
+ * <tt>UV_INDEX_MV[i]</tt> and index 12 is above the last one.
+ */
+constexpr uint16_t UV_INDEX_MV[] = { 50, 227, 318, 408, 503, 606, 696, 795, 881, 976, 1079, 1170 };
+
+/**
+ * @fn    uvIndexOfMv
+ * @brief UV index of a sensor output (in mV), scanning \ref UV_INDEX_MV from \p i (compile time only).
+ */
+constexpr uint8_t uvIndexOfMv(uint16_t mv, uint8_t i = 0) {
+    return ((i >= (sizeof(UV_INDEX_MV) / sizeof(UV_INDEX_MV[0]))) || (mv <= UV_INDEX_MV[i])) ? i
+        : uvIndexOfMv(mv, i + 1);
+}
+
+/**
+ * @fn    adcCodeToMv
+ * @brief Voltage (in mV) at the middle of the ADC code \p code.
+ */
+constexpr uint16_t adcCodeToMv(uint16_t code) {
+    return (uint16_t) ((((2UL * code) + 1) * UV_ADC_VREF_MV) / (2UL * UV_ADC_CODES));
+}
+
+/**
+ * @struct IndexSequence
+ * @brief Compile time list of indexes <tt>0 .. N-1</tt> (see \ref MakeIndexSequence).
+ */
+template <uint16_t... I>
+struct IndexSequence {
+    typedef IndexSequence type;
+};
+
+template <class A, class B>
+struct ConcatIndexSequence;
+
+template <uint16_t... I, uint16_t... J>
+struct ConcatIndexSequence<IndexSequence<I...>, IndexSequence<J...> > {
+    typedef IndexSequence<I..., (sizeof...(I) + J)...> type;
+};
+
+/**
+ * @struct MakeIndexSequence
+ * @brief \ref IndexSequence of \c N indexes, built by halves (the template depth is \c log2(N)).
+ */
+template <uint16_t N>
+struct MakeIndexSequence {
+    typedef typename ConcatIndexSequence<typename MakeIndexSequence<N / 2>::type,
+                                         typename MakeIndexSequence<N - (N / 2)>::type>::type type;
+};
+
+template <>
+struct MakeIndexSequence<0> {
+    typedef IndexSequence<> type;
+};
+
+template <>
+struct MakeIndexSequence<1> {
+    typedef IndexSequence<0> type;
+};
+
+template <class SEQUENCE>
+struct UvIndexTable;
+
+/**
+ * @struct UvIndexTable
+ * @brief UV index of every ADC code, generated at compile time from \ref UV_INDEX_MV and \ref UV_ADC_VREF_MV and
+ * stored in flash.
+ */
+template <uint16_t... CODE>
+struct UvIndexTable<IndexSequence<CODE...> > {
+    static constexpr uint8_t values[sizeof...(CODE)] PROGMEM = { uvIndexOfMv(adcCodeToMv(CODE))... };
+};
+
+template <uint16_t... CODE>
+constexpr uint8_t UvIndexTable<IndexSequence<CODE...> >::values[sizeof...(CODE)] PROGMEM;
+
+typedef UvIndexTable<MakeIndexSequence<UV_ADC_CODES>::type> UvIndexLookup;
+
+static_assert(sizeof(UvIndexLookup::values) == UV_ADC_CODES, "UV table must cover every ADC code");
+static_assert(UvIndexLookup::values[0] == 0, "UV table: code 0 must be index 0");
+static_assert(UvIndexLookup::values[UV_ADC_CODES - 1] == 12, "UV table: full scale must be index 12");
+
+/**
+ * @fn    uvIndexOfAdc
+ * @brief UV index of an ADC code (\ref ADC_BITS bits, larger codes are clamped): a single load from flash.
+ */
+inline uint8_t uvIndexOfAdc(uint16_t code) {
+    return pgm_read_byte(&UvIndexLookup::values[(code < UV_ADC_CODES) ? code : (UV_ADC_CODES - 1)]);
+}
+
+#endif // __ATS_01_UV_H__
@@ -0,0 +1,124 @@
+/**
+ * @file Arduino.h
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief Arduino API subset of the native (host) build of the station.
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#ifndef __NATIVE_ARDUINO_H__
+#define __NATIVE_ARDUINO_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*********************************************
+ *          PROGRAM MEMORY (one address space)
+ ********************************************/
+#define PROGMEM
+#define PSTR(s)                         (s)
+#define pgm_read_byte(addr)             (*(const uint8_t*) (addr))
+#define pgm_read_word(addr)             (*(const uint16_t*) (addr))
+#define memcpy_P                        memcpy
+#define strcmp_P                        strcmp
+#define strncmp_P                       strncmp
+#define strlen_P                        strlen
+typedef const char* PGM_P;
+
+class __FlashStringHelper;
+#define F(s)                            (reinterpret_cast<const __FlashStringHelper*>(s))
+
+/*********************************************
+ *        PINS (Arduino Pro Mini numbering)
+ ********************************************/
+#define HIGH                            1
+#define LOW                             0
+#define INPUT                           0
+#define OUTPUT                          1
+#define INPUT_PULLUP                    2
+#define LED_BUILTIN                     13
+#define A0                              14
+#define A1                              15
+#define A2                              16
+#define A3                              17
+#define NOT_AN_INTERRUPT                -1
+#define digitalPinToInterrupt(p)        ((p) == 2 ? 0 : ((p) == 3 ? 1 : NOT_AN_INTERRUPT))
+
+/**
+ * @fn    millis
+ * @brief Time since start (in ms). The native build has no timer: it is defined by the application from its
+ * simulated clock (see \c ats_01_hal.h).
+ */
+unsigned long millis();
+
+/**
+ * @fn    micros
+ * @brief Time since start (in us), defined by the application like \ref millis().
+ */
+unsigned long micros();
+
+/**
+ * @fn    yield
+ * @brief Called by busy waits, defined by the application like \ref millis() (the simulated time must go on).
+ */
+void yield();
+
+/** Sketch entry points. */
+void setup();
+void loop();
+
+/**
+ * @class Print
+ * @brief Text and byte output of the Arduino core: a port only implements \c write(uint8_t).
+ */
+class Print {
+    private:
+        size_t printNumber(unsigned long value, uint8_t base);
+
+    public:
+        virtual ~Print() { }
+        virtual size_t write(uint8_t value) = 0;
+        virtual size_t write(const uint8_t* buffer, size_t size);
+        size_t write(const char* str) { return (str == NULL) ? 0 : write((const uint8_t*) str, strlen(str)); }
+        virtual int availableForWrite() { return 0; }
+        virtual void flush() { }
+
+        size_t print(const __FlashStringHelper* str) { return write(reinterpret_cast<const char*>(str)); }
+        size_t print(const char* str) { return write(str); }
+        size_t print(char c) { return write((uint8_t) c); }
+        size_t print(unsigned char value, int base = 10) { return print((unsigned long) value, base); }
+        size_t print(int value, int base = 10) { return print((long) value, base); }
+        size_t print(unsigned int value, int base = 10) { return print((unsigned long) value, base); }
+        size_t print(long value, int base = 10);
+        size_t print(unsigned long value, int base = 10) { return printNumber(value, (uint8_t) base); }
+        size_t print(double value, int digits = 2);
+
+        size_t println() { return write("\r\n"); }
+        template <typename T>
+        size_t println(T value) { return print(value) + println(); }
+        template <typename T>
+        size_t println(T value, int format) { return print(value, format) + println(); }
+};
+
+/**
+ * @class Stream
+ * @brief Byte input of the Arduino core (only the calls used by the station).
+ */
+class Stream : public Print {
+    public:
+        virtual int available() = 0;
+        virtual int read() = 0;
+        virtual int peek() = 0;
+};
+
+#endif // __NATIVE_ARDUINO_H__
@@ -0,0 +1,89 @@
+/**
+ * @file Print.cpp
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief Number formatting of the native \c Print class.
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#include "Arduino.h"
+
+/**
+ * @fn Print::write(const uint8_t* buffer, size_t size)
+ * @brief Write \p size bytes one by one.
+ */
+size_t Print::write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while (size-- > 0) {
+        n += write(*buffer++);
+    }
+    return n;
+}
+
+/**
+ * @fn Print::printNumber(unsigned long value, uint8_t base)
+ * @brief Write \p value in \p base (2 .. 16, 10 otherwise).
+ */
+size_t Print::printNumber(unsigned long value, uint8_t base) {
+    char digits[8 * sizeof(unsigned long) + 1];
+    char* str = &digits[sizeof(digits) - 1];
+    *str = '\0';
+    if ((base < 2) || (base > 16)) {
+        base = 10;
+    }
+    do {
+        uint8_t digit = (uint8_t) (value % base);
+        value /= base;
+        *--str = (char) ((digit < 10) ? ('0' + digit) : ('A' + digit - 10));
+    } while (value > 0);
+    return write(str);
+}
+
+/**
+ * @fn Print::print(long value, int base)
+ * @brief Write \p value (with its sign in base 10).
+ */
+size_t Print::print(long value, int base) {
+    if ((base == 10) && (value < 0)) {
+        return print('-') + printNumber(0UL - (unsigned long) value, 10);
+    }
+    return printNumber((unsigned long) value, (uint8_t) base);
+}
+
+/**
+ * @fn Print::print(double value, int digits)
+ * @brief Write \p value with \p digits decimals.
+ */
+size_t Print::print(double value, int digits) {
+    size_t n = 0;
+    if (value < 0.0) {
+        n += print('-');
+        value = -value;
+    }
+    double rounding = 0.5;
+    for (int i = 0; i < digits; i++) {
+        rounding /= 10.0;
+    }
+    value += rounding;
+    unsigned long integer = (unsigned long) value;
+    double remainder = value - (double) integer;
+    n += printNumber(integer, 10);
+    if (digits > 0) {
+        n += print('.');
+    }
+    while (digits-- > 0) {
+        remainder *= 10.0;
+        uint8_t digit = (uint8_t) remainder;
+        n += print((char) ('0' + digit));
+        remainder -= digit;
+    }
+    return n;
+}
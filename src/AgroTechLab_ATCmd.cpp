@@ -0,0 +1,143 @@
+/**
+ * @file AgroTechLab_ATCmd.cpp
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief AgroTechLab AT command builder.
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#include <AgroTechLab_ATCmd.h>
+
+/**
+ * @fn ATCmd::ATCmd()
+ * @brief Constructor of ATCmd class (empty command).
+ */
+ATCmd::ATCmd() {
+    buf[0] = '\0';
+}
+
+/**
+ * @fn ATCmd::put(char c)
+ * @brief Append one character keeping the buffer always terminated.
+ * @param[in] c - character to append.
+ * @return ATCmd& - the builder itself.
+ */
+ATCmd& ATCmd::put(char c) {
+    if (len < (AT_CMD_BUFFER_SIZE - 1)) {
+        buf[len++] = c;
+        buf[len] = '\0';
+    } else {
+        overflowed = true;
+    }
+    return *this;
+}
+
+/**
+ * @fn ATCmd::begin(const __FlashStringHelper* prefix)
+ * @brief Discard the current command and start a new one.
+ * @param[in] prefix - command prefix stored in flash (ex.: <tt>F("AT+DR=")</tt>).
+ * @return ATCmd& - the builder itself.
+ */
+ATCmd& ATCmd::begin(const __FlashStringHelper* prefix) {
+    len = 0;
+    overflowed = false;
+    buf[0] = '\0';
+    return append(prefix);
+}
+
+/**
+ * @fn ATCmd::append(const char* str)
+ * @brief Append a string stored in RAM.
+ * @param[in] str - string to append (NULL is ignored).
+ * @return ATCmd& - the builder itself.
+ */
+ATCmd& ATCmd::append(const char* str) {
+    if (str != NULL) {
+        while (*str != '\0') {
+            put(*str++);
+        }
+    }
+    return *this;
+}
+
+/**
+ * @fn ATCmd::append(const __FlashStringHelper* str)
+ * @brief Append a string stored in flash.
+ * @param[in] str - string to append (NULL is ignored).
+ * @return ATCmd& - the builder itself.
+ */
+ATCmd& ATCmd::append(const __FlashStringHelper* str) {
+    if (str != NULL) {
+        PGM_P p = reinterpret_cast<PGM_P>(str);
+        char c;
+        while ((c = pgm_read_byte(p++)) != '\0') {
+            put(c);
+        }
+    }
+    return *this;
+}
+
+/**
+ * @fn ATCmd::append(char c)
+ * @brief Append a single character.
+ * @param[in] c - character to append.
+ * @return ATCmd& - the builder itself.
+ */
+ATCmd& ATCmd::append(char c) {
+    return put(c);
+}
+
+/**
+ * @fn ATCmd::appendUInt(uint16_t value)
+ * @brief Append an unsigned integer in decimal format.
+ * @param[in] value - value to append.
+ * @return ATCmd& - the builder itself.
+ */
+ATCmd& ATCmd::appendUInt(uint16_t value) {
+    char digits[5];
+    uint8_t n = 0;
+    do {
+        digits[n++] = '0' + (value % 10);
+        value /= 10;
+    } while (value > 0);
+    while (n > 0) {
+        put(digits[--n]);
+    }
+    return *this;
+}
+
+/**
+ * @fn ATCmd::appendQuoted(const char* str)
+ * @brief Append a string argument between double quotes.
+ * @param[in] str - string to append.
+ * @return ATCmd& - the builder itself.
+ */
+ATCmd& ATCmd::appendQuoted(const char* str) {
+    put('"');
+    append(str);
+    return put('"');
+}
+
+/**
+ * @fn ATCmd::appendHex(const uint8_t* data, uint8_t size)
+ * @brief Append binary data as uppercase hexadecimal digits (two per byte).
+ * @param[in] data - data to append.
+ * @param[in] size - data size (in bytes).
+ * @return ATCmd& - the builder itself.
+ */
+ATCmd& ATCmd::appendHex(const uint8_t* data, uint8_t size) {
+    static const char hexDigits[] PROGMEM = "0123456789ABCDEF";
+    for (uint8_t i = 0; i < size; i++) {
+        put(pgm_read_byte(&hexDigits[data[i] >> 4]));
+        put(pgm_read_byte(&hexDigits[data[i] & 0x0F]));
+    }
+    return *this;
+}
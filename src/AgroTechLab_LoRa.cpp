@@ -17,768 +17,795 @@
 #include <AgroTechLab_LoRa.h>
 
 /**
- * @fn LoRa::LoRa(LoRaConfig_t lora_config)
+ * @fn LoRa::LoRa(Stream& modemSerial, Print& debugOutput)
  * @brief Constructor of LoRa class.
+ * @param[in] modemSerial - serial port connected to LoRa modem (any \c Stream, ex.: \ref AvrUart).
+ * @param[in] debugOutput - output of the debug messages (only used when \ref LoRaConfig_t::debug is set).
  */
-//LoRa::LoRa() { }
+LoRa::LoRa(Stream& modemSerial, Print& debugOutput) : modem(modemSerial), debugOut(debugOutput) { }
 
 /**
- * @fn LoRa::initModem()
- * @brief Initialize LoRa modem.
- * @param[in] lora_config - struct with LoRa configuration (see \ref LoRaConfig_t).
+ * @fn LoRa::initModem(const LoRaConfig_t& loraConfig)
+ * @brief Initialize LoRa modem. Every command waits only for its own reply line (see \ref runCmd()), so the whole
+ * configuration takes a few ms per command.
+ * @param[in] loraConfig - struct with LoRa configuration (see \ref LoRaConfig_t).
  * @retval true - successful initialization.
- * @retval false - initialization fail.
+ * @retval false - initialization fail (a command was rejected or not answered, or a transmission is in progress).
  */
-bool LoRa::initModem(LoRaConfig_t loraConfig) {
+bool LoRa::initModem(const LoRaConfig_t& loraConfig) {
 
-    String at_cmd;
+    ATCmd at_cmd;
 
-    // Configure UART communication between MCU and LoRa module LoRa modem
-    if (loraConfig.debug) {
-        Serial.print("\nInitiating UART port between MCU device and LoRa modem... ");
-        Serial.flush();
-    }
-    
-    // Initiate Serial1
-    // Serial1.begin(9600);
-
-    // Wait for serial port to connect
-    // while (!Serial1) {;}
-    
-    if (loraConfig.debug) {
-        Serial.print("[OK]");
-        Serial.flush();
+    if (isBusy()) {
+        return false;
     }
+    debug = loraConfig.debug;
+    modemDrKnown = false;
 
     // Test UART communication
-    if (loraConfig.debug) {
-        Serial.print("\nTesting UART communciation between MCU and LoRa modem... ");
-        Serial.flush();
-    }
-    // Serial1.println("AT");
-    // loraReturn = Serial1.readString();
-    if (strcmp((char*)loraReturn.c_str(), "+AT: OK\r\n") != 0) {
-        if (loraConfig.debug) {
-            Serial.print("[ERROR]\n\t");
-            Serial.print(loraReturn);
-            Serial.flush();
-        }
+    at_cmd.begin(F("AT"));
+    if (!runCmd(F("\nTesting UART communciation between MCU and LoRa modem... "), at_cmd)) {
         return false;
-    } else {
-        if (loraConfig.debug) {
-            Serial.print("[OK]");
-            Serial.flush();
-        }    
     }
 
     // Get LoRa modem firmware version
-    if (loraConfig.debug) {
-        Serial.print("\nGetting LoRa modem firmware version...");
-        Serial.flush();
-    }
-    loraReturn = "";
-    // Serial1.println("AT+VER");
-    // loraReturn = Serial1.readString();
-    if (loraConfig.debug) {
-        Serial.print("\n\t");
-        Serial.print(loraReturn);
-        Serial.flush();
-    }    
+    at_cmd.begin(F("AT+VER"));
+    if (!runCmd(F("\nGetting LoRa modem firmware version..."), at_cmd)) {
+        return false;
+    }
 
     // Set LoRa base band
-    if (loraConfig.debug) {
-        Serial.print("\nSetting LoRa base band... ");
-        Serial.flush();
-    }
-    loraReturn = "";
-    at_cmd = "AT+DR=";
-    at_cmd.concat(loraBand_toString(loraConfig.band));
-    // Serial1.println(at_cmd);
-    // loraReturn = Serial1.readString();
-    if (loraConfig.debug) {
-        Serial.print("\n\t");
-        Serial.print(loraReturn);
-        Serial.flush();         
+    at_cmd.begin(F("AT+DR=")).append(loraBand_toString(loraConfig.band));
+    if (!runCmd(F("\nSetting LoRa base band... "), at_cmd)) {
+        return false;
     }
 
     // Set LoRa class
-    if (loraConfig.debug) {
-        Serial.print("\nSetting LoRa class... ");
-        Serial.flush();
-    }
-    loraReturn = "";
-    at_cmd = "AT+CLASS=";
-    at_cmd.concat(loraOpClass_toString(loraConfig.op_class));
-    // Serial1.println(at_cmd);
-    // loraReturn = Serial1.readString();
-    if (loraConfig.debug) {
-        Serial.print("\n\t");
-        Serial.print(loraReturn);
-        Serial.flush();        
+    at_cmd.begin(F("AT+CLASS=")).append(loraOpClass_toString(loraConfig.op_class));
+    if (!runCmd(F("\nSetting LoRa class... "), at_cmd)) {
+        return false;
     }
 
     // Set LoRa transmission power
-    if (loraConfig.debug) {
-        Serial.print("\nSetting LoRa transmission power... ");
-        Serial.flush();
-    }
-    loraReturn = "";
-    at_cmd = "AT+POWER=";
-    at_cmd.concat(loraTxPower_toString(loraConfig.tx_power));
-    // Serial1.println(at_cmd);
-    // loraReturn = Serial1.readString();
-    if (loraConfig.debug) {
-        Serial.print("\n\t");
-        Serial.print(loraReturn);
-        Serial.flush();        
+    at_cmd.begin(F("AT+POWER=")).append(loraTxPower_toString(loraConfig.tx_power));
+    if (!runCmd(F("\nSetting LoRa transmission power... "), at_cmd)) {
+        return false;
     }
 
     // Set LoRa uplink datarate
-    if (loraConfig.debug) {
-        Serial.print("\nSetting LoRa uplink datarate... ");
-        Serial.flush();
-    }
-    loraReturn = "";
-    at_cmd = "AT+DR=";
-    at_cmd.concat(loraDR_toString(loraConfig.uplink_dr));
-    // Serial1.println(at_cmd);
-    // loraReturn = Serial1.readString();
-    if (loraConfig.debug) {
-        Serial.print("\n\t");
-        Serial.print(loraReturn);
-        Serial.flush();        
+    at_cmd.begin(F("AT+DR=")).append(loraDR_toString(loraConfig.uplink_dr));
+    if (!runCmd(F("\nSetting LoRa uplink datarate... "), at_cmd)) {
+        return false;
     }
+    modemDr = loraConfig.uplink_dr;
+    modemDrKnown = true;
 
     // Set LoRa channel 0 configuration
-    if (loraConfig.debug) {
-        Serial.print("\nSetting LoRa channel 0 configuration... ");
-        Serial.flush();
-    }
-    loraReturn = "";
-    at_cmd = "AT+CH=0,";
-    at_cmd.concat(loraConfig.chan0_freq);
-    at_cmd.concat(",");
-    at_cmd.concat(loraDR_toString(loraConfig.chan0_dr));
-    // Serial1.println(at_cmd);
-    // loraReturn = Serial1.readString();
-    if (loraConfig.debug) {
-        Serial.print("\n\t");
-        Serial.print(loraReturn);
-        Serial.flush();        
+    at_cmd.begin(F("AT+CH=0,")).append(loraConfig.chan0_freq).append(',').append(loraDR_toString(loraConfig.chan0_dr));
+    if (!runCmd(F("\nSetting LoRa channel 0 configuration... "), at_cmd)) {
+        return false;
     }
 
     // Set LoRa channel 1 configuration
-    if (loraConfig.debug) {
-        Serial.print("\nSetting LoRa channel 1 configuration... ");
-        Serial.flush();
-    }
-    loraReturn = "";
-    at_cmd = "AT+CH=1,";
-    at_cmd.concat(loraConfig.chan1_freq);
-    at_cmd.concat(",");
-    at_cmd.concat(loraDR_toString(loraConfig.chan1_dr));
-    // Serial1.println(at_cmd);
-    // loraReturn = Serial1.readString();
-    if (loraConfig.debug) {
-        Serial.print("\n\t");
-        Serial.print(loraReturn);
-        Serial.flush();        
+    at_cmd.begin(F("AT+CH=1,")).append(loraConfig.chan1_freq).append(',').append(loraDR_toString(loraConfig.chan1_dr));
+    if (!runCmd(F("\nSetting LoRa channel 1 configuration... "), at_cmd)) {
+        return false;
     }
 
     // Set LoRa RX window 2
-    if (loraConfig.debug) {
-        Serial.print("\nSetting LoRa RX window 2... ");
-        Serial.flush();
-    }
-    loraReturn = "";
-    at_cmd = "AT+RXWIN2=";
-    at_cmd.concat(loraConfig.rxwin2_freq);
-    at_cmd.concat(",");
-    at_cmd.concat(loraDR_toString(loraConfig.rxwin2_dr));
-    // Serial1.println(at_cmd);
-    // loraReturn = Serial1.readString();
-    if (loraConfig.debug) {
-        Serial.print("\n\t");
-        Serial.print(loraReturn);
-        Serial.flush();        
+    at_cmd.begin(F("AT+RXWIN2=")).append(loraConfig.rxwin2_freq).append(',').append(loraDR_toString(loraConfig.rxwin2_dr));
+    if (!runCmd(F("\nSetting LoRa RX window 2... "), at_cmd)) {
+        return false;
     }
 
     // Set LoRa ADR (Automatic Datarate)
-    if (loraConfig.debug) {
-        Serial.print("\nSetting LoRa ADR... ");
-        Serial.flush();
-    }
-    loraReturn = "";
-    at_cmd = "AT+ADR=";
-    at_cmd.concat(loraBool_toString(loraConfig.adr));
-    // Serial1.println(at_cmd);
-    // loraReturn = Serial1.readString();
-    if (loraConfig.debug) {
-        Serial.print("\n\t");
-        Serial.print(loraReturn);
-        Serial.flush();        
+    at_cmd.begin(F("AT+ADR=")).append(loraBool_toString(loraConfig.adr));
+    if (!runCmd(F("\nSetting LoRa ADR... "), at_cmd)) {
+        return false;
     }
 
     // Set LoRa DevEUI
-    if (loraConfig.debug) {
-        Serial.print("\nSetting LoRa DevEUI... ");
-        Serial.flush();
-    }
-    loraReturn = "";
-    at_cmd = "AT+ID=DevEui,\"";
-    at_cmd.concat(loraConfig.dev_eui);
-    at_cmd.concat("\"");
-    // Serial1.println(at_cmd);
-    // loraReturn = Serial1.readString();
-    if (loraConfig.debug) {
-        Serial.print("\n\t");
-        Serial.print(loraReturn);
-        Serial.flush();        
+    at_cmd.begin(F("AT+ID=DevEui,")).appendQuoted(loraConfig.dev_eui);
+    if (!runCmd(F("\nSetting LoRa DevEUI... "), at_cmd)) {
+        return false;
     }
 
     // Set LoRa AppEUI
-    if (loraConfig.debug) {
-        Serial.print("\nSetting LoRa AppEUI... ");
-        Serial.flush();
-    }
-    loraReturn = "";
-    at_cmd = "AT+ID=AppEui,\"";
-    at_cmd.concat(loraConfig.app_eui);
-    at_cmd.concat("\"");
-    // Serial1.println(at_cmd);
-    // loraReturn = Serial1.readString();
-    if (loraConfig.debug) {
-        Serial.print("\n\t");
-        Serial.print(loraReturn);
-        Serial.flush();        
+    at_cmd.begin(F("AT+ID=AppEui,")).appendQuoted(loraConfig.app_eui);
+    if (!runCmd(F("\nSetting LoRa AppEUI... "), at_cmd)) {
+        return false;
     }
 
     // // Set LoRa unconfirmed message repeats time
-    // if (loraConfig.debug) {
-    //     Serial.print("\nSetting LoRa unconfirmed message repeats time... ");
-    //     Serial.flush();
-    // }
-    // loraReturn = "";
-    // at_cmd = "AT+REPT=";
-    // at_cmd.concat(loraConfig.repeat);
-    // Serial1.println(at_cmd);
-    // loraReturn = Serial1.readString();
-    // if (loraConfig.debug) {
-    //     Serial.print("\n\t");
-    //     Serial.print(loraReturn);
-    //     Serial.flush();        
+    // at_cmd.begin(F("AT+REPT=")).append(loraConfig.repeat);
+    // if (!runCmd(F("\nSetting LoRa unconfirmed message repeats time... "), at_cmd)) {
+    //     return false;
     // }
 
     // Set LoRa confirmed message retry times
-    if (loraConfig.debug) {
-        Serial.print("\nSetting LoRa confirmed message retry times... ");
-        Serial.flush();
-    }
-    loraReturn = "";
-    at_cmd = "AT+RETRY=";
-    at_cmd.concat(loraConfig.retry);
-    // Serial1.println(at_cmd);
-    // loraReturn = Serial1.readString();
-    if (loraConfig.debug) {
-        Serial.print("\n\t");
-        Serial.print(loraReturn);
-        Serial.flush();        
+    at_cmd.begin(F("AT+RETRY=")).append(loraConfig.retry);
+    if (!runCmd(F("\nSetting LoRa confirmed message retry times... "), at_cmd)) {
+        return false;
     }
 
     // Set LoRa authentication mode
-    if (loraConfig.debug) {
-        Serial.print("\nSetting LoRa authentication mode... ");
-        Serial.flush();
-    }
-    loraReturn = "";
-    at_cmd = "AT+MODE=";
-    at_cmd.concat(loraAuthMode_toString(loraConfig.auth_mode));
-    // Serial1.println(at_cmd);
-    // loraReturn = Serial1.readString();
-    if (loraConfig.debug) {
-        Serial.print("\n\t");
-        Serial.print(loraReturn);
-        Serial.flush();        
+    at_cmd.begin(F("AT+MODE=")).append(loraAuthMode_toString(loraConfig.auth_mode));
+    if (!runCmd(F("\nSetting LoRa authentication mode... "), at_cmd)) {
+        return false;
     }
 
     // Set another LoRa parameters based on authentication mode
     // Authentication LWABP
-    if (loraAuthMode_toString(loraConfig.auth_mode).compareTo("LWABP") == 0) {
-        
+    if (loraConfig.auth_mode == LWABP) {
+
         // Set LoRa device address
-        if (loraConfig.debug) {
-            Serial.print("\nSetting LoRa device address... ");
-            Serial.flush();
-        }
-        loraReturn = "";
-        at_cmd = "AT+ID=DevAddr,\"";
-        at_cmd.concat(loraConfig.dev_addr);
-        at_cmd.concat("\"");
-        // Serial1.println(at_cmd);
-        // loraReturn = Serial1.readString();
-        if (loraConfig.debug) {
-            Serial.print("\n\t");
-            Serial.print(loraReturn);
-            Serial.flush();        
+        at_cmd.begin(F("AT+ID=DevAddr,")).appendQuoted(loraConfig.dev_addr);
+        if (!runCmd(F("\nSetting LoRa device address... "), at_cmd)) {
+            return false;
         }
 
         // Set LoRa network session key
-        if (loraConfig.debug) {
-            Serial.print("\nSetting LoRa network session key... ");
-            Serial.flush();
-        }
-        loraReturn = "";
-        at_cmd = "AT+KEY=NwkSKey,\"";
-        at_cmd.concat(loraConfig.nwks_key);
-        at_cmd.concat("\"");
-        // Serial1.println(at_cmd);
-        // loraReturn = Serial1.readString();
-        if (loraConfig.debug) {
-            Serial.print("\n\t");
-            Serial.print(loraReturn);
-            Serial.flush();        
+        at_cmd.begin(F("AT+KEY=NwkSKey,")).appendQuoted(loraConfig.nwks_key);
+        if (!runCmd(F("\nSetting LoRa network session key... "), at_cmd)) {
+            return false;
         }
 
         // Set LoRa application session key
-        if (loraConfig.debug) {
-            Serial.print("\nSetting LoRa application session key... ");
-            Serial.flush();
-        }
-        loraReturn = "";
-        at_cmd = "AT+KEY=AppSKey,\"";
-        at_cmd.concat(loraConfig.apps_key);
-        at_cmd.concat("\"");
-        // Serial1.println(at_cmd);
-        // loraReturn = Serial1.readString();
-        if (loraConfig.debug) {
-            Serial.print("\n\t");
-            Serial.print(loraReturn);
-            Serial.flush();        
+        at_cmd.begin(F("AT+KEY=AppSKey,")).appendQuoted(loraConfig.apps_key);
+        if (!runCmd(F("\nSetting LoRa application session key... "), at_cmd)) {
+            return false;
         }
 
     } else {
         // Authentication OTAA
         // Set LoRa application key
-        if (loraConfig.debug) {
-            Serial.print("\nSetting LoRa application key... ");
-            Serial.flush();
-        }
-        loraReturn = "";
-        at_cmd = "AT+KEY=AppKey,\"";
-        at_cmd.concat(loraConfig.app_key);
-        at_cmd.concat("\"");
-        // Serial1.println(at_cmd);
-        // loraReturn = Serial1.readString();
-        if (loraConfig.debug) {
-            Serial.print("\n\t");
-            Serial.print(loraReturn);
-            Serial.flush();        
+        at_cmd.begin(F("AT+KEY=AppKey,")).appendQuoted(loraConfig.app_key);
+        if (!runCmd(F("\nSetting LoRa application key... "), at_cmd)) {
+            return false;
         }
 
-        // Join to the LoRa network
+        // Join to the LoRa network (completion is reported by poll())
         if (loraConfig.debug) {
-            Serial.print("\nJoining... ");
-            Serial.flush();
+            debugOut.print("\nJoining... ");
+            debugOut.flush();
         }
-        loraReturn = "";
-        at_cmd = "AT+Join";
-        loraBusy = true;
-        // Serial1.println(at_cmd);
-        // loraReturn = Serial1.readString();
-        do {
-            // while (Serial1.available()) {
-            //     loraReturn = Serial1.readString();
-            //     if (loraConfig.debug) {
-            //         Serial.print("\n");
-            //         Serial.print(loraReturn);
-            //         Serial.flush();        
-            //     }
-            //     char str[30];
-            //     loraReturn.toCharArray(str, sizeof(str), 0);
-            //     if (strstr(str, "Done")) {
-            //         loraBusy = false;
-            //     }
-            // }  
-        } while (loraBusy);
-
+        return startJoin(loraConfig);
     }
 
     // Return success initialization
     return true;
 }
 
+/**
+ * @fn LoRa::runCmd(const __FlashStringHelper* label, const ATCmd& at_cmd, unsigned long timeout)
+ * @brief Send a configuration command and wait for its reply: the first line tagged with the command name
+ * (<tt>+NAME: ...</tt> for <tt>AT+NAME=...</tt>) ended by the line terminator. Other lines, such as the second line
+ * of a data rate reply, are skipped. Unlike \c Stream::readString(), it returns as soon as the reply is complete,
+ * and gives up after \p timeout. In debug mode \p label, the reply and the command latency are printed.
+ * @param[in] label - debug message of the command.
+ * @param[in] at_cmd - command (without line terminator).
+ * @param[in] timeout - maximum time waiting for the reply (in ms).
+ * @retval true - reply received and it is not an error.
+ * @retval false - error reply or timeout.
+ */
+bool LoRa::runCmd(const __FlashStringHelper* label, const ATCmd& at_cmd, unsigned long timeout) {
+    if (debug) {
+        debugOut.print(label);
+        debugOut.print(F("\n\t"));
+    }
+
+    // Drop replies left by a previous command
+    while (modem.available() > 0) {
+        char c = (char) modem.read();
+        if (debug && (c != '\r') && (c != '\n')) {
+            debugOut.write(c);
+        }
+        parser.feed(c);
+    }
+
+    // Reply tag: the command name (a bare "AT" is answered by "+AT: OK")
+    const char* name = at_cmd.c_str();
+    uint8_t nameLen = 0;
+    if (strncmp_P(name, PSTR("AT+"), 3) == 0) {
+        name += 3;
+    }
+    while ((name[nameLen] != '\0') && (name[nameLen] != '=') && (name[nameLen] != '?')) {
+        nameLen++;
+    }
+
+    modem.println(at_cmd.c_str());
+    unsigned long start = millis();
+    bool replied = false;
+    bool accepted = false;
+    while (!replied && ((millis() - start) <= timeout)) {
+        if (modem.available() <= 0) {
+            yield();
+            continue;
+        }
+        while (modem.available() > 0) {
+            char c = (char) modem.read();
+            if (debug && (c != '\r') && (c != '\n')) {
+                debugOut.write(c);
+            }
+            if (parser.feed(c) && parser.isTag(name, nameLen)) {
+                replied = true;
+                accepted = parser.event().type != MODEM_EVENT_ERROR;
+                break;
+            }
+        }
+    }
+    cmdLatency = millis() - start;
+
+    if (debug) {
+        if (!replied) {
+            debugOut.print(F("[TIMEOUT]"));
+        }
+        debugOut.print(F(" ("));
+        debugOut.print(cmdLatency);
+        debugOut.print(F(" ms)"));
+        debugOut.flush();
+    }
+    return accepted;
+}
+
 /**
  * @fn loraBand_toString(LoRaBand_e loraBand)
- * @brief Convert LoRa band enum to String.
+ * @brief Convert LoRa band enum to flash string.
  * @param[in] lora_band - LoRa port used to send message.
- * @return String - LoRa band string.
+ * @return const __FlashStringHelper* - LoRa band string.
  */ 
-String LoRa::loraBand_toString(LoRaBand_e loraBand) {
+const __FlashStringHelper* LoRa::loraBand_toString(LoRaBand_e loraBand) {
     switch (loraBand) {
         case EU868:
-            return "EU868";
+            return F("EU868");
         case US915:
-            return "US915";
+            return F("US915");
         case AU920:
-            return "AU920";
+            return F("AU920");
         default:
-            return "ERROR";
+            return F("ERROR");
     }
 }
 
 /**
  * @fn loraOpClass_toString(LoRaOpClass_e loraOpClass)
- * @brief Convert LoRa operation class enum to String.
+ * @brief Convert LoRa operation class enum to flash string.
  * @param[in] lora_class - LoRa operation class enum.
- * @return String - LoRa class operation string.
+ * @return const __FlashStringHelper* - LoRa class operation string.
  */ 
-String LoRa::loraOpClass_toString(LoRaOpClass_e loraOpClass) {
+const __FlashStringHelper* LoRa::loraOpClass_toString(LoRaOpClass_e loraOpClass) {
     switch (loraOpClass) {
         case A:
-            return "A";
+            return F("A");
         case C:
-            return "C";
+            return F("C");
         default:
-            return "ERROR";
+            return F("ERROR");
     }
 }
 
 /**
  * @fn loraTxPower_toString(LoRaTxPower_e loraTxPower)
- * @brief Convert LoRa transmission power enum to String.
+ * @brief Convert LoRa transmission power enum to flash string.
  * @param[in] loraTxPower - LoRa transmission power enum.
- * @return String - LoRa transmission power string.
+ * @return const __FlashStringHelper* - LoRa transmission power string.
  */ 
-String LoRa::loraTxPower_toString(LoRaTxPower_e loraTxPower) {
+const __FlashStringHelper* LoRa::loraTxPower_toString(LoRaTxPower_e loraTxPower) {
     switch (loraTxPower) {
         case dBm30:
-            return "30";
+            return F("30");
         case dBm28:
-            return "28";
+            return F("28");
         case dBm26:
-            return "26";
+            return F("26");
         case dBm24:
-            return "24";
+            return F("24");
         case dBm22:
-            return "22";
+            return F("22");
         case dBm20:
-            return "20";
+            return F("20");
         case dBm18:
-            return "18";
+            return F("18");
         case dBm16:
-            return "16";
+            return F("16");
         case dBm14:
-            return "14";
+            return F("14");
         case dBm12:
-            return "12";
+            return F("12");
         case dBm10:
-            return "10";
+            return F("10");
         default:
-            return "ERROR";
+            return F("ERROR");
     }
 }
 
 
 /**
  * @fn loraDR_toString(LoRaDR_e loraDR)
- * @brief Convert LoRa datarate enum to String.
+ * @brief Convert LoRa datarate enum to flash string.
  * @param[in] loraDR - LoRa datarate enum.
- * @return String - LoRa datarate string.
+ * @return const __FlashStringHelper* - LoRa datarate string.
  */ 
-String LoRa::loraDR_toString(LoRaDR_e loraDR) {
+const __FlashStringHelper* LoRa::loraDR_toString(LoRaDR_e loraDR) {
     switch (loraDR) {
         case DR0:
-            return "DR0";
+            return F("DR0");
         case DR1:
-            return "DR1";
+            return F("DR1");
         case DR2:
-            return "DR2";
+            return F("DR2");
         case DR3:
-            return "DR3";
+            return F("DR3");
         case DR4:
-            return "DR4";
+            return F("DR4");
         case DR5:
-            return "DR5";
+            return F("DR5");
         case DR6:
-            return "DR6";
+            return F("DR6");
         case DR7:
-            return "DR7";
+            return F("DR7");
         case DR8:
-            return "DR8";
+            return F("DR8");
         case DR9:
-            return "DR9";
+            return F("DR9");
         case DR10:
-            return "DR10";
+            return F("DR10");
         case DR11:
-            return "DR11";
+            return F("DR11");
         case DR12:
-            return "DR12";
+            return F("DR12");
         case DR13:
-            return "DR13";
+            return F("DR13");
         case DR14:
-            return "DR14";
+            return F("DR14");
         case DR15:
-            return "DR15";
+            return F("DR15");
         default:
-            return "ERROR";
+            return F("ERROR");
     }
 }
 
 /**
  * @fn loraBool_toString(LoRaBool_e loraBool)
- * @brief Convert LoRa boolean enum to String.
+ * @brief Convert LoRa boolean enum to flash string.
  * @param[in] loraBool - LoRa boolean enum.
- * @return String - LoRa boolean string.
+ * @return const __FlashStringHelper* - LoRa boolean string.
  */ 
-String LoRa::loraBool_toString(LoRaBool_e loraBool) {
+const __FlashStringHelper* LoRa::loraBool_toString(LoRaBool_e loraBool) {
     switch (loraBool) {
         case ON:
-            return "ON";
+            return F("ON");
         case OFF:
-            return "OFF";
+            return F("OFF");
         default:
-            return "ERROR";
+            return F("ERROR");
     }
 }
 
 /**
  * @fn loraAuthMode_toString(LoRaAuthMode_e loraAuthMode)
- * @brief Convert LoRa authentication mode enum to String.
+ * @brief Convert LoRa authentication mode enum to flash string.
  * @param[in] loraAuthMode - LoRa authentication mode enum.
- * @return String - LoRa authentication mode string.
+ * @return const __FlashStringHelper* - LoRa authentication mode string.
  */ 
-String LoRa::loraAuthMode_toString(LoRaAuthMode_e loraAuthMode) {
+const __FlashStringHelper* LoRa::loraAuthMode_toString(LoRaAuthMode_e loraAuthMode) {
     switch (loraAuthMode) {
         case LWABP:
-            return "LWABP";
+            return F("LWABP");
         case LWOTAA:
-            return "LWOTAA";
+            return F("LWOTAA");
         case LWTEST:
-            return "LWTEST";
+            return F("LWTEST");
         default:
-            return "ERROR";
+            return F("ERROR");
     }
 }
 
+
 /**
- * @fn sendNoAckMsg(uint8_t port, char* msg_ptr, uint8_t msg_size)
- * @brief Send unconfirmed messages in a string format.
+ * @fn sendNoAckMsg(const LoRaConfig_t& loraCfg, uint8_t port, const char* buf)
+ * @brief Start sending an unconfirmed message in a string format (completion is reported by \ref LoRa::poll()).
+ * @param[in] loraCfg - struct with LoRa configuration (see \ref LoRaConfig_t).
  * @param[in] port - LoRa port used to send message.
- * @param[in] msg_ptr - pointer to message.
- * @param[in] msg_size - message size.
- * @retval true - successful transmission.
- * @retval false - transmission fail.
+ * @param[in] buf - null terminated message.
+ * @retval true - transmission started.
+ * @retval false - modem busy or message too long.
  */ 
-bool LoRa::sendNoAckMsg(LoRaConfig_t loraCfg, uint8_t port, String buf) {
-
-    String at_cmd = "";
-
-    // Set LoRa port
+bool LoRa::sendNoAckMsg(const LoRaConfig_t& loraCfg, uint8_t port, const char* buf) {
     if (loraCfg.debug) {
-        Serial.print("\nSetting LoRa port... ");
-        Serial.flush();
-    }
-    loraReturn = "";
-    at_cmd = "AT+PORT=";
-    at_cmd.concat(toAscii(port));
-    // Serial1.println(at_cmd);
-    // loraReturn = Serial1.readString();
-    if (loraCfg.debug) {
-        Serial.print("\n\t");
-        Serial.print(loraReturn);
-        Serial.flush();        
+        debugOut.print(F("\nSending unconfirmed LoRa string message... "));
+        debugOut.flush();
+    }
+    if (isBusy()) {
+        return false;
     }
+    pendingCmd.begin(F("AT+MSG=")).appendQuoted(buf);
+    return startTx(loraCfg, port, false, (uint8_t) strlen(buf));
+}
 
-    // Send LoRa message
-    if (loraCfg.debug) {
-        Serial.print("\nSending unconfirmed LoRa string message... ");
-        Serial.flush();
-    }
-    loraReturn = "";
-    at_cmd = "AT+MSG=\"";
-    at_cmd.concat(buf);
-    at_cmd.concat("\"");
-    // Serial1.println(at_cmd);
-    // loraReturn = Serial1.readString();
+/**
+ * @fn sendAckMsg(const LoRaConfig_t& loraCfg, uint8_t port, const char* buf)
+ * @brief Start sending a confirmed message in a string format (completion is reported by \ref LoRa::poll()).
+ * @param[in] loraCfg - struct with LoRa configuration (see \ref LoRaConfig_t).
+ * @param[in] port - LoRa port used to send message.
+ * @param[in] buf - null terminated message.
+ * @retval true - transmission started.
+ * @retval false - modem busy or message too long.
+ */ 
+bool LoRa::sendAckMsg(const LoRaConfig_t& loraCfg, uint8_t port, const char* buf) {
     if (loraCfg.debug) {
-        Serial.print("\n\t");
-        Serial.print(loraReturn);
-        Serial.flush();        
+        debugOut.print(F("\nSending confirmed LoRa string message... "));
+        debugOut.flush();
     }
-
-    return true;
+    if (isBusy()) {
+        return false;
+    }
+    pendingCmd.begin(F("AT+CMSG=")).appendQuoted(buf);
+    return startTx(loraCfg, port, true, (uint8_t) strlen(buf));
 }
 
 /**
- * @fn sendAckMsg(uint8_t port, char* msg_ptr, uint8_t msg_size)
- * @brief Send confirmed messages in a string format.
+ * @fn sendNoAckMsgHex(const LoRaConfig_t& loraCfg, uint8_t port, const char* buf)
+ * @brief Start sending an unconfirmed message in a hexadecimal format (completion is reported by \ref LoRa::poll()).
+ * @param[in] loraCfg - struct with LoRa configuration (see \ref LoRaConfig_t).
  * @param[in] port - LoRa port used to send message.
- * @param[in] msg_ptr - pointer to message.
- * @param[in] msg_size - message size.
- * @retval true - successful transmission.
- * @retval false - transmission fail.
+ * @param[in] buf - null terminated message.
+ * @retval true - transmission started.
+ * @retval false - modem busy or message too long.
  */ 
-bool LoRa::sendAckMsg(LoRaConfig_t loraCfg, uint8_t port, String buf) {
-
-    String at_cmd = "";
-
-    // Set LoRa port
+bool LoRa::sendNoAckMsgHex(const LoRaConfig_t& loraCfg, uint8_t port, const char* buf) {
     if (loraCfg.debug) {
-        Serial.print("\nSetting LoRa port... ");
-        Serial.flush();
-    }
-    loraReturn = "";
-    at_cmd = "AT+PORT=";
-    at_cmd.concat(toAscii(port));
-    // Serial1.println(at_cmd);
-    // loraReturn = Serial1.readString();
+        debugOut.print(F("\nSending unconfirmed LoRa hexadecimal message... "));
+        debugOut.flush();
+    }
+    if (isBusy()) {
+        return false;
+    }
+    pendingCmd.begin(F("AT+MSGHEX=")).appendQuoted(buf);
+    return startTx(loraCfg, port, false, (uint8_t) (strlen(buf) / 2));
+}
+
+/**
+ * @fn sendAckMsgHex(const LoRaConfig_t& loraCfg, uint8_t port, const char* buf)
+ * @brief Start sending a confirmed message in a hexadecimal format (completion is reported by \ref LoRa::poll()).
+ * @param[in] loraCfg - struct with LoRa configuration (see \ref LoRaConfig_t).
+ * @param[in] port - LoRa port used to send message.
+ * @param[in] buf - null terminated message.
+ * @retval true - transmission started.
+ * @retval false - modem busy or message too long.
+ */ 
+bool LoRa::sendAckMsgHex(const LoRaConfig_t& loraCfg, uint8_t port, const char* buf) {
     if (loraCfg.debug) {
-        Serial.print("\n\t");
-        Serial.print(loraReturn);
-        Serial.flush();        
+        debugOut.print(F("\nSending confirmed LoRa hexadecimal message... "));
+        debugOut.flush();
+    }
+    if (isBusy()) {
+        return false;
     }
+    pendingCmd.begin(F("AT+CMSGHEX=")).appendQuoted(buf);
+    return startTx(loraCfg, port, true, (uint8_t) (strlen(buf) / 2));
+}
 
-    // Send LoRa message
+/**
+ * @fn sendNoAckMsgBin(const LoRaConfig_t& loraCfg, uint8_t port, const uint8_t* data, uint8_t len)
+ * @brief Start sending an unconfirmed binary message (completion is reported by \ref LoRa::poll()).
+ * The data is hexadecimal encoded directly into the modem command, without intermediate buffers.
+ * @param[in] loraCfg - struct with LoRa configuration (see \ref LoRaConfig_t).
+ * @param[in] port - LoRa port used to send message.
+ * @param[in] data - message.
+ * @param[in] len - message size (in bytes).
+ * @retval true - transmission started.
+ * @retval false - modem busy or message too long.
+ */ 
+bool LoRa::sendNoAckMsgBin(const LoRaConfig_t& loraCfg, uint8_t port, const uint8_t* data, uint8_t len) {
     if (loraCfg.debug) {
-        Serial.print("\nSending confirmed LoRa string message... ");
-        Serial.flush();
-    }
-    loraReturn = "";
-    at_cmd = "AT+CMSG=\"";
-    at_cmd.concat(buf);
-    at_cmd.concat("\"");
-    // Serial1.println(at_cmd);
-    // loraReturn = Serial1.readString();
+        debugOut.print(F("\nSending unconfirmed LoRa binary message... "));
+        debugOut.flush();
+    }
+    if (isBusy()) {
+        return false;
+    }
+    pendingCmd.begin(F("AT+MSGHEX=\"")).appendHex(data, len).append('"');
+    return startTx(loraCfg, port, false, len);
+}
+
+/**
+ * @fn sendAckMsgBin(const LoRaConfig_t& loraCfg, uint8_t port, const uint8_t* data, uint8_t len)
+ * @brief Start sending a confirmed binary message (completion is reported by \ref LoRa::poll()).
+ * The data is hexadecimal encoded directly into the modem command, without intermediate buffers.
+ * @param[in] loraCfg - struct with LoRa configuration (see \ref LoRaConfig_t).
+ * @param[in] port - LoRa port used to send message.
+ * @param[in] data - message.
+ * @param[in] len - message size (in bytes).
+ * @retval true - transmission started.
+ * @retval false - modem busy or message too long.
+ */ 
+bool LoRa::sendAckMsgBin(const LoRaConfig_t& loraCfg, uint8_t port, const uint8_t* data, uint8_t len) {
     if (loraCfg.debug) {
-        Serial.print("\n");
-        Serial.print(loraReturn);
-        Serial.flush();        
+        debugOut.print(F("\nSending confirmed LoRa binary message... "));
+        debugOut.flush();
+    }
+    if (isBusy()) {
+        return false;
     }
+    pendingCmd.begin(F("AT+CMSGHEX=\"")).appendHex(data, len).append('"');
+    return startTx(loraCfg, port, true, len);
+}
 
+/**
+ * @fn LoRa::startTx(const LoRaConfig_t& loraCfg, uint8_t port, bool confirmed, uint8_t len)
+ * @brief Check the airtime budget and start the command sequence of the message: the data rate (when it changed)
+ * and the link check request (when asked by \ref requestLinkCheck()) are set first, then the LoRa port. The
+ * message command (already built into \c pendingCmd) is written when the modem acknowledges the port.
+ *
+ * The modem does not report its retransmissions, so a confirmed message is charged to the budget for all the
+ * transmissions it may take (see \ref loraConfirmedTransmissions()).
+ * @param[in] loraCfg - struct with LoRa configuration (see \ref LoRaConfig_t).
+ * @param[in] port - LoRa port used to send message.
+ * @param[in] confirmed - confirmed message (retransmitted by the modem until acknowledged).
+ * @param[in] len - application payload size (in bytes).
+ * @retval true - transmission started.
+ * @retval false - message too long (for the command buffer or for the data rate, see \ref loraMaxPayload()) or
+ * airtime budget exhausted (the message must be deferred).
+ */
+bool LoRa::startTx(const LoRaConfig_t& loraCfg, uint8_t port, bool confirmed, uint8_t len) {
+    if (pendingCmd.overflow() || (len > loraMaxPayload(loraCfg.band, loraCfg.uplink_dr))) {
+        return false;
+    }
+
+    // Airtime of every transmission the message may take. The budget runs on the wall clock: millis() stops while
+    // the MCU is powered down.
+    uint32_t now = budgetTime();
+    uint32_t airtime = loraWanAirtimeMs(loraCfg.band, loraCfg.uplink_dr, len);
+    if (confirmed) {
+        airtime *= loraConfirmedTransmissions(loraCfg.retry);
+    }
+    budget.setLimit(loraBudgetLimit(loraCfg.band));
+    if (!budget.allows(now, airtime)) {
+        if (loraCfg.debug) {
+            debugOut.print(F("[DEFERRED] airtime (in ms): "));
+            debugOut.print(airtime);
+            debugOut.flush();
+        }
+        return false;
+    }
+    budget.spend(now, airtime);
+    lastAirtime = airtime;
+    debug = loraCfg.debug;
+    doneTimeout = confirmed ? LORA_ACK_TX_TIMEOUT : LORA_TX_TIMEOUT;
+
+    txPort = port;
+    txDr = loraCfg.uplink_dr;
+    setupPending = 0;
+    if (!modemDrKnown || (modemDr != txDr)) {
+        setupPending |= SETUP_DR;
+    }
+    if (linkCheckRequested) {
+        setupPending |= SETUP_LCR;
+    }
+    msgWritten = false;
+    rxQuality = false;
+    linkChecked = false;
+    downlinkLen = 0;
+    enterState(LORA_SENDING);
+    writeNextCmd();
     return true;
 }
 
 /**
- * @fn sendNoAckMsgHex(uint8_t port, char* msg_ptr, uint8_t msg_size)
- * @brief Send unconfirmed messages in a hexadecimal format.
- * @param[in] port - LoRa port used to send message.
- * @param[in] msg_ptr - pointer to message.
- * @param[in] msg_size - message size.
- * @retval true - successful transmission.
- * @retval false - transmission fail.
- */ 
-bool LoRa::sendNoAckMsgHex(LoRaConfig_t loraCfg, uint8_t port, String buf) {
+ * @fn LoRa::writeNextCmd()
+ * @brief Write the next command of the message sequence started by \ref startTx().
+ */
+void LoRa::writeNextCmd() {
+    ATCmd at_cmd;
+    if (setupPending & SETUP_DR) {
+        at_cmd.begin(F("AT+DR=")).append(loraDR_toString(txDr));
+    } else if (setupPending & SETUP_LCR) {
+        at_cmd.begin(F("AT+LW=LCR"));
+    } else {
+        at_cmd.begin(F("AT+PORT=")).appendUInt(txPort);
+    }
+    modem.println(at_cmd.c_str());
+}
 
-    String at_cmd = "";
+/**
+ * @fn LoRa::startJoin(const LoRaConfig_t& loraCfg)
+ * @brief Start the OTAA join procedure.
+ * @param[in] loraCfg - struct with LoRa configuration (see \ref LoRaConfig_t).
+ * @retval true - join started.
+ * @retval false - modem busy.
+ */
+bool LoRa::startJoin(const LoRaConfig_t& loraCfg) {
+    if (isBusy()) {
+        return false;
+    }
+    debug = loraCfg.debug;
+    doneTimeout = LORA_JOIN_TIMEOUT;
+    modem.println(F("AT+JOIN"));
+    enterState(LORA_SENDING);
+    msgWritten = true;
+    return true;
+}
 
-    // Set LoRa modem as busy
-    loraBusy = true;
+/**
+ * @fn LoRa::enterState(LoRaState_e newState)
+ * @brief Change the transmission state, saving the time spent into the previous stage.
+ * @param[in] newState - next transmission state.
+ */
+void LoRa::enterState(LoRaState_e newState) {
+    unsigned long now = millis();
+    if ((state == LORA_SENDING) || (state == LORA_WAITING_DONE)) {
+        stageLatency[state] = now - stageStart;
+    }
+    state = newState;
+    stageStart = now;
+    txFailed = false;
+}
 
-    // Set LoRa port
-    if (loraCfg.debug) {
-        Serial.print("\nSetting LoRa port... ");
-        Serial.flush();
-    }
-    loraReturn = "";
-    at_cmd = "AT+PORT=";
-    at_cmd.concat(toAscii(port));
-    // Serial1.println(at_cmd);
-    // loraReturn = Serial1.readString();
-    if (loraCfg.debug) {
-        Serial.print("\n\t");
-        Serial.print(loraReturn);
-        Serial.flush();        
+/**
+ * @fn LoRa::processEvent(const ModemEvent_t& event)
+ * @brief Process one reply line of LoRa modem (decoded by \ref ModemParser) according to the transmission state.
+ * @param[in] event - decoded reply line.
+ */
+void LoRa::processEvent(const ModemEvent_t& event) {
+    // Lines out of a transmission (late replies) must not change a result or start a new one
+    if (!isBusy()) {
+        return;
+    }
+
+    if (event.type == MODEM_EVENT_ERROR) {
+        enterState(LORA_ERROR);
+        return;
+    }
+
+    if ((state == LORA_SENDING) && !msgWritten) {
+        if ((setupPending & SETUP_DR) && (event.tag == MODEM_TAG_DR)) {
+            modemDr = txDr;
+            modemDrKnown = true;
+            setupPending &= (uint8_t) ~SETUP_DR;
+            writeNextCmd();
+        } else if ((setupPending & SETUP_LCR) && (event.tag == MODEM_TAG_LW)) {
+            linkCheckRequested = false;
+            setupPending &= (uint8_t) ~SETUP_LCR;
+            writeNextCmd();
+        } else if ((setupPending == 0) && (event.tag == MODEM_TAG_PORT)) {
+            // Port acknowledged: write the queued message command
+            modem.println(pendingCmd.c_str());
+            msgWritten = true;
+        }
+        // Other lines (ex.: the second line of the data rate reply) are ignored
+        return;
     }
 
-    // Send LoRa message
-    if (loraCfg.debug) {
-        Serial.print("\nSending unconfirmed LoRa hexadecimal message... ");
-        Serial.flush();
-    }
-    loraReturn = "";
-    at_cmd = "AT+MSGHEX=\"";
-    at_cmd.concat(buf);
-    at_cmd.concat("\"");
-    // Serial1.println(at_cmd);
-    // loraReturn = Serial1.readString();
-    do {
-        // while (Serial1.available()) {
-        //     loraReturn = Serial1.readString();
-        //     if (loraCfg.debug) {
-        //         Serial.print("\n");
-        //         Serial.print(loraReturn);
-        //         Serial.flush();        
-        //     }
-        //     char str[1024];
-        //     loraReturn.toCharArray(str, sizeof(str), 0);
-        //     if (strstr(str, "Done")) {
-        //         loraBusy = false;
-        //     }
-        // }  
-    } while (loraBusy);
+    if (state == LORA_SENDING) {
+        // First reply line of the message (or join) command
+        if (event.tag != MODEM_TAG_NONE) {
+            enterState(LORA_WAITING_DONE);
+        }
+    }
 
-    return true;
+    if (state == LORA_WAITING_DONE) {
+        switch (event.type) {
+            case MODEM_EVENT_FAILED:
+                txFailed = true;
+                break;
+            case MODEM_EVENT_RX_QUALITY:
+                rxRssi = event.rssi;
+                rxSnr = event.snr;
+                rxQuality = true;
+                break;
+            case MODEM_EVENT_LINK_CHECK:
+                linkMargin = event.margin;
+                linkGateways = event.gateways;
+                linkChecked = true;
+                break;
+            case MODEM_EVENT_DOWNLINK:
+                downlinkPort = event.port;
+                downlinkLen = event.len;
+                break;
+            case MODEM_EVENT_DONE:
+                enterState(txFailed ? LORA_ERROR : LORA_DONE);
+                break;
+            default:
+                break;
+        }
+    }
 }
 
 /**
- * @fn sendAckMsgHex(uint8_t port, char* msg_ptr, uint8_t msg_size)
- * @brief Send confirmed messages in a hexadecimal format.
- * @param[in] port - LoRa port used to send message.
- * @param[in] msg_ptr - pointer to message.
- * @param[in] msg_size - message size.
- * @retval true - successful transmission.
- * @retval false - transmission fail.
- */ 
-bool LoRa::sendAckMsgHex(LoRaConfig_t loraCfg, uint8_t port, String buf) {
+ * @fn LoRa::getDownlink(uint8_t& port, const uint8_t*& data, uint8_t& len)
+ * @brief Get the downlink payload received after the last message.
+ * @param[out] port - downlink port.
+ * @param[out] data - downlink payload (valid until the next message).
+ * @param[out] len - downlink payload size (in bytes, up to \ref MODEM_DOWNLINK_SIZE).
+ * @return bool - \c true if a downlink payload was received.
+ */
+bool LoRa::getDownlink(uint8_t& port, const uint8_t*& data, uint8_t& len) const {
+    port = downlinkPort;
+    data = parser.event().data;
+    len = downlinkLen;
+    return downlinkLen > 0;
+}
+
+/**
+ * @fn LoRa::getRxQuality(int16_t& rssi, int16_t& snr)
+ * @brief Get the quality of the downlink received after the last message.
+ * @param[out] rssi - downlink RSSI (in dBm).
+ * @param[out] snr - downlink SNR (in 0.1 dB).
+ * @return bool - \c true if a downlink was received.
+ */
+bool LoRa::getRxQuality(int16_t& rssi, int16_t& snr) const {
+    rssi = rxRssi;
+    snr = rxSnr;
+    return rxQuality;
+}
 
-    String at_cmd = "";
+/**
+ * @fn LoRa::getLinkCheck(uint8_t& margin, uint8_t& gateways)
+ * @brief Get the link check answer received after the last message (see \ref requestLinkCheck()).
+ * @param[out] margin - link margin of the uplink at the best gateway (in dB).
+ * @param[out] gateways - number of gateways that received the uplink.
+ * @return bool - \c true if the answer was received.
+ */
+bool LoRa::getLinkCheck(uint8_t& margin, uint8_t& gateways) const {
+    margin = linkMargin;
+    gateways = linkGateways;
+    return linkChecked;
+}
 
-    // Set LoRa modem as busy
-    loraBusy = true;
+/**
+ * @fn LoRa::update()
+ * @brief Consume the bytes received from LoRa modem as they arrive (see \ref ModemParser) and advance the
+ * transmission state machine (stage deadlines included).
+ */
+void LoRa::update() {
+    while (modem.available() > 0) {
+        char c = (char) modem.read();
+        if (debug) {
+            debugOut.write(c);
+        }
+        if (parser.feed(c)) {
+            processEvent(parser.event());
+        }
+    }
 
-    // Set LoRa port
-    if (loraCfg.debug) {
-        Serial.print("\nSetting LoRa port... ");
-        Serial.flush();
-    }
-    loraReturn = "";
-    at_cmd = "AT+PORT=";
-    at_cmd.concat(toAscii(port));
-    // Serial1.println(at_cmd);
-    // loraReturn = Serial1.readString();
-    if (loraCfg.debug) {
-        Serial.print("\n\t");
-        Serial.print(loraReturn);
-        Serial.flush();        
+    // Check stage deadline
+    if ((state == LORA_SENDING) && ((millis() - stageStart) > LORA_CMD_TIMEOUT)) {
+        enterState(LORA_ERROR);
+    } else if ((state == LORA_WAITING_DONE) && ((millis() - stageStart) > doneTimeout)) {
+        enterState(LORA_ERROR);
     }
+}
 
-    // Send LoRa message
-    if (loraCfg.debug) {
-        Serial.print("\nSending confirmed LoRa hexadecimal message... ");
-        Serial.flush();
-    }
-    loraReturn = "";
-    at_cmd = "AT+CMSGHEX=\"";
-    at_cmd.concat(buf);
-    at_cmd.concat("\"");
-    // Serial1.println(at_cmd);
-    do {
-        // while (Serial1.available()) {
-        //     loraReturn = Serial1.readString();
-        //     if (loraCfg.debug) {
-        //         Serial.print("\n");
-        //         Serial.print(loraReturn);
-        //         Serial.flush();        
-        //     }
-        //     char str[1024];
-        //     loraReturn.toCharArray(str, sizeof(str), 0);
-        //     if (strstr(str, "Done")) {
-        //         loraBusy = false;
-        //     }
-        // }  
-    } while (loraBusy);
+/**
+ * @fn LoRa::poll()
+ * @brief Advance the transmission state machine (see \ref update()) and report its state.
+ * It must be called periodically (from \c loop()) and never blocks. The result of a transmission
+ * (\ref LORA_DONE or \ref LORA_ERROR) is one-shot: it is returned by a single call, then the state goes back to
+ * \ref LORA_IDLE, so the caller handles each result exactly once.
+ * @return LoRaState_e - current transmission state.
+ */
+LoRaState_e LoRa::poll() {
+    update();
 
-    return true;
+    LoRaState_e current = state;
+    if ((current == LORA_DONE) || (current == LORA_ERROR)) {
+        state = LORA_IDLE;
+    }
+    return current;
+}
+
+/**
+ * @fn LoRa::getStageLatency(LoRaState_e stage)
+ * @brief Get the time spent into the last \ref LORA_SENDING or \ref LORA_WAITING_DONE stage.
+ * @param[in] stage - transmission stage.
+ * @return unsigned long - stage latency (in ms).
+ */
+unsigned long LoRa::getStageLatency(LoRaState_e stage) {
+    if ((stage == LORA_SENDING) || (stage == LORA_WAITING_DONE)) {
+        return stageLatency[stage];
+    }
+    return 0;
 }
 
 /**
@@ -786,12 +813,5 @@ bool LoRa::sendAckMsgHex(LoRaConfig_t loraCfg, uint8_t port, String buf) {
  * @brief Callback to process data from LoRa modem.
  */
 void LoRa::callback_RX() {
-    // while (Serial1.available()) {    
-    //     loraReturn = Serial1.readString();
-    //     // if (loraConfig.debug) {
-    //         Serial.print("\n");
-    //         Serial.print(loraReturn);
-    //         Serial.flush();
-    //     // }
-    // }
-}
\ No newline at end of file
+    update();
+}
@@ -0,0 +1,426 @@
+/**
+ * @file AgroTechLab_ModemEmulator.cpp
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief AgroTechLab RHF0M003 modem emulator for host builds.
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#include "AgroTechLab_ModemEmulator.h"
+
+#if !defined(__AVR__)
+#include <limits.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "AgroTechLab_Airtime.h"
+
+/**
+ * @fn ModemEmulator::ModemEmulator(const ModemEmulatorSettings_t& emulatorSettings)
+ * @brief Constructor of ModemEmulator class.
+ * @param[in] emulatorSettings - timing and radio conditions (see \ref ModemEmulatorSettings_t).
+ */
+ModemEmulator::ModemEmulator(const ModemEmulatorSettings_t& emulatorSettings) : settings(emulatorSettings) {
+    reset();
+}
+
+/**
+ * @fn ModemEmulator::reset()
+ * @brief Power cycle: drop the pending replies, the network session and the queued downlink and fault (the
+ * counters are kept).
+ */
+void ModemEmulator::reset() {
+    head = 0;
+    count = 0;
+    sent = 0;
+    lastEnd = 0;
+    lineLen = 0;
+    band = EU868;
+    dr = DR0;
+    otaa = false;
+    joined = false;
+    linkCheck = false;
+    joinFailures = 0;
+    fault = MODEM_FAULT_NONE;
+    downlinkLen = 0;
+}
+
+/**
+ * @fn ModemEmulator::byteTime(uint8_t bytes)
+ * @brief Serial time of \p bytes (in ms, 10 bits per byte).
+ */
+unsigned long ModemEmulator::byteTime(uint8_t bytes) const {
+    return (settings.baud == 0) ? 0 : ((bytes * 10000UL) / settings.baud);
+}
+
+/**
+ * @fn ModemEmulator::reply(unsigned long due, const char* format, ...)
+ * @brief Queue a reply line (\c printf format, the line terminator is added). It starts at \p due, or when the
+ * previous line is over.
+ * @param[in] due - earliest time of the first byte (in ms).
+ * @param[in] format - line format.
+ */
+void ModemEmulator::reply(unsigned long due, const char* format, ...) {
+    if (count >= MODEM_EMU_QUEUE_SIZE) {
+        overflows++;
+        return;
+    }
+    Line_t& entry = queue[(head + count) % MODEM_EMU_QUEUE_SIZE];
+    va_list args;
+    va_start(args, format);
+    int len = vsnprintf(entry.text, sizeof(entry.text) - 2, format, args);
+    va_end(args);
+    if (len < 0) {
+        return;
+    }
+    if (len > (int) (sizeof(entry.text) - 3)) {
+        len = (int) (sizeof(entry.text) - 3);
+    }
+    strcpy(&entry.text[len], "\r\n");
+    entry.due = ((count > 0) && (lastEnd > due)) ? lastEnd : due;
+    lastEnd = entry.due + byteTime((uint8_t) (len + 2));
+    count++;
+}
+
+/**
+ * @fn ModemEmulator::write(uint8_t c, unsigned long now)
+ * @brief Receive a byte from the MCU. A command is run when its line terminator arrives.
+ * @param[in] c - byte.
+ * @param[in] now - current time (in ms).
+ */
+void ModemEmulator::write(uint8_t c, unsigned long now) {
+    if (c == '\r') {
+        return;
+    }
+    if (c == '\n') {
+        line[lineLen] = '\0';
+        if (lineLen > 0) {
+            command(now);
+        }
+        lineLen = 0;
+        return;
+    }
+    if (lineLen < (MODEM_EMU_LINE_SIZE - 1)) {
+        line[lineLen++] = (char) c;
+    }
+}
+
+/**
+ * @fn ModemEmulator::arrived(const Line_t& entry, unsigned long now)
+ * @brief Bytes of a queued line received by the MCU until \p now.
+ */
+uint8_t ModemEmulator::arrived(const Line_t& entry, unsigned long now) const {
+    uint8_t len = (uint8_t) strlen(entry.text);
+    if (now < entry.due) {
+        return 0;
+    }
+    if (settings.baud == 0) {
+        return len;
+    }
+    unsigned long bytes = ((now - entry.due) * settings.baud) / 10000UL;
+    return (bytes > len) ? len : (uint8_t) bytes;
+}
+
+/**
+ * @fn ModemEmulator::available(unsigned long now)
+ * @brief Number of reply bytes the MCU has received until \p now.
+ */
+int ModemEmulator::available(unsigned long now) const {
+    int bytes = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        const Line_t& entry = queue[(head + i) % MODEM_EMU_QUEUE_SIZE];
+        uint8_t done = arrived(entry, now);
+        bytes += done - ((i == 0) ? sent : 0);
+        if (done < strlen(entry.text)) {
+            break;
+        }
+    }
+    return bytes;
+}
+
+/**
+ * @fn ModemEmulator::peek(unsigned long now)
+ * @brief Next reply byte received until \p now, without removing it (-1 if none).
+ */
+int ModemEmulator::peek(unsigned long now) const {
+    if (available(now) == 0) {
+        return -1;
+    }
+    return (uint8_t) queue[head].text[sent];
+}
+
+/**
+ * @fn ModemEmulator::read(unsigned long now)
+ * @brief Remove and return the next reply byte received until \p now (-1 if none).
+ */
+int ModemEmulator::read(unsigned long now) {
+    int c = peek(now);
+    if (c < 0) {
+        return -1;
+    }
+    sent++;
+    if (queue[head].text[sent] == '\0') {
+        head = (uint8_t) ((head + 1) % MODEM_EMU_QUEUE_SIZE);
+        count--;
+        sent = 0;
+    }
+    return c;
+}
+
+/**
+ * @fn ModemEmulator::nextDue()
+ * @brief Time the next reply byte arrives (\c ULONG_MAX if no reply is pending), to advance a simulated clock.
+ */
+unsigned long ModemEmulator::nextDue() const {
+    if (count == 0) {
+        return ULONG_MAX;
+    }
+    return queue[head].due + byteTime((uint8_t) (sent + 1));
+}
+
+/**
+ * @fn ModemEmulator::queueDownlink(uint8_t port, const uint8_t* data, uint8_t len)
+ * @brief Queue a downlink, received in the first receive window of the next uplink.
+ * @param[in] port - downlink port.
+ * @param[in] data - payload.
+ * @param[in] len - payload size (in bytes, truncated to 32).
+ */
+void ModemEmulator::queueDownlink(uint8_t port, const uint8_t* data, uint8_t len) {
+    downlinkPort = port;
+    downlinkLen = (len > sizeof(downlink)) ? (uint8_t) sizeof(downlink) : len;
+    memcpy(downlink, data, downlinkLen);
+}
+
+/**
+ * @fn ModemEmulator::inject(const char* name, ModemFault_e kind, int16_t code)
+ * @brief Replace the reply of the next command \p name (without \c AT+, ex.: \c MSGHEX) by a fault.
+ * @param[in] name - command name.
+ * @param[in] kind - fault (see \ref ModemFault_e).
+ * @param[in] code - error code of \ref MODEM_FAULT_ERROR.
+ */
+void ModemEmulator::inject(const char* name, ModemFault_e kind, int16_t code) {
+    strncpy(faultCmd, name, sizeof(faultCmd) - 1);
+    faultCmd[sizeof(faultCmd) - 1] = '\0';
+    fault = kind;
+    faultCode = code;
+}
+
+/**
+ * @brief Copy \p arg to \p out without the double quotes.
+ */
+static void unquote(const char* arg, char* out, size_t size) {
+    size_t len = 0;
+    for (; (*arg != '\0') && (len < (size - 1)); arg++) {
+        if (*arg != '"') {
+            out[len++] = *arg;
+        }
+    }
+    out[len] = '\0';
+}
+
+/**
+ * @fn ModemEmulator::command(unsigned long now)
+ * @brief Run the command line received.
+ * @param[in] now - time the command ended (in ms).
+ */
+void ModemEmulator::command(unsigned long now) {
+    unsigned long due = now + settings.replyLatency;
+    char name[MODEM_EMU_CMD_SIZE];
+    char arg[MODEM_EMU_LINE_SIZE];
+    commands++;
+
+    if (strcmp(line, "AT") == 0) {
+        strcpy(name, "AT");
+        arg[0] = '\0';
+    } else if (strncmp(line, "AT+", 3) == 0) {
+        const char* end = strchr(line, '=');
+        size_t len = (end != NULL) ? (size_t) (end - line - 3) : strlen(line + 3);
+        if (len >= sizeof(name)) {
+            len = sizeof(name) - 1;
+        }
+        memcpy(name, line + 3, len);
+        name[len] = '\0';
+        unquote((end != NULL) ? (end + 1) : "", arg, sizeof(arg));
+    } else {
+        reply(due, "ERROR(-1)");
+        return;
+    }
+
+    if ((fault != MODEM_FAULT_NONE) && (strcmp(name, faultCmd) == 0)) {
+        ModemFault_e kind = fault;
+        fault = MODEM_FAULT_NONE;
+        switch (kind) {
+            case MODEM_FAULT_SILENT:
+                return;
+            case MODEM_FAULT_BUSY:
+                reply(due, "+%s: LoRaWAN modem is busy", name);
+                return;
+            case MODEM_FAULT_NO_CHANNEL:
+                if (strstr(name, "MSG") != NULL) {
+                    reply(due, "+%s: No free channel", name);
+                    reply(due, "+%s: Done", name);
+                    return;
+                }
+                reply(due, "+%s: ERROR(%d)", name, faultCode);
+                return;
+            default:
+                reply(due, "+%s: ERROR(%d)", name, faultCode);
+                return;
+        }
+    }
+
+    if (strcmp(name, "AT") == 0) {
+        reply(due, "+AT: OK");
+    } else if (strcmp(name, "VER") == 0) {
+        reply(due, "+VER: 2.0.10");
+    } else if (strcmp(name, "DR") == 0) {
+        LoRaModulation_t modulation;
+        if (strcmp(arg, "EU868") == 0) {
+            band = EU868;
+        } else if (strcmp(arg, "US915") == 0) {
+            band = US915;
+        } else if (strcmp(arg, "AU920") == 0) {
+            band = AU920;
+        } else if ((strncmp(arg, "DR", 2) == 0) && (atoi(arg + 2) >= 0) && (atoi(arg + 2) <= DR15) &&
+                   loraModulation(band, (LoRaDR_e) atoi(arg + 2), modulation)) {
+            static const char* const bandName[] = { "EU868", "US915", "AU920" };
+            dr = (LoRaDR_e) atoi(arg + 2);
+            reply(due, "+DR: DR%d", (int) dr);
+            reply(due, "+DR: %s DR%d SF%d BW%dK", bandName[band], (int) dr, (int) modulation.sf, (int) modulation.bw);
+            return;
+        } else if (arg[0] != '\0') {
+            reply(due, "+DR: ERROR(-1)");
+            return;
+        }
+        reply(due, "+DR: %s", (arg[0] != '\0') ? arg : "DR");
+    } else if (strcmp(name, "MODE") == 0) {
+        otaa = strcmp(arg, "LWOTAA") == 0;
+        joined = false;
+        reply(due, "+MODE: %s", arg);
+    } else if (strcmp(name, "ID") == 0) {
+        char* comma = strchr(arg, ',');
+        if (comma == NULL) {
+            reply(due, "+ID: ERROR(-1)");
+            return;
+        }
+        *comma = '\0';
+        reply(due, "+ID: %s, %s", arg, comma + 1);
+    } else if (strcmp(name, "KEY") == 0) {
+        char* comma = strchr(arg, ',');
+        if (comma == NULL) {
+            reply(due, "+KEY: ERROR(-1)");
+            return;
+        }
+        *comma = '\0';
+        for (char* c = arg; *c != '\0'; c++) {
+            if ((*c >= 'a') && (*c <= 'z')) {
+                *c = (char) (*c - 'a' + 'A');
+            }
+        }
+        reply(due, "+KEY: %s %s", arg, comma + 1);
+    } else if (strcmp(name, "LW") == 0) {
+        linkCheck = linkCheck || (strcmp(arg, "LCR") == 0);
+        reply(due, "+LW: %s", arg);
+    } else if (strcmp(name, "JOIN") == 0) {
+        joins++;
+        if (!otaa) {
+            reply(due, "+JOIN: LoRaWAN modem is in ABP mode");
+        } else if (joined) {
+            reply(due, "+JOIN: Joined already");
+        } else {
+            reply(due, "+JOIN: Start");
+            reply(due, "+JOIN: NORMAL");
+            unsigned long end = due + settings.joinDelay;
+            if (joinFailures > 0) {
+                joinFailures--;
+                reply(end, "+JOIN: Join failed");
+            } else {
+                joined = true;
+                reply(end, "+JOIN: Network joined");
+                reply(end, "+JOIN: NetID 000013 DevAddr 26:01:23:45");
+            }
+            reply(end, "+JOIN: Done");
+        }
+    } else if (strstr(name, "MSG") != NULL) {
+        message(name, arg, now);
+    } else if ((strcmp(name, "CLASS") == 0) || (strcmp(name, "POWER") == 0) || (strcmp(name, "CH") == 0) ||
+               (strcmp(name, "RXWIN2") == 0) || (strcmp(name, "ADR") == 0) || (strcmp(name, "RETRY") == 0) ||
+               (strcmp(name, "REPT") == 0) || (strcmp(name, "PORT") == 0)) {
+        reply(due, "+%s: %s", name, arg);
+    } else {
+        reply(due, "+%s: ERROR(-10)", name);
+    }
+}
+
+/**
+ * @fn ModemEmulator::message(const char* name, const char* arg, unsigned long now)
+ * @brief Send an uplink (\c MSG, \c MSGHEX, \c CMSG or \c CMSGHEX) and queue its reply lines: \c Start, then,
+ * after the time on air and the first receive window, the acknowledge, link check answer and downlink, and
+ * \c Done (after both windows when nothing was received). A payload longer than the data rate allows (see
+ * \ref loraMaxPayload()) is not sent: the modem only replies <tt>Length error</tt> with the maximum size.
+ * @param[in] name - command name.
+ * @param[in] arg - payload (text or hexadecimal, without quotes).
+ * @param[in] now - time the command ended (in ms).
+ */
+void ModemEmulator::message(const char* name, const char* arg, unsigned long now) {
+    bool confirmed = name[0] == 'C';
+    bool hex = strstr(name, "HEX") != NULL;
+    unsigned long due = now + settings.replyLatency;
+    if (otaa && !joined) {
+        reply(due, "+%s: Please join network first", name);
+        return;
+    }
+
+    size_t len = hex ? (strlen(arg) / 2) : strlen(arg);
+    uint8_t payload = (len > UINT8_MAX) ? UINT8_MAX : (uint8_t) len;
+    uint8_t maxPayload = loraMaxPayload(band, dr);
+    if (payload > maxPayload) {
+        reply(due, "+%s: Length error %u", name, (unsigned) maxPayload);
+        rejected++;
+        return;
+    }
+    uint32_t onAir = loraWanAirtimeMs(band, dr, payload);
+    uplinks++;
+    airtime += onAir;
+
+    reply(due, "+%s: Start", name);
+    if (confirmed) {
+        reply(due, "+%s: Wait ACK", name);
+    }
+    unsigned long rx1 = due + onAir + (settings.rxWindows / 2);
+    bool received = confirmed || linkCheck || (downlinkLen > 0);
+    if (confirmed) {
+        reply(rx1, "+%s: ACK Received", name);
+    }
+    if (linkCheck) {
+        reply(rx1, "+%s: Link %u, %u", name, (unsigned) settings.linkMargin, (unsigned) settings.gateways);
+        linkCheck = false;
+    }
+    if (downlinkLen > 0) {
+        char data[(2 * sizeof(downlink)) + 1];
+        for (uint8_t i = 0; i < downlinkLen; i++) {
+            snprintf(&data[2 * i], 3, "%02X", downlink[i]);
+        }
+        data[2 * downlinkLen] = '\0';
+        reply(rx1, "+%s: PORT: %u; RX: \"%s\"", name, (unsigned) downlinkPort, data);
+        downlinkLen = 0;
+    }
+    if (received) {
+        int16_t snr = settings.snr;
+        reply(rx1, "+%s: RXWIN1, RSSI %d, SNR %s%d.%d", name, (int) settings.rssi, (snr < 0) ? "-" : "",
+              abs(snr) / 10, abs(snr) % 10);
+        reply(rx1, "+%s: Done", name);
+    } else {
+        reply(due + onAir + settings.rxWindows, "+%s: Done", name);
+    }
+}
+#endif
@@ -0,0 +1,287 @@
+/**
+ * @file AgroTechLab_ModemParser.cpp
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief AgroTechLab streaming parser of the RHF0M003 modem replies.
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#include <string.h>
+#include "AgroTechLab_ModemParser.h"
+
+#if defined(__AVR__)
+    #include <avr/pgmspace.h>
+#else
+    #ifndef PSTR
+        #define PSTR(s) (s)
+    #endif
+    #ifndef strcmp_P
+        #define strcmp_P strcmp
+    #endif
+#endif
+
+/**
+ * @fn ModemParser::ModemParser()
+ * @brief Constructor of ModemParser class.
+ */
+ModemParser::ModemParser() {
+    startLine();
+}
+
+/**
+ * @fn ModemParser::startLine()
+ * @brief Forget the previous line and its event (the downlink payload is kept).
+ */
+void ModemParser::startLine() {
+    tagLen = 0;
+    wordLen = 0;
+    lineLen = 0;
+    stage = STAGE_START;
+    expect = EXPECT_NONE;
+    downlinkNext = false;
+    lineDone = false;
+    memset(&current, 0, sizeof(current));
+    current.type = MODEM_EVENT_LINE;
+    current.tag = MODEM_TAG_NONE;
+    current.data = downlink;
+}
+
+/**
+ * @fn ModemParser::setType(ModemEventType_e type)
+ * @brief Set the event type of the line (an error is never overridden).
+ * @param[in] type - event type.
+ */
+void ModemParser::setType(ModemEventType_e type) {
+    if (current.type != MODEM_EVENT_ERROR) {
+        current.type = type;
+    }
+}
+
+/**
+ * @fn ModemParser::endTag()
+ * @brief Identify the tag of the line.
+ */
+void ModemParser::endTag() {
+    stage = STAGE_BODY;
+    if (tagLen >= (MODEM_TAG_SIZE - 1)) {
+        current.tag = MODEM_TAG_OTHER;
+        return;
+    }
+    tag[tagLen] = '\0';
+    if (strcmp_P(tag, PSTR("AT")) == 0) {
+        current.tag = MODEM_TAG_AT;
+    } else if ((strcmp_P(tag, PSTR("MSG")) == 0) || (strcmp_P(tag, PSTR("MSGHEX")) == 0)) {
+        current.tag = MODEM_TAG_MSG;
+    } else if ((strcmp_P(tag, PSTR("CMSG")) == 0) || (strcmp_P(tag, PSTR("CMSGHEX")) == 0)) {
+        current.tag = MODEM_TAG_CMSG;
+    } else if (strcmp_P(tag, PSTR("JOIN")) == 0) {
+        current.tag = MODEM_TAG_JOIN;
+    } else if (strcmp_P(tag, PSTR("PORT")) == 0) {
+        current.tag = MODEM_TAG_PORT;
+    } else if (strcmp_P(tag, PSTR("DR")) == 0) {
+        current.tag = MODEM_TAG_DR;
+    } else if (strcmp_P(tag, PSTR("LW")) == 0) {
+        current.tag = MODEM_TAG_LW;
+    } else {
+        current.tag = MODEM_TAG_OTHER;
+    }
+}
+
+/**
+ * @fn ModemParser::endWord()
+ * @brief Interpret the word just read: a number fills the field announced by the previous keyword, and keywords
+ * set the event type.
+ */
+void ModemParser::endWord() {
+    if (wordLen == 0) {
+        return;
+    }
+    word[wordLen] = '\0';
+    wordLen = 0;
+
+    if (((word[0] >= '0') && (word[0] <= '9')) || ((word[0] == '-') && (word[1] >= '0') && (word[1] <= '9'))) {
+        int16_t value;
+        parseTenths(word, value);
+        switch (expect) {
+            case EXPECT_ERROR:
+                current.error = (int16_t) (value / 10);
+                break;
+            case EXPECT_RSSI:
+                current.rssi = (int16_t) (value / 10);
+                break;
+            case EXPECT_SNR:
+                current.snr = value;
+                break;
+            case EXPECT_MARGIN:
+                current.margin = (uint8_t) (value / 10);
+                expect = EXPECT_GATEWAYS;
+                return;
+            case EXPECT_GATEWAYS:
+                current.gateways = (uint8_t) (value / 10);
+                break;
+            case EXPECT_PORT:
+                current.port = (uint8_t) (value / 10);
+                break;
+            default:
+                break;
+        }
+        expect = EXPECT_NONE;
+        return;
+    }
+
+    expect = EXPECT_NONE;
+    if (strcmp_P(word, PSTR("OK")) == 0) {
+        setType(MODEM_EVENT_OK);
+    } else if (strcmp_P(word, PSTR("ERROR")) == 0) {
+        setType(MODEM_EVENT_ERROR);
+        expect = EXPECT_ERROR;
+    } else if (strcmp_P(word, PSTR("error")) == 0) {
+        // Message rejected (ex.: "+MSG: Length error 11")
+        setType(MODEM_EVENT_ERROR);
+    } else if (strcmp_P(word, PSTR("Done")) == 0) {
+        setType(MODEM_EVENT_DONE);
+    } else if (strcmp_P(word, PSTR("Start")) == 0) {
+        setType(MODEM_EVENT_START);
+    } else if ((strcmp_P(word, PSTR("failed")) == 0) || (strcmp_P(word, PSTR("free")) == 0) ||
+               (strcmp_P(word, PSTR("busy")) == 0)) {
+        setType(MODEM_EVENT_FAILED);
+    } else if ((strcmp_P(word, PSTR("joined")) == 0) || (strcmp_P(word, PSTR("already")) == 0)) {
+        setType(MODEM_EVENT_JOINED);
+    } else if (strcmp_P(word, PSTR("RSSI")) == 0) {
+        setType(MODEM_EVENT_RX_QUALITY);
+        expect = EXPECT_RSSI;
+    } else if (strcmp_P(word, PSTR("SNR")) == 0) {
+        expect = EXPECT_SNR;
+    } else if (strcmp_P(word, PSTR("Link")) == 0) {
+        setType(MODEM_EVENT_LINK_CHECK);
+        expect = EXPECT_MARGIN;
+    } else if (strcmp_P(word, PSTR("PORT")) == 0) {
+        expect = EXPECT_PORT;
+    } else if (strcmp_P(word, PSTR("RX")) == 0) {
+        setType(MODEM_EVENT_DOWNLINK);
+        downlinkNext = true;
+    }
+}
+
+/**
+ * @fn ModemParser::hexDigit(char c)
+ * @brief Decode one hexadecimal digit of a downlink payload (other characters are ignored).
+ * @param[in] c - character received.
+ */
+void ModemParser::hexDigit(char c) {
+    uint8_t value;
+    if ((c >= '0') && (c <= '9')) {
+        value = (uint8_t) (c - '0');
+    } else if ((c >= 'A') && (c <= 'F')) {
+        value = (uint8_t) (c - 'A' + 10);
+    } else if ((c >= 'a') && (c <= 'f')) {
+        value = (uint8_t) (c - 'a' + 10);
+    } else {
+        return;
+    }
+    uint16_t i = nibbles / 2;
+    if (i < MODEM_DOWNLINK_SIZE) {
+        if ((nibbles & 1) == 0) {
+            downlink[i] = (uint8_t) (value << 4);
+        } else {
+            downlink[i] |= value;
+            current.len = (uint8_t) (i + 1);
+        }
+    }
+    nibbles++;
+}
+
+/**
+ * @fn ModemParser::isTag(const char* name, uint8_t len)
+ * @brief Compare the tag of the last line (after \ref feed() returned \c true) with a command name.
+ * @param[in] name - command name, without the \c AT+ prefix (ex.: \c DR, it need not be terminated).
+ * @param[in] len - command name length.
+ * @return bool - \c true if the line is tagged <tt>+name:</tt>.
+ */
+bool ModemParser::isTag(const char* name, uint8_t len) const {
+    if ((current.tag == MODEM_TAG_NONE) || (tagLen != len) || (tagLen >= (MODEM_TAG_SIZE - 1))) {
+        return false;
+    }
+    return strncmp(tag, name, len) == 0;
+}
+
+/**
+ * @fn ModemParser::feed(char c)
+ * @brief Consume one byte received from the modem.
+ * @param[in] c - byte received.
+ * @return bool - \c true if it ended a non-empty line (see \ref event()).
+ */
+bool ModemParser::feed(char c) {
+    if (lineDone) {
+        startLine();
+    }
+    if (c == '\r') {
+        return false;
+    }
+    if (c == '\n') {
+        if (stage == STAGE_TAG) {
+            endTag();
+        }
+        endWord();
+        if (lineLen == 0) {
+            return false;
+        }
+        lineDone = true;
+        return true;
+    }
+    if (lineLen < UINT8_MAX) {
+        lineLen++;
+    }
+
+    switch (stage) {
+        case STAGE_START:
+            if (c == '+') {
+                stage = STAGE_TAG;
+                return false;
+            }
+            stage = STAGE_BODY;
+            break;
+        case STAGE_TAG:
+            if (c == ':') {
+                endTag();
+            } else if (tagLen < (MODEM_TAG_SIZE - 1)) {
+                tag[tagLen++] = c;
+            } else {
+                tagLen = MODEM_TAG_SIZE - 1;
+            }
+            return false;
+        case STAGE_HEX:
+            if (c == '"') {
+                stage = STAGE_BODY;
+            } else {
+                hexDigit(c);
+            }
+            return false;
+        default:
+            break;
+    }
+
+    if (((c >= '0') && (c <= '9')) || ((c >= 'A') && (c <= 'Z')) || ((c >= 'a') && (c <= 'z')) ||
+        (c == '-') || (c == '.')) {
+        if (wordLen < (MODEM_WORD_SIZE - 1)) {
+            word[wordLen++] = c;
+        }
+    } else {
+        endWord();
+        if ((c == '"') && downlinkNext) {
+            downlinkNext = false;
+            stage = STAGE_HEX;
+            nibbles = 0;
+            current.len = 0;
+        }
+    }
+    return false;
+}
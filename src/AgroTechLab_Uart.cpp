@@ -0,0 +1,170 @@
+/**
+ * @file AgroTechLab_Uart.cpp
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief AgroTechLab interrupt-driven hardware UART transport (ATmega328p platform).
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#include "AgroTechLab_Uart.h"
+
+#if defined(__AVR__)
+#include <avr/interrupt.h>
+#include <avr/power.h>
+
+static RingBuffer<UART_RX_BUFFER_SIZE> rxBuffer;    /**< Bytes received, not read yet. */
+static RingBuffer<UART_TX_BUFFER_SIZE> txBuffer;    /**< Bytes written, not sent yet. */
+static volatile uint16_t overruns = 0;              /**< Bytes lost (buffer full or data overrun). */
+static bool written = false;                        /**< A byte was sent since \ref AvrUart::begin(). */
+
+/**
+ * @brief USART0 receive complete: move the byte into the receive buffer.
+ */
+ISR(USART_RX_vect) {
+    bool lost = (UCSR0A & _BV(DOR0)) != 0;
+    uint8_t value = UDR0;
+    if (!rxBuffer.push(value) || lost) {
+        overruns++;
+    }
+}
+
+/**
+ * @brief Send the next byte of the transmit buffer, or stop the data register empty interrupt when it is empty.
+ */
+static void sendNext() {
+    int value = txBuffer.pop();
+    if (value < 0) {
+        UCSR0B &= ~_BV(UDRIE0);
+        return;
+    }
+    UCSR0A = (UCSR0A & _BV(U2X0)) | _BV(TXC0);
+    UDR0 = (uint8_t) value;
+}
+
+/**
+ * @brief USART0 data register empty: send the next buffered byte.
+ */
+ISR(USART_UDRE_vect) {
+    sendNext();
+}
+
+/**
+ * @fn AvrUart::begin(unsigned long baud)
+ * @brief Power on and start USART0 (8N1, double speed) with the receive interrupt enabled.
+ * @param[in] baud - baudrate.
+ */
+void AvrUart::begin(unsigned long baud) {
+    uint16_t ubrr = (uint16_t) (((F_CPU + (4UL * baud)) / (8UL * baud)) - 1);
+    power_usart0_enable();
+    UCSR0B = 0;
+    rxBuffer.clear();
+    written = false;
+    UBRR0H = (uint8_t) (ubrr >> 8);
+    UBRR0L = (uint8_t) ubrr;
+    UCSR0A = _BV(U2X0);
+    UCSR0C = _BV(UCSZ01) | _BV(UCSZ00);
+    UCSR0B = _BV(RXEN0) | _BV(TXEN0) | _BV(RXCIE0);
+}
+
+/**
+ * @fn AvrUart::end()
+ * @brief Send the bytes still buffered and stop USART0 (pins 0 and 1 go back to GPIO).
+ */
+void AvrUart::end() {
+    flush();
+    UCSR0B = 0;
+    rxBuffer.clear();
+}
+
+/**
+ * @fn AvrUart::available()
+ * @brief Number of bytes received and not read yet.
+ */
+int AvrUart::available() {
+    return rxBuffer.count();
+}
+
+/**
+ * @fn AvrUart::peek()
+ * @brief Next received byte, without removing it (-1 if none).
+ */
+int AvrUart::peek() {
+    return rxBuffer.peek();
+}
+
+/**
+ * @fn AvrUart::read()
+ * @brief Remove and return the next received byte (-1 if none).
+ */
+int AvrUart::read() {
+    return rxBuffer.pop();
+}
+
+/**
+ * @fn AvrUart::availableForWrite()
+ * @brief Bytes that can be written without blocking.
+ */
+int AvrUart::availableForWrite() {
+    return txBuffer.room();
+}
+
+/**
+ * @fn AvrUart::flush()
+ * @brief Wait until every buffered byte has left the shift register.
+ */
+void AvrUart::flush() {
+    if (!written) {
+        return;
+    }
+    while ((UCSR0B & _BV(UDRIE0)) || !(UCSR0A & _BV(TXC0))) {
+        if (!(SREG & _BV(SREG_I)) && (UCSR0A & _BV(UDRE0))) {
+            sendNext();     // interrupts disabled: drain the buffer by polling
+        }
+    }
+}
+
+/**
+ * @fn AvrUart::write(uint8_t value)
+ * @brief Queue a byte. It is written straight to the data register when the transmitter is idle and only blocks
+ * while the transmit buffer is full.
+ * @param[in] value - byte to send.
+ * @return size_t - bytes written (always 1).
+ */
+size_t AvrUart::write(uint8_t value) {
+    written = true;
+    if (txBuffer.empty() && (UCSR0A & _BV(UDRE0))) {
+        UCSR0A = (UCSR0A & _BV(U2X0)) | _BV(TXC0);
+        UDR0 = value;
+        return 1;
+    }
+    while (txBuffer.full()) {
+        if (!(SREG & _BV(SREG_I)) && (UCSR0A & _BV(UDRE0))) {
+            sendNext();
+        }
+    }
+    txBuffer.push(value);
+    UCSR0B |= _BV(UDRIE0);
+    return 1;
+}
+
+/**
+ * @fn AvrUart::getOverruns()
+ * @brief Number of received bytes lost since the last call (receive buffer full or hardware data overrun).
+ */
+uint16_t AvrUart::getOverruns() {
+    uint8_t sreg = SREG;
+    cli();
+    uint16_t lost = overruns;
+    overruns = 0;
+    SREG = sreg;
+    return lost;
+}
+#endif
@@ -247,8 +247,8 @@
 void setup() {
   // If LED BUILTIN enabled, configure and power on
   #if (LED_BUILTIN_ENABLED == true)
-    pinMode(LED_BUILTIN, OUTPUT);
-    digitalWrite(LED_BUILTIN, HIGH);
+    pins.output(LED_BUILTIN);
+    pins.write(LED_BUILTIN, true);
   #endif
 
   // If SERIAL_DEBUG enabled, configure serial port for debug
@@ -258,8 +258,10 @@ void setup() {
     printInitInfo();
   #endif
 
+  // Power off unused peripherals and calibrate the sleep timer
+  scheduler.begin();
+
   // Setup and initialize DHT22 sensor
-  pinMode(DHT_PIN, INPUT);  
   #if (SERIAL_DEBUG == true)
     debugSerial.print(F("\n\tInitializing DHT sensor... "));
     debugSerial.flush();
@@ -271,15 +273,26 @@ void setup() {
   #endif
 
   // Initialize light sensor
-  if (SERIAL_DEBUG) {
+  #if (SERIAL_DEBUG == true)
     debugSerial.print(F("\n\tInitializing light sensor... "));
     debugSerial.flush();
-  }
-  // lightSensor.begin();
-  if (SERIAL_DEBUG) {
+  #endif
+  light.begin();
+  #if (SERIAL_DEBUG == true)
     debugSerial.print(F("[OK]"));
     debugSerial.flush();
-  }
+  #endif
+
+  // Recover the log of readings not sent yet
+  recordLog.begin();
+  #if (SERIAL_DEBUG == true)
+    debugSerial.print(F("\n\tReadings waiting into the log: "));
+    debugSerial.print(recordLog.pending());
+    debugSerial.flush();
+  #endif
+
+  // Initialize LoRa modem serial port (hardware USART, received bytes are buffered by its interrupt)
+  loraSerial.begin(LORA_BAUDRATE);
 
   // Setup LoRa module configuration
   loraCfg.band = AU920;
@@ -304,6 +317,19 @@ void setup() {
   loraCfg.apps_key = apps_key;
   loraCfg.nwks_key = nwks_key;
   loraCfg.debug = SERIAL_DEBUG;
+  rateController.begin(loraCfg.band, loraCfg.uplink_dr);
+  lora.setBudgetClock(stationTime);
+
+  // The payload format must fit the smallest uplink of the station (the data rate controller may step down to
+  // DR0), since the modem refuses longer messages: stop with the LED on instead of sending another format
+  if (!payloadFits<PAYLOAD_FORMAT>(loraMaxPayload(loraCfg.band, (LORA_DEVICE_DR == true) ? DR0 : loraCfg.uplink_dr))) {
+    configError = true;
+    #if (SERIAL_DEBUG == true)
+      debugSerial.print(F("\n\tPayload format does not fit the uplink data rate!!!"));
+      debugSerial.flush();
+    #endif
+    return;
+  }
 
   // Initiate LoRa modem
   // if (lora.initModem(loraCfg) == false) {
@@ -314,53 +340,283 @@ void setup() {
   //   setup();
   // }
 
+  // First analog readings in one ADC sequence (the battery task starts later, see \ref BATTERY_PHASE) and task
+  // schedule
+  const uint8_t analogPins[] = { UVM30A_PIN, VOLTAGE_SENSOR_PIN };
+  uint16_t adcValues[2];
+  adc.read(analogPins, 2, adcValues);
+  sensorsData.set(SENSOR_UV_INDEX, getUVIndex(adcValues[0]));
+  sensorsData.set(SENSOR_BATTERY_VOLTAGE, getBatteryVoltage(adcValues[1]));
+  dispatcher.begin(scheduler.now());
+
   // Power off builtin LED after setup process
-  digitalWrite(LED_BUILTIN, LOW);
+  pins.write(LED_BUILTIN, false);
 }
 
 /**
  * @fn loop
- * @brief Loop function executed cyclically based on the value of \ref system_period.
+ * @brief Loop function: run the station tasks that are due (see \ref stationTasks) and sleep until the next one.
  */
 void loop() {
-  #if (SERIAL_DEBUG == true)
-    debugSerial.print(F("\nReading sensors...."));
-    
-    // Get time at start of process
-    unsigned long start_time = millis();
-  #endif  
+  // Station stopped by a configuration error (LED on)
+  if (configError) {
+    scheduler.idle();
+    return;
+  }
+
+  // Advance LoRa transmission without waiting for the modem
+  handleUplinkResult(lora.poll());
+
+  uint32_t now = scheduler.now();
+  if ((int32_t) (dispatcher.nextDue(now) - now) <= 0) {
+    #if (SERIAL_DEBUG == true)
+      debugSerial.print(F("\nRunning tasks...."));
+      
+      // Get time at start of process
+      unsigned long start_time = millis();
+    #endif  
+
+    // Power on builtin LED during reading process
+    pins.write(LED_BUILTIN, true);
+
+    dispatcher.dispatch(now);
+
+    // Power off builtin LED after reading process
+    pins.write(LED_BUILTIN, false);
+
+    #if (SERIAL_DEBUG == true)
+      // Get time at end of process
+      unsigned long end_time = millis();
+
+      debugSerial.print(F("\nProcess time (in ms): "));
+      debugSerial.print(end_time - start_time);
+      debugSerial.flush();
+    #endif  
+  }
+
+  // While the modem is working its serial port must keep receiving, so the MCU only idles (and polls it again).
+  // Otherwise power down until the next task.
+  if (lora.isBusy()) {
+    scheduler.idle();
+  } else {
+    scheduler.sleepUntil(dispatcher.nextDue(scheduler.now()));
+  }
+}
+
+/**
+ * @fn    stationTime
+ * @brief Station logical time (in ms, see \ref SleepScheduler::now()): unlike \c millis(), it keeps running while
+ * the MCU is powered down.
+ */
+uint32_t stationTime() {
+  return scheduler.now();
+}
+
+/**
+ * @fn    startLight
+ * @brief Task: start a one-time light conversion with the range chosen by \ref lightRanger (the sensor powers
+ * down by itself after it). The conversion runs while the other sensors are read and is collected by
+ * \ref readLight. If the sensor keeps its previous MTreg, the ranger scales the count with that one.
+ */
+void startLight() {
+  if (!light.start(lightRanger.mtreg(), lightRanger.highRes2())) {
+    #if (SERIAL_DEBUG == true)
+      debugSerial.print(F("\n\tLight sensor kept MTreg "));
+      debugSerial.print(light.getMTreg());
+      debugSerial.flush();
+    #endif
+  }
+  lightRanger.started(light.getMTreg());
+}
 
-  // Power on builtin LED during reading process
-  digitalWrite(LED_BUILTIN, HIGH);
+/**
+ * @fn    readLight
+ * @brief Task: read light level.
+ */
+void readLight() {
+  uint16_t lux;
+  if (getLightInLux(lux)) {
+    sensorsData.set(SENSOR_LIGHT, lux);
+  } else {
+    sensorsData.invalidate(SENSOR_LIGHT);
+  }
+}
 
-  // // Get air temperature
-  sensorsData.air_temperature = getAirTemperatureInC();
+/**
+ * @fn    readUV
+ * @brief Task: read UV index.
+ */
+void readUV() {
+  const uint8_t pin = UVM30A_PIN;
+  uint16_t adcValue;
+  adc.read(&pin, 1, &adcValue);
+  sensorsData.set(SENSOR_UV_INDEX, getUVIndex(adcValue));
+}
 
-  // // Get air humidity
-  sensorsData.air_humidity = getAirHumidity();
+/**
+ * @fn    readBattery
+ * @brief Task: read battery voltage.
+ */
+void readBattery() {
+  const uint8_t pin = VOLTAGE_SENSOR_PIN;
+  uint16_t adcValue;
+  adc.read(&pin, 1, &adcValue);
+  sensorsData.set(SENSOR_BATTERY_VOLTAGE, getBatteryVoltage(adcValue));
+}
 
-  // // Get light in LUX
-  sensorsData.light = getLightInLux();
+/**
+ * @fn    recordReading
+ * @brief Task: store the readings of the sampling pass into \ref history.
+ */
+void recordReading() {
+  history.push(sensorsData);
+}
 
-  // // Get UV index
-  sensorsData.uv_index = getUVIndex();
+/**
+ * @fn    sendReading
+ * @brief Task: send the latest sensor data (or the period mean, see \ref UPLINK_PERIOD_MEAN) if \ref reportPolicy
+ * asks for it. While the radio is busy (or there is a backlog, or no airtime left) the reading is stored into
+ * the log, behind the readings held by \ref payloadEncoder, and the log is drained as soon as the radio is
+ * available.
+ */
+void sendReading() {
+  uint32_t now = scheduler.now();
+  STATION_SENSORS_T reading = UPLINK_PERIOD_MEAN ? history.mean() : sensorsData;
+
+  if (REPORT_ON_CHANGE && !reportPolicy.due(reading, now)) {
+    if (!lora.isBusy() && (recordLog.pending() > 0)) {
+      sendBacklog();
+    }
+    return;
+  }
+  reportPolicy.reported(reading, now);
+  history.restartPeriod();
 
-  // // Get battery voltage
-  sensorsData.battery_voltage = getBatteryVoltage();  
+  if (lora.isBusy() || (recordLog.pending() > 0)) {
+    if (!readingInFlight) {
+      logEncoderReadings();
+    }
+    recordLog.append(reading);
+    if (!lora.isBusy()) {
+      sendBacklog();
+    }
+    return;
+  }
+
+  uint8_t payloadLen = payloadEncoder.encode(reading, payload, loraMaxPayload(loraCfg.band, loraCfg.uplink_dr));
+  if (payloadLen == 0) {
+    return;
+  }
+  if (lora.sendNoAckMsgBin(loraCfg, LORA_SENSORS_PORT, payload, payloadLen)) {
+    readingInFlight = true;
+  } else {
+    // Deferred (airtime budget): sent later into a batch
+    logEncoderReadings();
+  }
+}
+
+/**
+ * @fn    logEncoderReadings
+ * @brief Store every reading held by \ref payloadEncoder (the ones of an undelivered payload included) into the
+ * log, oldest first. Stateful payload formats restart with a complete frame.
+ */
+void logEncoderReadings() {
+  STATION_SENSORS_T held[PayloadEncoder<PAYLOAD_FORMAT>::MAX_READINGS];
+  uint8_t n = payloadEncoder.release(held);
+  for (uint8_t i = 0; i < n; i++) {
+    recordLog.append(held[i]);
+  }
+}
+
+/**
+ * @fn    handleUplinkResult
+ * @brief Process the end of an uplink: sent log readings are committed, and the readings of a failed uplink are
+ * stored into the log (see \ref logEncoderReadings).
+ * @param[in] state - LoRa transmission state.
+ */
+void handleUplinkResult(LoRaState_e state) {
+  if ((state != LORA_DONE) && (state != LORA_ERROR)) {
+    return;
+  }
+  if (state == LORA_DONE) {
+    if (backlogInFlight > 0) {
+      recordLog.commit(backlogSeq, backlogInFlight);
+    }
+    if (readingInFlight) {
+      payloadEncoder.delivered();
+    }
+    if (LORA_DEVICE_DR == true) {
+      updateDataRate();
+    }
+  } else if (readingInFlight) {
+    logEncoderReadings();
+  }
+  backlogInFlight = 0;
+  readingInFlight = false;
+}
 
-  // Power off builtin LED after reading process
-  digitalWrite(LED_BUILTIN, LOW);
+/**
+ * @fn    updateDataRate
+ * @brief Feed the downlink quality of the last uplink into \ref rateController and apply its data rate to the next
+ * uplinks. Link checks are requested when the uplinks get no downlink.
+ */
+void updateDataRate() {
+  int16_t rssi;
+  int16_t snr;
+  uint8_t margin;
+  uint8_t gateways;
+
+  if (lora.getLinkCheck(margin, gateways)) {
+    rateController.addMargin(margin);
+  } else if (lora.getRxQuality(rssi, snr)) {
+    rateController.addSnr(snr);
+  } else {
+    rateController.noFeedback();
+  }
+  if (rateController.wantsLinkCheck()) {
+    lora.requestLinkCheck();
+  }
 
   #if (SERIAL_DEBUG == true)
-    // Get time at end of process
-    unsigned long end_time = millis();
+    if (rateController.dataRate() != loraCfg.uplink_dr) {
+      debugSerial.print(F("\n\tUplink data rate: DR"));
+      debugSerial.print(rateController.dataRate());
+      debugSerial.flush();
+    }
+  #endif
+  loraCfg.uplink_dr = rateController.dataRate();
+}
 
-    debugSerial.print(F("\nProcess time (in ms): "));
-    debugSerial.print(end_time - start_time);
-  #endif  
+/**
+ * @fn    sendBacklog
+ * @brief Send the oldest readings from the log as one batched uplink (see \ref encodeBatch) on
+ * \ref LORA_BACKLOG_PORT. The payload starts with the sequence number (big-endian) of its first reading, and it is
+ * limited to the largest uplink of the current data rate (one reading at AU920 DR0).
+ */
+void sendBacklog() {
+  uint8_t frames[BATCH_MAX_SAMPLES][PAYLOAD_SIZE];
+  uint8_t backlogPayload[2 + BATCH_MAX_PAYLOAD];
+  uint8_t len = 0;
+
+  // The batch (after the sequence number) must also fit the largest uplink of the data rate
+  uint8_t room = loraMaxPayload(loraCfg.band, loraCfg.uplink_dr);
+  room = (room > 2) ? (uint8_t) (room - 2) : 0;
+  if (room > BATCH_MAX_PAYLOAD) {
+    room = BATCH_MAX_PAYLOAD;
+  }
 
-  // Sleep 5 seconds
-  delay(5000);
+  uint8_t n = recordLog.peek(frames, BATCH_MAX_SAMPLES, backlogSeq);
+  while ((n > 0) && ((len = encodeBatch(frames, n, &backlogPayload[2], room)) == 0)) {
+    n--;
+  }
+  if (n == 0) {
+    return;
+  }
+  backlogPayload[0] = (uint8_t) (backlogSeq >> 8);
+  backlogPayload[1] = (uint8_t) backlogSeq;
+  if (lora.sendNoAckMsgBin(loraCfg, LORA_BACKLOG_PORT, backlogPayload, len + 2)) {
+    backlogInFlight = n;
+  }
 }
 
 #if (SERIAL_DEBUG == true)
@@ -393,24 +649,15 @@ void printInitInfo() {
 /**
  * @fn    getBatteryVoltage
  * @brief Get battery voltage level.
- * @return battery voltage.
+ * @param[in] adcValue - oversampled read of \ref VOLTAGE_SENSOR_PIN (see \ref AvrAdc).
+ * @return battery voltage (in mV).
  */
-float getBatteryVoltage() {
-  int analogValue = 0;
-  float vout;
-  float battery_voltage;
-
-  // Read analog value using ADC 10 bits
-  analogValue = analogRead(VOLTAGE_SENSOR_PIN);
-
-  // Convert ADC value to voltage using factor 1:5
-  vout = (analogValue * 5.0) / 1024;
-
-  // Use tension division to get real voltage value
-  battery_voltage = vout / (voltageSensor_R2/(voltageSensor_R1+voltageSensor_R2));
+uint16_t getBatteryVoltage(uint16_t adcValue) {
+  // ADC scale and voltage divider folded into one factor (see \ref batteryMvPerStepQ16)
+  uint16_t battery_voltage = (uint16_t) ((((uint32_t) adcValue * batteryMvPerStepQ16) + 0x8000UL) >> 16);
   
   #if (SERIAL_DEBUG == true)
-    debugSerial.print(F("\n\tBattery voltage (in V): "));
+    debugSerial.print(F("\n\tBattery voltage (in mV): "));
     debugSerial.print(battery_voltage);
     debugSerial.flush();
   #endif
@@ -420,118 +667,180 @@ float getBatteryVoltage() {
 
 /**
  * @fn    getUVIndex
- * @brief Get UV index from UVM30A sensor.
+ * @brief Get UV index from UVM30A sensor (see \ref uvIndexOfAdc).
+ * @param[in] adcValue - oversampled read of \ref UVM30A_PIN (see \ref AvrAdc).
  * @return UV index.
  */
-uint8_t getUVIndex() {
-  // Get UV sensor value and compute in milivolts
-  //int uv_value = (analogRead(UVM30A_PORT) * (5.0 / 1023.0)) * 1000;
-  uint16_t uv_value = analogRead(UVM30A_PIN);
-  uint8_t uv_index = UINT8_MAX;
-  if (isnan(uv_value)) {
-    #if (SERIAL_DEBUG == true)
-      debugSerial.print(F("\n\tError reading UV radiation index!!!"));
-      debugSerial.flush();
-    #endif
-  } else {
-    if (uv_value > 1170) {
-      uv_index = 12;
-    } else {
-      for (int i = 0; i < 12; i++) {
-        if (uv_value <= uvIndexValue[i]) {
-          uv_index = i;
-          break;
-        }
-      }
-    }
-    #if (SERIAL_DEBUG == true)
-      debugSerial.print(F("\n\tUV radiation (in UV index): "));
-      debugSerial.print(uv_value);
-      debugSerial.print(" => ");
-      debugSerial.print(uv_index);
-      debugSerial.flush();
-    #endif    
-  }
+uint8_t getUVIndex(uint16_t adcValue) {
+  // Round the oversampled read to the table resolution (ADC_BITS)
+  uint16_t uv_value = (uint16_t) ((adcValue + ((1U << ADC_OVERSAMPLING_BITS) >> 1)) >> ADC_OVERSAMPLING_BITS);
+  uint8_t uv_index = uvIndexOfAdc(uv_value);
+  #if (SERIAL_DEBUG == true)
+    debugSerial.print(F("\n\tUV radiation (in UV index): "));
+    debugSerial.print(uv_value);
+    debugSerial.print(" => ");
+    debugSerial.print(uv_index);
+    debugSerial.flush();
+  #endif    
   return uv_index;
 }
 
+/**
+ * @fn    readLightRaw
+ * @brief Idle until the light conversion started by \ref startLight is ready and read its raw count.
+ * @param[out] raw - raw count.
+ * @retval true - count read.
+ * @retval false - I2C error.
+ */
+bool readLightRaw(uint16_t& raw) {
+  while (!light.ready()) {
+    scheduler.idle();
+  }
+  return light.read(raw);
+}
+
 /**
  * @fn    getLightInLux
- * @brief Get light intensity (in LUX) from GY30 or GY302 sensor.
- * @return light intensity (in LUX).
+ * @brief Get light intensity (in LUX) from GY30 or GY302 sensor and choose the range of the next conversion. A
+ * saturated conversion is repeated once with the lowest sensitivity. Light above the field range is clamped to
+ * 65535 lux.
+ * @param[out] lux - light intensity (in LUX).
+ * @retval true - light read.
+ * @retval false - I2C error or saturated sensor.
  */
-uint16_t getLightInLux() {
-  uint16_t lux = lightSensor.readLightLevel();    
-  if ((isnan(lux)) || (lux < 0.0f) || (lux > 65535) ) {
-    lux = UINT16_MAX;
-    if (SERIAL_DEBUG == true) {
+bool getLightInLux(uint16_t& lux) {
+  uint16_t raw = 0;
+  bool ok = readLightRaw(raw);
+
+  if (ok && (raw >= LIGHT_RAW_SATURATED)) {
+    lightRanger.update(raw);
+    startLight();
+    ok = readLightRaw(raw);
+  }
+  if (ok) {
+    uint32_t level = lightRanger.toLux(raw);
+    lux = (level > UINT16_MAX) ? UINT16_MAX : (uint16_t) level;
+    ok = lightRanger.update(raw);
+  }
+
+  #if (SERIAL_DEBUG == true)
+    if (!ok) {
       debugSerial.print(F("\n\tError reading light level!!!"));
-      debugSerial.flush();
-    }  
-  } else {    
-    if (SERIAL_DEBUG == true) {
-      debugSerial.print(F("\n\tLuminosity (in LUX): "));  
-      debugSerial.print(lux);        
-      debugSerial.flush();
+    } else {
+      debugSerial.print(F("\n\tLuminosity (in LUX): "));
+      debugSerial.print(lux);
+      debugSerial.print(F(" / raw: "));
+      debugSerial.print(raw);
+      debugSerial.print(F(" / next MTreg: "));
+      debugSerial.print(lightRanger.mtreg());
     }
-  }
-  return lux;
+    debugSerial.flush();
+  #endif
+  return ok;
 }
 
 /**
- * @fn    float getAirTemperatureInC
- * @brief Get air temperature (in Celsius) from DHT22 sensor.
- * @return air temperature (in Celsius).
+ * @fn    startAirClimate
+ * @brief Task: start a DHT22 transaction. The frame is captured by interrupts while the other tasks run and
+ * collected by \ref readAirClimate.
  */
-float getAirTemperatureInC() {  
-  dht.temperature().getSensor(&dht_sensor);
-  dht.temperature().getEvent(&dht_sensor_event);
-  float air_temperature = 0.0f;
-
-  if ((isnan(dht_sensor_event.temperature) || (dht_sensor_event.temperature < -40.0f) ||
-      (dht_sensor_event.temperature > 80.0f))) {
-      air_temperature = __FLT_MAX__;
-    #if (SERIAL_DEBUG == true)
-      debugSerial.print(F("\n\tError reading air temperature!!!"));
-      debugSerial.flush();
-    #endif  
-  } else {
-    air_temperature = dht_sensor_event.temperature;
-    #if (SERIAL_DEBUG == true)
-        debugSerial.print(F("\n\tAir temperature (in oC): "));
-        debugSerial.print(air_temperature);        
-        debugSerial.flush();
-    #endif
-  }
-  return air_temperature;
+void startAirClimate() {
+  dhtStart = micros();
+  dht.start();
 }
 
 /**
- * @fn    getAirHumidity
- * @brief Get air umidity (in %) from DHT22 sensor.
- * @return air umidity (in %).
+ * @fn    readAirClimate
+ * @brief Task: read air temperature (in 0.01 Celsius) and air humidity (in 0.1 %) from the DHT22 frame started by
+ * \ref startAirClimate, idling until it is complete. Invalid values are marked as not read, and
+ * \ref dhtStats is updated.
  */
-float getAirHumidity() {
-  
-  dht.humidity().getSensor(&dht_sensor);
-  dht.humidity().getEvent(&dht_sensor_event);
-  float air_umidity = 0.0f;
-  
-  if ((isnan(dht_sensor_event.relative_humidity)) || (dht_sensor_event.relative_humidity < 0.0f) ||
-    (dht_sensor_event.relative_humidity > 100.0f)) {
-    air_umidity = __FLT_MAX__;      
-    #if (SERIAL_DEBUG == true)
-      debugSerial.print(F("\n\tError reading air humidity!!!"));
-      debugSerial.flush();
-    #endif  
+void readAirClimate() {
+  unsigned long start = millis();
+  while (!dhtDecoder.complete() && ((millis() - start) < DHT_FRAME_TIMEOUT_MS)) {
+    scheduler.idle();
+  }
+  dht.stop();
+  uint16_t latency = (uint16_t) (micros() - dhtStart);
+
+  uint8_t frame[DHT_FRAME_BYTES] = {0};
+  bool ok = dhtDecoder.decode(frame);
+  int16_t air_temperature = dhtTemperature(frame);
+  uint16_t air_humidity = dhtHumidity(frame);
+
+  dhtStats.reads++;
+  dhtStats.last_latency_us = latency;
+  if (latency > dhtStats.max_latency_us) {
+    dhtStats.max_latency_us = latency;
+  }
+
+  bool temperatureOk = ok && (air_temperature >= -400) && (air_temperature <= 800);
+  bool humidityOk = ok && (air_humidity <= 1000);
+  if (temperatureOk) {
+    air_temperature *= 10;
+    sensorsData.set(SENSOR_AIR_TEMPERATURE, air_temperature);
   } else {
-    air_umidity = dht_sensor_event.relative_humidity;
-    #if (SERIAL_DEBUG == true)
-      debugSerial.print(F("\n\tAir humidity (in %): "));
-      debugSerial.print(air_umidity);      
-      debugSerial.flush();
-    #endif
+    sensorsData.invalidate(SENSOR_AIR_TEMPERATURE);
+  }
+  if (humidityOk) {
+    sensorsData.set(SENSOR_AIR_HUMIDITY, air_humidity);
+  } else {
+    sensorsData.invalidate(SENSOR_AIR_HUMIDITY);
+  }
+  if (!temperatureOk || !humidityOk) {
+    dhtStats.failures++;
   }
 
-  return air_umidity;
-}
\ No newline at end of file
+  #if (SERIAL_DEBUG == true)
+    if (!temperatureOk) {
+      debugSerial.print(F("\n\tError reading air temperature!!!"));
+    } else {
+      debugSerial.print(F("\n\tAir temperature (in 0.01 oC): "));
+      debugSerial.print(air_temperature);
+    }
+    if (!humidityOk) {
+      debugSerial.print(F("\n\tError reading air humidity!!!"));
+    } else {
+      debugSerial.print(F("\n\tAir humidity (in 0.1 %): "));
+      debugSerial.print(air_humidity);
+    }
+    debugSerial.print(F("\n\tDHT frame (in us): "));
+    debugSerial.print(latency);
+    debugSerial.print(F(" / pulses: "));
+    debugSerial.print(dhtDecoder.pulses());
+    debugSerial.print(F(" / failures: "));
+    debugSerial.print(dhtStats.failures);
+    debugSerial.print('/');
+    debugSerial.print(dhtStats.reads);
+    debugSerial.flush();
+  #endif
+}
+
+#if !defined(__AVR__)
+/*********************************************
+ *    NATIVE BUILD (Arduino time of the host)
+ ********************************************/
+/**
+ * @fn    millis
+ * @brief Arduino \c millis() of the native build: the simulated MCU clock, stopped while powered down.
+ */
+unsigned long millis() {
+  return sleepPlatform.millis();
+}
+
+/**
+ * @fn    micros
+ * @brief Arduino \c micros() of the native build (1 ms resolution).
+ */
+unsigned long micros() {
+  return sleepPlatform.millis() * 1000UL;
+}
+
+/**
+ * @fn    yield
+ * @brief Arduino \c yield() of the native build: a busy wait (ex.: for a modem reply) lasts 1 ms of simulated time.
+ */
+void yield() {
+  sleepPlatform.idle();
+}
+#endif
@@ -0,0 +1,84 @@
+/**
+ * @file ats_01_adc.cpp
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief AgroTechStation 01 oversampled analog reads (ATmega328p platform).
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#include "ats_01_adc.h"
+
+#if defined(__AVR__)
+#include <Arduino.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+
+static AdcSequence sequence;        /**< Sequence in progress. */
+
+/**
+ * @brief ADC conversion complete: store the result and start the next conversion of the sequence.
+ */
+ISR(ADC_vect) {
+    uint16_t sample = ADC;
+    bool switched = sequence.add(sample);
+    if (sequence.done()) {
+        return;
+    }
+    if (switched) {
+        ADMUX = (ADMUX & 0xF0) | sequence.channel();
+    }
+    ADCSRA |= _BV(ADSC);
+}
+
+/**
+ * @fn AvrAdc::read(const uint8_t* pins, uint8_t n, uint16_t* results)
+ * @brief Oversampled read of up to \ref ADC_MAX_CHANNELS analog pins in one interrupt-driven sequence (AVcc
+ * reference).
+ * @param[in] pins - analog pins (ex.: \c A0).
+ * @param[in] n - number of pins.
+ * @param[out] results - reads with <tt>ADC_BITS + ADC_OVERSAMPLING_BITS</tt> bits, in the order of \p pins.
+ */
+void AvrAdc::read(const uint8_t* pins, uint8_t n, uint16_t* results) {
+    uint8_t channels[ADC_MAX_CHANNELS];
+    if (n > ADC_MAX_CHANNELS) {
+        n = ADC_MAX_CHANNELS;
+    }
+    for (uint8_t i = 0; i < n; i++) {
+        channels[i] = (pins[i] >= A0) ? (pins[i] - A0) : pins[i];
+    }
+    sequence.begin(channels, n);
+    if (n == 0) {
+        return;
+    }
+
+    ADMUX = _BV(REFS0) | sequence.channel();
+    ADCSRA |= _BV(ADIF);
+    ADCSRA |= _BV(ADIE) | _BV(ADSC);
+
+    set_sleep_mode((ADC_WAIT_STOPS_IO_CLOCK == true) ? SLEEP_MODE_ADC : SLEEP_MODE_IDLE);
+    for (;;) {
+        cli();
+        if (sequence.done()) {
+            sei();
+            break;
+        }
+        sleep_enable();
+        sei();
+        sleep_cpu();
+        sleep_disable();
+    }
+    ADCSRA &= ~_BV(ADIE);
+
+    for (uint8_t i = 0; i < n; i++) {
+        results[i] = sequence.result(i);
+    }
+}
+#endif
@@ -0,0 +1,140 @@
+/**
+ * @file ats_01_batch.cpp
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief AgroTechStation 01 batched uplink payload (delta and run-length compression of consecutive readings).
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>). 
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at 
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,  
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or 
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing 
+ * permissions and limitations under the License.
+ */
+#include "ats_01_batch.h"
+
+/**
+ * @fn    putToken
+ * @brief Append a varint to the batch, checking the buffer size.
+ * @param[out] buf - batch buffer.
+ * @param[in,out] len - batch size (in bytes), set above \p size when the varint does not fit.
+ * @param[in] size - buffer size (in bytes).
+ * @param[in] value - value to append.
+ */
+static void putToken(uint8_t* buf, uint16_t& len, uint8_t size, uint32_t value) {
+    uint8_t tmp[5];
+    uint8_t n = putVarint(tmp, value);
+    if ((len + n) <= size) {
+        memcpy(&buf[len], tmp, n);
+    }
+    len += n;
+}
+
+/**
+ * @fn    encodeBatch
+ * @brief Compress consecutive readings into one uplink payload (see \ref PayloadEncoder<PAYLOAD_BATCH>).
+ * @param[in] frames - readings as packed frames (oldest first).
+ * @param[in] count - number of readings (1 to \ref BATCH_MAX_SAMPLES).
+ * @param[out] buf - destination buffer.
+ * @param[in] size - destination buffer size (in bytes).
+ * @return uint8_t - payload size (in bytes) or 0 when it does not fit into \p size bytes.
+ */
+uint8_t encodeBatch(const uint8_t frames[][PAYLOAD_SIZE], uint8_t count, uint8_t* buf, uint8_t size) {
+    int32_t previous[PAYLOAD_FIELDS];
+    int32_t current[PAYLOAD_FIELDS];
+    uint16_t len = 1 + PAYLOAD_SIZE;
+
+    if ((count == 0) || (count > BATCH_MAX_SAMPLES) || (size < len)) {
+        return 0;
+    }
+
+    // Header and base reading
+    buf[0] = count;
+    memcpy(&buf[1], frames[0], PAYLOAD_SIZE);
+
+    // Deltas field by field, so slow fields turn into long runs of zeros
+    for (uint8_t field = 0; field < PAYLOAD_FIELDS; field++) {
+        uint8_t run = 0;
+        unpackPayloadFields(frames[0], previous);
+        for (uint8_t i = 1; i < count; i++) {
+            unpackPayloadFields(frames[i], current);
+            int32_t delta = current[field] - previous[field];
+            previous[field] = current[field];
+            if (delta == 0) {
+                run++;
+                continue;
+            }
+            if (run > 0) {
+                putToken(buf, len, size, BATCH_ZERO_RUN);
+                putToken(buf, len, size, run - 1);
+                run = 0;
+            }
+            putToken(buf, len, size, zigzagEncode(delta));
+        }
+        if (run > 0) {
+            putToken(buf, len, size, BATCH_ZERO_RUN);
+            putToken(buf, len, size, run - 1);
+        }
+    }
+
+    return (len <= size) ? (uint8_t) len : 0;
+}
+
+/**
+ * @fn    decodeBatch
+ * @brief Decompress a batched uplink payload (server side / host tools).
+ * @param[in] buf - payload.
+ * @param[in] len - payload size (in bytes).
+ * @param[out] samples - decoded readings (oldest first).
+ * @param[in] maxSamples - \p samples capacity.
+ * @return uint8_t - number of readings decoded (0 for a malformed payload).
+ */
+uint8_t decodeBatch(const uint8_t* buf, uint8_t len, STATION_SENSORS_T* samples, uint8_t maxSamples) {
+    int32_t fields[BATCH_MAX_SAMPLES][PAYLOAD_FIELDS];
+    uint8_t frame[PAYLOAD_SIZE];
+    uint8_t pos = 1 + PAYLOAD_SIZE;
+
+    if ((len < pos) || (buf[0] == 0) || (buf[0] > BATCH_MAX_SAMPLES) || (buf[0] > maxSamples)) {
+        return 0;
+    }
+    uint8_t count = buf[0];
+    unpackPayloadFields(&buf[1], fields[0]);
+
+    for (uint8_t field = 0; field < PAYLOAD_FIELDS; field++) {
+        uint8_t i = 1;
+        while (i < count) {
+            uint32_t token;
+            uint8_t n = getVarint(&buf[pos], len - pos, token);
+            if (n == 0) {
+                return 0;
+            }
+            pos += n;
+            if (token == BATCH_ZERO_RUN) {
+                uint32_t run;
+                n = getVarint(&buf[pos], len - pos, run);
+                if ((n == 0) || ((i + run + 1) > count)) {
+                    return 0;
+                }
+                pos += n;
+                for (uint32_t r = 0; r <= run; r++, i++) {
+                    fields[i][field] = fields[i - 1][field];
+                }
+            } else {
+                fields[i][field] = fields[i - 1][field] + zigzagDecode(token);
+                i++;
+            }
+        }
+    }
+    if (pos != len) {
+        return 0;
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        packPayloadFields(fields[i], frame);
+        decodePayload(frame, PAYLOAD_SIZE, samples[i]);
+    }
+    return count;
+}
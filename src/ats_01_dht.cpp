@@ -0,0 +1,72 @@
+/**
+ * @file ats_01_dht.cpp
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief AgroTechStation 01 interrupt-driven DHT22 reader (ATmega328p platform).
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#include "ats_01_dht.h"
+
+#if defined(__AVR__)
+#include <Arduino.h>
+
+static DhtDecoder* activeDecoder = NULL;        /**< Decoder of the transaction in progress. */
+static volatile uint8_t* dhtInput = NULL;       /**< Input register of the data pin. */
+static uint8_t dhtMask = 0;                     /**< Bit of the data pin into \ref dhtInput. */
+
+/**
+ * @fn    dhtEdgeIsr
+ * @brief External interrupt (any edge) of the data pin: timestamp the edge.
+ */
+static void dhtEdgeIsr() {
+    activeDecoder->edge((*dhtInput & dhtMask) != 0, (uint16_t) micros());
+}
+
+/**
+ * @fn AvrDht::begin()
+ * @brief Configure the data pin (idle high with the internal pull-up).
+ */
+void AvrDht::begin() {
+    dhtInput = portInputRegister(digitalPinToPort(pin));
+    dhtMask = digitalPinToBitMask(pin);
+    pinMode(pin, INPUT_PULLUP);
+}
+
+/**
+ * @fn AvrDht::start()
+ * @brief Send the start signal and capture the edges of the answer in background (see
+ * \ref DhtDecoder::complete()). Only the start signal (\ref DHT_START_US) is blocking.
+ */
+void AvrDht::start() {
+    uint8_t irq = digitalPinToInterrupt(pin);
+    detachInterrupt(irq);
+    decoder.reset();
+    activeDecoder = &decoder;
+
+    pinMode(pin, OUTPUT);
+    digitalWrite(pin, LOW);
+    delayMicroseconds(DHT_START_US);
+
+    // Drop the edge of the start signal, then release the line
+    EIFR = _BV(irq);
+    attachInterrupt(irq, dhtEdgeIsr, CHANGE);
+    pinMode(pin, INPUT_PULLUP);
+}
+
+/**
+ * @fn AvrDht::stop()
+ * @brief Stop capturing edges (frame complete or timed out).
+ */
+void AvrDht::stop() {
+    detachInterrupt(digitalPinToInterrupt(pin));
+}
+#endif
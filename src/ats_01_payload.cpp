@@ -0,0 +1,130 @@
+/**
+ * @file ats_01_payload.cpp
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief AgroTechStation 01 uplink payload encoder/decoder.
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>). 
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at 
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,  
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or 
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing 
+ * permissions and limitations under the License.
+ */
+#include "ats_01_payload.h"
+
+/**
+ * @fn    encodePayload
+ * @brief Copy the packed station record into the binary uplink payload (see \ref PAYLOAD_SIZE).
+ * @param[in] data - sensor data.
+ * @param[out] buf - destination buffer with at least \ref PAYLOAD_SIZE bytes.
+ * @return uint8_t - payload size (in bytes).
+ */
+uint8_t encodePayload(const STATION_SENSORS_T& data, uint8_t* buf) {
+    memcpy(buf, data.bytes, PAYLOAD_SIZE);
+    return PAYLOAD_SIZE;
+}
+
+/**
+ * @fn    unpackPayloadFields
+ * @brief Extract the fields of a binary payload (signed fields are sign extended).
+ * @param[in] buf - payload with \ref PAYLOAD_SIZE bytes.
+ * @param[out] fields - validity flags followed by the sensor fields (in \ref SensorField_e order).
+ */
+void unpackPayloadFields(const uint8_t* buf, int32_t fields[PAYLOAD_FIELDS]) {
+    fields[0] = recordGetBits(buf, 0, SENSOR_FIELDS);
+    for (uint8_t i = 0; i < SENSOR_FIELDS; i++) {
+        int32_t value = recordGetBits(buf, RECORD_FIELD_OFFSET[i], RECORD_FIELD_WIDTH[i]);
+        if (RECORD_SIGNED_FIELDS & (1 << i)) {
+            int32_t sign = 1L << (RECORD_FIELD_WIDTH[i] - 1);
+            value = (value ^ sign) - sign;
+        }
+        fields[1 + i] = value;
+    }
+}
+
+/**
+ * @fn    packPayloadFields
+ * @brief Inverse of \ref unpackPayloadFields.
+ * @param[in] fields - validity flags followed by the sensor fields (in \ref SensorField_e order).
+ * @param[out] buf - payload with \ref PAYLOAD_SIZE bytes.
+ */
+void packPayloadFields(const int32_t fields[PAYLOAD_FIELDS], uint8_t* buf) {
+    memset(buf, 0, PAYLOAD_SIZE);
+    recordSetBits(buf, 0, SENSOR_FIELDS, (uint16_t) fields[0]);
+    for (uint8_t i = 0; i < SENSOR_FIELDS; i++) {
+        recordSetBits(buf, RECORD_FIELD_OFFSET[i], RECORD_FIELD_WIDTH[i], (uint16_t) fields[1 + i]);
+    }
+}
+
+/**
+ * @fn    decodePayload
+ * @brief Copy a binary uplink payload (see \ref PAYLOAD_SIZE) into a station record.
+ * @param[in] buf - payload.
+ * @param[in] len - payload size (in bytes).
+ * @param[out] data - decoded sensor data.
+ * @retval true - payload decoded.
+ * @retval false - invalid payload size or spare bits set.
+ */
+bool decodePayload(const uint8_t* buf, uint8_t len, STATION_SENSORS_T& data) {
+    uint8_t spare = RECORD_FIELD_OFFSET[SENSOR_FIELDS - 1] + RECORD_FIELD_WIDTH[SENSOR_FIELDS - 1];
+
+    if ((len != PAYLOAD_SIZE) || (recordGetBits(buf, spare, (8 * PAYLOAD_SIZE) - spare) != 0)) {
+        return false;
+    }
+
+    memcpy(data.bytes, buf, PAYLOAD_SIZE);
+    return true;
+}
+
+/**
+ * @fn    PayloadDeltaDecoder::decode
+ * @brief Decode a \ref PAYLOAD_DELTA frame.
+ * @param[in] buf - payload.
+ * @param[in] len - payload size (in bytes).
+ * @param[out] data - decoded sensor data.
+ * @retval true - payload decoded.
+ * @retval false - malformed frame or delta frame received before a key frame.
+ */
+bool PayloadDeltaDecoder::decode(const uint8_t* buf, uint8_t len, STATION_SENSORS_T& data) {
+    uint8_t fixed[PAYLOAD_SIZE];
+
+    if (len == 0) {
+        return false;
+    }
+
+    if (buf[0] == PAYLOAD_DELTA_KEYFRAME) {
+        if (len != (1 + PAYLOAD_SIZE)) {
+            return false;
+        }
+        unpackPayloadFields(&buf[1], reference);
+        synced = true;
+    } else {
+        if ((!synced) || ((buf[0] & PAYLOAD_DELTA_KEYFRAME) != 0)) {
+            return false;
+        }
+        uint8_t pos = 1;
+        for (uint8_t i = 0; i < PAYLOAD_FIELDS; i++) {
+            if (buf[0] & (1 << i)) {
+                uint32_t code;
+                uint8_t n = getVarint(&buf[pos], len - pos, code);
+                if (n == 0) {
+                    synced = false;
+                    return false;
+                }
+                reference[i] += zigzagDecode(code);
+                pos += n;
+            }
+        }
+        if (pos != len) {
+            synced = false;
+            return false;
+        }
+    }
+
+    packPayloadFields(reference, fixed);
+    return decodePayload(fixed, PAYLOAD_SIZE, data);
+}
@@ -0,0 +1,103 @@
+/**
+ * @file ats_01_sim.cpp
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief AgroTechStation 01 simulation driver of the native build.
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ *
+ * Only built by the \c native_sim environment: the \c native environment leaves it out, so the unit test runner
+ * owns \c main().
+ */
+#if !defined(__AVR__)
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+#include "ats_01_station.h"
+
+/**
+ * @fn    simulateWeather
+ * @brief Set the simulated sensor inputs of a clear day: temperature peak at 15 h, light and UV peak at noon
+ * (the light goes past the BH1750 default range) and a battery slowly discharging.
+ * @param[in] ms - wall clock time (in ms).
+ */
+void simulateWeather(uint32_t ms) {
+    const double PI_12 = 3.14159265358979 / 12.0;
+    double hour = fmod(ms / 3600000.0, 24.0);
+    double sun = sin((hour - 6.0) * PI_12);
+    double warmth = sin((hour - 9.0) * PI_12);
+
+    dht.temperature = (int16_t) lround(180.0 + (80.0 * warmth));
+    dht.humidity = (uint16_t) lround(700.0 - (200.0 * warmth));
+    light.sensor.lux = (sun > 0.0) ? (uint32_t) lround(80000.0 * sun) : 0;
+    adc.codes[UVM30A_PIN - A0] = (sun > 0.0) ? (uint16_t) lround(230.0 * sun) : 5;
+    uint32_t battery_mV = 4100 - (ms / 3600000UL);
+    adc.codes[VOLTAGE_SENSOR_PIN - A0] = (uint16_t) (((uint64_t) battery_mV * voltageSensor_R2 * ((1UL << ADC_BITS) - 1)) /
+        ((voltageSensor_R1 + voltageSensor_R2) * adcVref_mV));
+}
+
+/**
+ * @fn    main
+ * @brief Native entry point: run \ref setup() and \ref loop() against the simulated devices for some simulated
+ * hours and print the station counters and the host time spent.\n
+ * Usage: <tt>program [hours] [seed]</tt>. With a seed, random modem faults are queued for the uplink commands
+ * (on about one pass of \ref loop() out of ten while the modem is idle), and one DHT frame out of 50 is corrupted.
+ */
+int main(int argc, char* argv[]) {
+    unsigned long hours = (argc > 1) ? strtoul(argv[1], NULL, 10) : 24;
+    bool fuzz = (argc > 2);
+    if (fuzz) {
+        srand((unsigned int) strtoul(argv[2], NULL, 10));
+        dht.failEvery = 50;
+    }
+    const char* faultCmds[] = { "MSGHEX", "PORT", "DR" };
+
+    clock_t hostStart = clock();
+    simulateWeather(0);
+    setup();
+
+    // Configure the modem like a first boot (the firmware expects it configured)
+    unsigned long bootStart = millis();
+    uint32_t bootCommands = loraSerial.modem.commands;
+    bool modemReady = lora.initModem(loraCfg);
+    unsigned long bootMs = millis() - bootStart;
+    bootCommands = loraSerial.modem.commands - bootCommands;
+
+    uint32_t loops = 0;
+    while (sleepPlatform.realMs < (hours * 3600000UL)) {
+        simulateWeather(sleepPlatform.realMs);
+        if (fuzz && !lora.isBusy() && ((rand() % 10) == 0)) {
+            loraSerial.modem.inject(faultCmds[rand() % 3], (ModemFault_e) (1 + (rand() % MODEM_FAULT_NO_CHANNEL)));
+        }
+        loop();
+        loops++;
+    }
+    double hostSeconds = (double) (clock() - hostStart) / CLOCKS_PER_SEC;
+
+    printf("Simulated time........: %lu h (%lu loops)\n", hours, (unsigned long) loops);
+    printf("Host time.............: %.3f s (%.3f ms per simulated day)\n", hostSeconds,
+        (hours > 0) ? ((hostSeconds * 1000.0 * 24.0) / hours) : 0.0);
+    printf("Modem boot............: %s, %lu commands in %lu ms\n", modemReady ? "OK" : "FAILED",
+        (unsigned long) bootCommands, bootMs);
+    printf("Awake / powered down..: %lu / %lu ms (%lu power-downs)\n", sleepPlatform.awakeMs,
+        (unsigned long) sleepPlatform.poweredDownMs, (unsigned long) sleepPlatform.powerDowns);
+    printf("Modem.................: %lu commands, %lu uplinks, %lu ms on air\n",
+        (unsigned long) loraSerial.modem.commands, (unsigned long) loraSerial.modem.uplinks,
+        (unsigned long) loraSerial.modem.airtime);
+    printf("Reading log...........: %u pending, %lu EEPROM writes\n", (unsigned int) recordLog.pending(),
+        (unsigned long) stationEeprom.writes);
+    printf("DHT failures..........: %lu/%lu\n", (unsigned long) dhtStats.failures, (unsigned long) dhtStats.reads);
+    printf("Light conversions.....: %lu (%lu ms)\n", (unsigned long) light.sensor.conversions,
+        (unsigned long) light.sensor.busyMs);
+    printf("ADC conversions.......: %lu\n", (unsigned long) adc.conversions);
+    return 0;
+}
+#endif
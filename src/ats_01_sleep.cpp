@@ -0,0 +1,144 @@
+/**
+ * @file ats_01_sleep.cpp
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief AgroTechStation 01 deep-sleep scheduler (ATmega328p platform).
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#include "ats_01_sleep.h"
+
+#if defined(__AVR__)
+#include <Arduino.h>
+#include <avr/interrupt.h>
+#include <avr/power.h>
+#include <avr/sleep.h>
+#include <avr/wdt.h>
+
+static volatile bool wdtFired = false;     /**< Set by the watchdog interrupt. */
+
+/**
+ * @brief Watchdog interrupt (interrupt mode only, the watchdog never resets the MCU).
+ */
+ISR(WDT_vect) {
+    wdtFired = true;
+}
+
+/**
+ * @fn    wdtStart
+ * @brief Start the watchdog in interrupt mode.
+ * @param[in] timeout - timeout index (0 = 16 ms .. \ref WDT_MAX_TIMEOUT = 8 s).
+ */
+static void wdtStart(uint8_t timeout) {
+    uint8_t prescaler = (timeout & 0x07) | ((timeout & 0x08) ? _BV(WDP3) : 0);
+    wdtFired = false;
+    cli();
+    wdt_reset();
+    MCUSR &= ~_BV(WDRF);
+    WDTCSR = _BV(WDCE) | _BV(WDE);
+    WDTCSR = _BV(WDIE) | prescaler;
+    sei();
+}
+
+/**
+ * @fn    wdtStop
+ * @brief Stop the watchdog.
+ */
+static void wdtStop() {
+    cli();
+    wdt_reset();
+    MCUSR &= ~_BV(WDRF);
+    WDTCSR = _BV(WDCE) | _BV(WDE);
+    WDTCSR = 0;
+    sei();
+}
+
+/**
+ * @fn AvrSleep::begin()
+ * @brief Power off the peripherals never used by the station (SPI, timers 1 and 2 and analog comparator) and the
+ * digital input buffers of the analog pins. The USART is kept for the LoRa modem.
+ */
+void AvrSleep::begin() {
+    power_spi_disable();
+    power_timer1_disable();
+    power_timer2_disable();
+    ACSR |= _BV(ACD);
+    DIDR0 |= _BV(ADC0D) | _BV(ADC1D);
+}
+
+/**
+ * @fn AvrSleep::millis()
+ * @brief Arduino \c millis() (timer 0, stopped while powered down).
+ * @return unsigned long - time since boot, powered down periods excluded (in ms).
+ */
+unsigned long AvrSleep::millis() {
+    return ::millis();
+}
+
+/**
+ * @fn AvrSleep::powerDown(uint8_t timeout)
+ * @brief Power down (ADC and brown-out detector off) for the whole watchdog timeout. The watchdog counter can not
+ * be read, so a wakeup by another interrupt only runs its handler and the MCU powers down again until the
+ * watchdog fires: the time slept is always the timeout.
+ * @param[in] timeout - watchdog timeout index.
+ */
+void AvrSleep::powerDown(uint8_t timeout) {
+    uint8_t adcsra = ADCSRA;
+    ADCSRA &= ~_BV(ADEN);
+    power_adc_disable();
+
+    wdtStart(timeout);
+    set_sleep_mode(SLEEP_MODE_PWR_DOWN);
+    for (;;) {
+        cli();
+        if (wdtFired) {
+            sei();
+            break;
+        }
+        sleep_enable();
+        sleep_bod_disable();
+        sei();
+        sleep_cpu();
+        sleep_disable();
+    }
+    wdtStop();
+
+    power_adc_enable();
+    ADCSRA = adcsra;
+}
+
+/**
+ * @fn AvrSleep::idle()
+ * @brief Idle sleep until the next interrupt (at most 1 ms later, by the \c millis() timer). Peripherals and
+ * serial ports keep working.
+ */
+void AvrSleep::idle() {
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    sleep_mode();
+}
+
+/**
+ * @fn AvrSleep::measureWdtUs()
+ * @brief Measure the real shortest watchdog timeout using \c micros() (crystal based).
+ * @return uint32_t - watchdog timeout (in us), or 0 if the watchdog did not fire.
+ */
+uint32_t AvrSleep::measureWdtUs() {
+    unsigned long start = ::millis();
+    wdtStart(0);
+    while (!wdtFired && ((::millis() - start) < 100)) { }    // Align to a watchdog timeout
+    wdtFired = false;
+    unsigned long startUs = micros();
+    while (!wdtFired && ((::millis() - start) < 200)) { }
+    uint32_t us = wdtFired ? (uint32_t) (micros() - startUs) : 0;
+    wdtStop();
+    return us;
+}
+#endif
@@ -0,0 +1,124 @@
+/**
+ * @file test_main.cpp
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief Airtime tests of the native build: the data rate table and the integer time-on-air of every data rate of
+ * EU868, US915 and AU920 against the Semtech formula computed in floating point.
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#include <math.h>
+#include <unity.h>
+#include "AgroTechLab_Airtime.h"
+
+/** Data rate of the Regional Parameters (spreading factor 0: FSK or RFU). */
+typedef struct {
+    uint8_t sf;
+    uint16_t bw;
+} RegionalDR_t;
+
+/** EU868 data rates DR0 .. DR15. */
+static const RegionalDR_t EU868_RATES[16] = {
+    {12, 125}, {11, 125}, {10, 125}, {9, 125}, {8, 125}, {7, 125}, {7, 250}, {0, 0},
+    {0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}
+};
+
+/**
+ * US915 data rates DR0 .. DR15, also the AU920 ones of the RHF0M003 firmware (the plan before the Regional
+ * Parameters 1.0.2: DR0 is SF10, not the SF12 of the later AU915 plan).
+ */
+static const RegionalDR_t US915_RATES[16] = {
+    {10, 125}, {9, 125}, {8, 125}, {7, 125}, {8, 500}, {0, 0}, {0, 0}, {0, 0},
+    {12, 500}, {11, 500}, {10, 500}, {9, 500}, {8, 500}, {7, 500}, {0, 0}, {0, 0}
+};
+
+/**
+ * Semtech time-on-air (AN1200.13, in ms) of a LoRaWAN uplink: explicit header, CRC, coding rate 4/5, 8 preamble
+ * symbols and low data rate optimization for symbols longer than 16 ms.
+ */
+static double semtechAirtimeMs(uint8_t sf, uint16_t bw, uint8_t phyLen) {
+    double symbolMs = pow(2.0, sf) / bw;
+    int de = (symbolMs > 16.0) ? 1 : 0;
+    double blocks = ceil((8.0 * phyLen - 4.0 * sf + 28 + 16) / (4.0 * (sf - 2 * de)));
+    double payloadSymbols = 8 + fmax(blocks * (1 + 4), 0);
+    return (8 + 4.25 + payloadSymbols) * symbolMs;
+}
+
+/** Check every data rate of \p band against the table \p rates, for every payload size the data rate allows. */
+static void assertBand(LoRaBand_e band, const RegionalDR_t* rates) {
+    for (uint8_t dr = DR0; dr <= DR15; dr++) {
+        LoRaModulation_t modulation;
+        bool lora = loraModulation(band, (LoRaDR_e) dr, modulation);
+        TEST_ASSERT_EQUAL_MESSAGE(rates[dr].sf != 0, lora, "data rate");
+        if (!lora) {
+            TEST_ASSERT_EQUAL_UINT32(0, loraWanAirtimeMs(band, (LoRaDR_e) dr, 1));
+            continue;
+        }
+        TEST_ASSERT_EQUAL_UINT8(rates[dr].sf, modulation.sf);
+        TEST_ASSERT_EQUAL_UINT16(rates[dr].bw, modulation.bw);
+
+        uint8_t maxPayload = loraMaxPayload(band, (LoRaDR_e) dr);
+        TEST_ASSERT_GREATER_THAN(0, maxPayload);
+        for (uint16_t len = 0; len <= maxPayload; len++) {
+            uint8_t phyLen = (uint8_t) (len + LORAWAN_OVERHEAD);
+            double reference = semtechAirtimeMs(rates[dr].sf, rates[dr].bw, phyLen);
+            TEST_ASSERT_EQUAL_UINT32((uint32_t) lround(reference * 1000), loraAirtimeUs(modulation, phyLen));
+            TEST_ASSERT_EQUAL_UINT32((uint32_t) ceil(reference), loraWanAirtimeMs(band, (LoRaDR_e) dr, (uint8_t) len));
+        }
+    }
+}
+
+void setUp(void) { }
+
+void tearDown(void) { }
+
+void test_eu868(void) {
+    assertBand(EU868, EU868_RATES);
+}
+
+void test_us915(void) {
+    assertBand(US915, US915_RATES);
+}
+
+void test_au920(void) {
+    assertBand(AU920, US915_RATES);
+}
+
+void test_known_values(void) {
+    // 51 byte PHY payloads: 100.25 symbols of 1.024 ms at SF7, 75.25 symbols of 32.768 ms at SF12 (low data rate
+    // optimization)
+    TEST_ASSERT_EQUAL_UINT32(102656, loraAirtimeUs({7, 125}, 51));
+    TEST_ASSERT_EQUAL_UINT32(2465792, loraAirtimeUs({12, 125}, 51));
+
+    // The station uplink at AU920 DR0 (SF10): an 11 byte payload, 45.25 symbols of 8.192 ms
+    TEST_ASSERT_EQUAL_UINT32(371, loraWanAirtimeMs(AU920, DR0, 11));
+}
+
+void test_confirmed_transmissions(void) {
+    TEST_ASSERT_EQUAL_UINT8(1, loraConfirmedTransmissions(NULL));
+    TEST_ASSERT_EQUAL_UINT8(1, loraConfirmedTransmissions(""));
+    TEST_ASSERT_EQUAL_UINT8(1, loraConfirmedTransmissions("0"));
+    TEST_ASSERT_EQUAL_UINT8(4, loraConfirmedTransmissions("3"));
+    TEST_ASSERT_EQUAL_UINT8(255, loraConfirmedTransmissions("254"));
+    TEST_ASSERT_EQUAL_UINT8(255, loraConfirmedTransmissions("1000"));
+}
+
+int main(int argc, char** argv) {
+    (void) argc;
+    (void) argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_eu868);
+    RUN_TEST(test_us915);
+    RUN_TEST(test_au920);
+    RUN_TEST(test_known_values);
+    RUN_TEST(test_confirmed_transmissions);
+    return UNITY_END();
+}
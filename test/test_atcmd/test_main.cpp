@@ -0,0 +1,109 @@
+/**
+ * @file test_main.cpp
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief ATCmd tests of the native build: command text, overflow and no dynamic memory.
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ *
+ * Allocations are counted by wrapping \c malloc (glibc only, \c operator \c new allocates through it too).
+ */
+#include <unity.h>
+#include "AgroTechLab_ATCmd.h"
+
+static uint32_t allocations = 0;        /**< Calls of malloc since the last reset. */
+
+#if defined(__GLIBC__)
+extern "C" void* __libc_malloc(size_t size);
+
+extern "C" void* malloc(size_t size) {
+    allocations++;
+    return __libc_malloc(size);
+}
+#define MALLOC_WRAPPED                  true
+#else
+#define MALLOC_WRAPPED                  false
+#endif
+
+void setUp(void) { }
+
+void tearDown(void) { }
+
+void test_builds_commands(void) {
+    ATCmd cmd;
+    TEST_ASSERT_EQUAL_STRING("", cmd.c_str());
+
+    cmd.begin(F("AT+DR=")).append("AU920");
+    TEST_ASSERT_EQUAL_STRING("AT+DR=AU920", cmd.c_str());
+    TEST_ASSERT_EQUAL_UINT8(11, cmd.length());
+
+    cmd.begin(F("AT+CH=0,")).append("923.2").append(',').append(F("DR2"));
+    TEST_ASSERT_EQUAL_STRING("AT+CH=0,923.2,DR2", cmd.c_str());
+
+    cmd.begin(F("AT+PORT=")).appendUInt(0).append(',').appendUInt(65535);
+    TEST_ASSERT_EQUAL_STRING("AT+PORT=0,65535", cmd.c_str());
+
+    const uint8_t data[] = { 0x00, 0x7F, 0xA5, 0xFF };
+    cmd.begin(F("AT+CMSGHEX=")).append('"');
+    cmd.appendHex(data, sizeof(data)).append('"');
+    TEST_ASSERT_EQUAL_STRING("AT+CMSGHEX=\"007FA5FF\"", cmd.c_str());
+
+    cmd.begin(F("AT+ID=DevEui,")).appendQuoted("0011223344556677").append((const char*) NULL);
+    TEST_ASSERT_EQUAL_STRING("AT+ID=DevEui,\"0011223344556677\"", cmd.c_str());
+    TEST_ASSERT_FALSE(cmd.overflow());
+}
+
+void test_overflow_truncates(void) {
+    uint8_t data[AT_CMD_BUFFER_SIZE] = {0};
+    ATCmd cmd;
+    cmd.begin(F("AT+MSGHEX=")).appendHex(data, sizeof(data));
+    TEST_ASSERT_TRUE(cmd.overflow());
+    TEST_ASSERT_EQUAL_UINT8(AT_CMD_BUFFER_SIZE - 1, cmd.length());
+    TEST_ASSERT_EQUAL_UINT32(AT_CMD_BUFFER_SIZE - 1, strlen(cmd.c_str()));
+
+    // A new command clears the overflow
+    cmd.begin(F("AT"));
+    TEST_ASSERT_FALSE(cmd.overflow());
+    TEST_ASSERT_EQUAL_STRING("AT", cmd.c_str());
+}
+
+void test_no_dynamic_memory(void) {
+    if (!MALLOC_WRAPPED) {
+        TEST_IGNORE_MESSAGE("malloc can only be wrapped on glibc");
+    }
+
+    // The wrapper works
+    allocations = 0;
+    void* p = malloc(16);
+    free(p);
+    TEST_ASSERT_EQUAL_UINT32(1, allocations);
+
+    const uint8_t data[51] = {0};
+    allocations = 0;
+    for (uint16_t i = 0; i < 100; i++) {
+        ATCmd cmd;
+        cmd.begin(F("AT+CMSGHEX=")).append('"').appendHex(data, sizeof(data)).append('"');
+        cmd.begin(F("AT+CH=")).appendUInt(i).append(',').append("923.2").append(F(",DR2"));
+        cmd.begin(F("AT+KEY=AppSKey,")).appendQuoted("2B7E151628AED2A6ABF7158809CF4F3C");
+        cmd.appendHex(data, sizeof(data));
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, allocations);
+}
+
+int main(int argc, char** argv) {
+    (void) argc;
+    (void) argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_builds_commands);
+    RUN_TEST(test_overflow_truncates);
+    RUN_TEST(test_no_dynamic_memory);
+    return UNITY_END();
+}
@@ -0,0 +1,345 @@
+/**
+ * @file test_main.cpp
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief Batched payload tests of the native build: round trips, compression and the payload size limits of the
+ * data rates.
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#include <math.h>
+#include <stdio.h>
+#include <unity.h>
+#include "AgroTechLab_Airtime.h"
+#include "ats_01_batch.h"
+
+/**
+ * \def DAY_READINGS
+ * Readings of a day trace (one per minute).
+ */
+#define DAY_READINGS                    1440
+
+static uint8_t frames[BATCH_MAX_SAMPLES][PAYLOAD_SIZE];
+static STATION_SENSORS_T samples[BATCH_MAX_SAMPLES];
+static STATION_SENSORS_T day[DAY_READINGS];
+static uint32_t seed = 1;
+
+/** Pseudo-random number in <tt>0 .. range-1</tt> (LCG, the same sequence on every run). */
+static uint32_t nextRandom(uint32_t range) {
+    seed = (seed * 1103515245UL) + 12345UL;
+    return (seed >> 8) % range;
+}
+
+/**
+ * Fill \ref day with the readings of the station simulation (\c ats_01_sim.cpp) over a day: temperature peak at
+ * 15 h, light and UV peak at noon and the battery discharging. A cloudy day has passing clouds (light down to a
+ * fifth and UV index one lower) and DHT noise of one step.
+ */
+static void dayTrace(bool cloudy) {
+    const double PI_12 = 3.14159265358979 / 12.0;
+    seed = 1;
+    bool cloud = false;
+    for (uint16_t i = 0; i < DAY_READINGS; i++) {
+        double hour = i / 60.0;
+        double sun = sin((hour - 6.0) * PI_12);
+        double warmth = sin((hour - 9.0) * PI_12);
+        int32_t noise = cloudy ? ((int32_t) nextRandom(3) - 1) : 0;
+        if (cloudy && (nextRandom(15) == 0)) {
+            cloud = !cloud;
+        }
+        double shade = cloud ? 0.2 : 1.0;
+
+        STATION_SENSORS_T data;
+        data.set(SENSOR_AIR_TEMPERATURE, 10 * (lround(180.0 + (80.0 * warmth)) + noise));
+        data.set(SENSOR_AIR_HUMIDITY, lround(700.0 - (200.0 * warmth)) - noise);
+        data.set(SENSOR_LIGHT, (sun > 0.0) ? lround(60000.0 * sun * shade) : 0);
+        data.set(SENSOR_UV_INDEX, (sun > 0.0) ? (lround(10.0 * sun) - (cloud ? 1 : 0)) : 0);
+        data.set(SENSOR_BATTERY_VOLTAGE, 4100 - (i / 60));
+        day[i] = data;
+    }
+}
+
+/**
+ * Send \ref day through the batch encoder with uplinks of \p size bytes, decoding every payload and comparing it
+ * with the trace.
+ * @return uint32_t - payload bytes sent.
+ */
+static uint32_t sendDay(uint8_t size) {
+    PayloadEncoder<PAYLOAD_BATCH> encoder;
+    uint8_t buf[PayloadEncoder<PAYLOAD_BATCH>::MAX_SIZE];
+    STATION_SENSORS_T held[BATCH_MAX_SAMPLES];
+    uint32_t bytes = 0;
+    uint16_t decoded = 0;
+    for (uint16_t i = 0; i < DAY_READINGS; i++) {
+        uint8_t len = encoder.encode(day[i], buf, size);
+        if (len == 0) {
+            continue;
+        }
+        TEST_ASSERT_LESS_OR_EQUAL(size, len);
+        uint8_t n = decodeBatch(buf, len, samples, BATCH_MAX_SAMPLES);
+        TEST_ASSERT_GREATER_THAN(0, n);
+        for (uint8_t k = 0; k < n; k++) {
+            TEST_ASSERT_EQUAL_UINT8_ARRAY(day[decoded++].bytes, samples[k].bytes, PAYLOAD_SIZE);
+        }
+        encoder.delivered();
+        bytes += len;
+    }
+
+    // The readings left are still held
+    uint8_t n = encoder.release(held);
+    for (uint8_t k = 0; k < n; k++) {
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(day[decoded++].bytes, held[k].bytes, PAYLOAD_SIZE);
+    }
+    TEST_ASSERT_EQUAL_UINT16(DAY_READINGS, decoded);
+    return bytes;
+}
+
+/** Fill \ref frames with a slow morning trace (temperature and light rising, the other fields steady). */
+static void morningTrace() {
+    for (uint8_t i = 0; i < BATCH_MAX_SAMPLES; i++) {
+        STATION_SENSORS_T data;
+        data.set(SENSOR_AIR_TEMPERATURE, 1500 + (12 * i));
+        data.set(SENSOR_AIR_HUMIDITY, 820 - (i / 2));
+        data.set(SENSOR_LIGHT, 2000 + (450 * i));
+        data.set(SENSOR_UV_INDEX, 1);
+        data.set(SENSOR_BATTERY_VOLTAGE, 3900);
+        encodePayload(data, frames[i]);
+    }
+}
+
+/** Decode \p buf and compare it with the first \p count readings of \ref frames. */
+static void assertBatch(const uint8_t* buf, uint8_t len, uint8_t count) {
+    TEST_ASSERT_EQUAL_UINT8(count, decodeBatch(buf, len, samples, BATCH_MAX_SAMPLES));
+    for (uint8_t i = 0; i < count; i++) {
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(frames[i], samples[i].bytes, PAYLOAD_SIZE);
+    }
+}
+
+void setUp(void) { }
+
+void tearDown(void) { }
+
+void test_round_trip(void) {
+    uint8_t buf[BATCH_MAX_PAYLOAD];
+    morningTrace();
+    for (uint8_t count = 1; count <= BATCH_MAX_SAMPLES; count++) {
+        uint8_t len = encodeBatch(frames, count, buf, sizeof(buf));
+        TEST_ASSERT_GREATER_THAN(0, len);
+        assertBatch(buf, len, count);
+    }
+
+    // Fields at their limits, with invalid fields in between
+    STATION_SENSORS_T low;
+    STATION_SENSORS_T high;
+    low.set(SENSOR_AIR_TEMPERATURE, -8192);
+    low.set(SENSOR_LIGHT, 0);
+    high.set(SENSOR_AIR_TEMPERATURE, 8191);
+    high.set(SENSOR_AIR_HUMIDITY, 1023);
+    high.set(SENSOR_LIGHT, 65535);
+    high.set(SENSOR_UV_INDEX, 15);
+    high.set(SENSOR_BATTERY_VOLTAGE, 16383);
+    for (uint8_t i = 0; i < 3; i++) {
+        encodePayload(((i % 2) == 0) ? low : high, frames[i]);
+    }
+    uint8_t len = encodeBatch(frames, 3, buf, sizeof(buf));
+    TEST_ASSERT_GREATER_THAN(0, len);
+    assertBatch(buf, len, 3);
+}
+
+void test_compression(void) {
+    uint8_t buf[BATCH_MAX_PAYLOAD];
+    morningTrace();
+    uint8_t len = encodeBatch(frames, BATCH_MAX_SAMPLES, buf, sizeof(buf));
+    TEST_ASSERT_GREATER_THAN(0, len);
+    TEST_ASSERT_LESS_THAN(BATCH_MAX_SAMPLES * PAYLOAD_SIZE, len);
+
+    // Steady readings: every field is one run of zeros
+    for (uint8_t i = 1; i < BATCH_MAX_SAMPLES; i++) {
+        memcpy(frames[i], frames[0], PAYLOAD_SIZE);
+    }
+    len = encodeBatch(frames, BATCH_MAX_SAMPLES, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_UINT8(1 + PAYLOAD_SIZE + (2 * PAYLOAD_FIELDS), len);
+    assertBatch(buf, len, BATCH_MAX_SAMPLES);
+}
+
+void test_size_limit(void) {
+    uint8_t buf[BATCH_MAX_PAYLOAD];
+    morningTrace();
+    uint8_t full = encodeBatch(frames, BATCH_MAX_SAMPLES, buf, sizeof(buf));
+
+    // Nothing is written past the size: a smaller buffer fails cleanly
+    for (uint8_t size = 0; size < full; size++) {
+        memset(buf, 0xA5, sizeof(buf));
+        TEST_ASSERT_EQUAL_UINT8(0, encodeBatch(frames, BATCH_MAX_SAMPLES, buf, size));
+        for (uint8_t i = size; i < sizeof(buf); i++) {
+            TEST_ASSERT_EQUAL_HEX8(0xA5, buf[i]);
+        }
+    }
+
+    // One reading is the header plus a packed frame
+    TEST_ASSERT_EQUAL_UINT8(1 + PAYLOAD_SIZE, encodeBatch(frames, 1, buf, 1 + PAYLOAD_SIZE));
+}
+
+void test_backlog_fits_every_data_rate(void) {
+    const LoRaBand_e bands[] = { EU868, US915, AU920 };
+    uint8_t buf[BATCH_MAX_PAYLOAD];
+    morningTrace();
+
+    for (uint8_t b = 0; b < 3; b++) {
+        for (uint8_t dr = DR0; dr <= DR15; dr++) {
+            uint8_t maxPayload = loraMaxPayload(bands[b], (LoRaDR_e) dr);
+            if (maxPayload == 0) {
+                continue;
+            }
+
+            // Room of a backlog uplink (after the sequence number), as in sendBacklog()
+            uint8_t room = (uint8_t) (maxPayload - 2);
+            if (room > BATCH_MAX_PAYLOAD) {
+                room = BATCH_MAX_PAYLOAD;
+            }
+            uint8_t n = BATCH_MAX_SAMPLES;
+            uint8_t len = 0;
+            while ((n > 0) && ((len = encodeBatch(frames, n, buf, room)) == 0)) {
+                n--;
+            }
+            TEST_ASSERT_GREATER_THAN(0, n);
+            TEST_ASSERT_LESS_OR_EQUAL(maxPayload, len + 2);
+            assertBatch(buf, len, n);
+        }
+    }
+
+    // The slowest data rate of AU920 / US915 carries one reading per uplink
+    TEST_ASSERT_EQUAL_UINT8(11, loraMaxPayload(AU920, DR0));
+    TEST_ASSERT_EQUAL_UINT8(11, loraMaxPayload(US915, DR0));
+    TEST_ASSERT_EQUAL_UINT8(51, loraMaxPayload(EU868, DR0));
+    TEST_ASSERT_EQUAL_UINT8(0, loraMaxPayload(AU920, DR5));
+}
+
+void test_encoder_accumulates(void) {
+    PayloadEncoder<PAYLOAD_BATCH> encoder;
+    uint8_t buf[PayloadEncoder<PAYLOAD_BATCH>::MAX_SIZE];
+    morningTrace();
+
+    for (uint8_t i = 0; i < (BATCH_MAX_SAMPLES - 1); i++) {
+        STATION_SENSORS_T data;
+        memcpy(data.bytes, frames[i], PAYLOAD_SIZE);
+        TEST_ASSERT_EQUAL_UINT8(0, encoder.encode(data, buf));
+    }
+    STATION_SENSORS_T last;
+    memcpy(last.bytes, frames[BATCH_MAX_SAMPLES - 1], PAYLOAD_SIZE);
+    uint8_t len = encoder.encode(last, buf);
+    TEST_ASSERT_GREATER_THAN(0, len);
+    assertBatch(buf, len, BATCH_MAX_SAMPLES);
+
+    // reset() drops the readings not sent yet
+    encoder.delivered();
+    encoder.encode(last, buf);
+    encoder.reset();
+    for (uint8_t i = 0; i < (BATCH_MAX_SAMPLES - 1); i++) {
+        TEST_ASSERT_EQUAL_UINT8(0, encoder.encode(last, buf));
+    }
+}
+
+void test_encoder_fits_the_uplink(void) {
+    PayloadEncoder<PAYLOAD_BATCH> encoder;
+    uint8_t buf[PayloadEncoder<PAYLOAD_BATCH>::MAX_SIZE];
+    morningTrace();
+
+    // AU920 DR0: a second reading never fits 11 bytes, so every reading is sent at once
+    uint8_t room = loraMaxPayload(AU920, DR0);
+    TEST_ASSERT_TRUE(payloadFits<PAYLOAD_BATCH>(room));
+    for (uint8_t i = 0; i < BATCH_MAX_SAMPLES; i++) {
+        STATION_SENSORS_T data;
+        memcpy(data.bytes, frames[i], PAYLOAD_SIZE);
+        uint8_t len = encoder.encode(data, buf, room);
+        TEST_ASSERT_EQUAL_UINT8(1 + PAYLOAD_SIZE, len);
+        TEST_ASSERT_EQUAL_UINT8(1, decodeBatch(buf, len, samples, BATCH_MAX_SAMPLES));
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(frames[i], samples[0].bytes, PAYLOAD_SIZE);
+        encoder.delivered();
+    }
+
+    // A smaller room than the whole batch: the reading that does not fit waits for the next one
+    uint8_t full = encodeBatch(frames, BATCH_MAX_SAMPLES, buf, sizeof(buf));
+    uint8_t sent = 0;
+    for (uint8_t i = 0; i < BATCH_MAX_SAMPLES; i++) {
+        STATION_SENSORS_T data;
+        memcpy(data.bytes, frames[i], PAYLOAD_SIZE);
+        uint8_t len = encoder.encode(data, buf, (uint8_t) (full - 1));
+        if (len > 0) {
+            TEST_ASSERT_LESS_THAN(full, len);
+            sent = decodeBatch(buf, len, samples, BATCH_MAX_SAMPLES);
+            encoder.delivered();
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT8(BATCH_MAX_SAMPLES - 1, sent);
+    STATION_SENSORS_T held[BATCH_MAX_SAMPLES];
+    TEST_ASSERT_EQUAL_UINT8(1, encoder.release(held));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(frames[BATCH_MAX_SAMPLES - 1], held[0].bytes, PAYLOAD_SIZE);
+    TEST_ASSERT_FALSE(payloadFits<PAYLOAD_BATCH>(PAYLOAD_SIZE));
+}
+
+void test_encoder_releases_undelivered_readings(void) {
+    // A deferred or failed batch gives back every reading it holds, oldest first, for the log
+    PayloadEncoder<PAYLOAD_BATCH> encoder;
+    uint8_t buf[PayloadEncoder<PAYLOAD_BATCH>::MAX_SIZE];
+    STATION_SENSORS_T held[BATCH_MAX_SAMPLES];
+    morningTrace();
+    for (uint8_t i = 0; i < BATCH_MAX_SAMPLES; i++) {
+        STATION_SENSORS_T data;
+        memcpy(data.bytes, frames[i], PAYLOAD_SIZE);
+        encoder.encode(data, buf);
+    }
+    TEST_ASSERT_EQUAL_UINT8(BATCH_MAX_SAMPLES, encoder.release(held));
+    for (uint8_t i = 0; i < BATCH_MAX_SAMPLES; i++) {
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(frames[i], held[i].bytes, PAYLOAD_SIZE);
+    }
+    TEST_ASSERT_EQUAL_UINT8(0, encoder.release(held));
+
+    // Readings accumulated and not sent yet are released too
+    STATION_SENSORS_T data;
+    memcpy(data.bytes, frames[2], PAYLOAD_SIZE);
+    TEST_ASSERT_EQUAL_UINT8(0, encoder.encode(data, buf));
+    TEST_ASSERT_EQUAL_UINT8(1, encoder.release(held));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(frames[2], held[0].bytes, PAYLOAD_SIZE);
+}
+
+void test_compression_of_day_traces(void) {
+    // Days of the station simulation through the uplinks of the station data rates: no reading is lost, a batch
+    // of 51 bytes carries the readings in two thirds of their packed frames, and at AU920 DR0 every reading goes
+    // alone (its packed frame plus the count)
+    char text[96];
+    for (uint8_t cloudy = 0; cloudy < 2; cloudy++) {
+        dayTrace(cloudy != 0);
+        TEST_ASSERT_EQUAL_UINT32(DAY_READINGS * (1 + PAYLOAD_SIZE), sendDay(loraMaxPayload(AU920, DR0)));
+
+        uint32_t bytes = sendDay(BATCH_MAX_PAYLOAD);
+        double ratio = (double) (DAY_READINGS * PAYLOAD_SIZE) / bytes;
+        TEST_ASSERT_TRUE(ratio >= 1.5);
+        snprintf(text, sizeof(text), "%s day: %lu bytes in %u byte batches, ratio %.2f", cloudy ? "cloudy" : "clear",
+                 (unsigned long) bytes, (unsigned int) BATCH_MAX_PAYLOAD, ratio);
+        TEST_MESSAGE(text);
+    }
+}
+
+int main(int argc, char** argv) {
+    (void) argc;
+    (void) argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_round_trip);
+    RUN_TEST(test_compression);
+    RUN_TEST(test_size_limit);
+    RUN_TEST(test_backlog_fits_every_data_rate);
+    RUN_TEST(test_encoder_accumulates);
+    RUN_TEST(test_encoder_fits_the_uplink);
+    RUN_TEST(test_encoder_releases_undelivered_readings);
+    RUN_TEST(test_compression_of_day_traces);
+    return UNITY_END();
+}
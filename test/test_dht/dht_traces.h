@@ -0,0 +1,94 @@
+/**
+ * @file dht_traces.h
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief DHT22 edge traces of the data line (level after the edge, 16-bit us timer as seen by the pin interrupt),
+ * replayed by the DHT decoder tests.
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ *
+ * Every trace starts when the MCU releases the line after the start signal and ends when the sensor releases it.
+ * Pulse lengths have the spread of a real sensor (0 bits 22 .. 30 us, 1 bits 66 .. 76 us).
+ */
+#ifndef __DHT_TRACES_H__
+#define __DHT_TRACES_H__
+
+#include <stdint.h>
+
+/**
+ * @struct DhtEdge_t
+ * @brief Edge of a trace.
+ */
+typedef struct {
+    uint8_t level;          /**< Line level after the edge. */
+    uint16_t us;            /**< Edge time (in us). */
+} DhtEdge_t;
+
+/** 65.2 %, 35.1 oC, with the 16-bit timer wrapping around during the frame. */
+static const DhtEdge_t TRACE_WARM[] = {
+    {1, 65000}, {0, 65024}, {1, 65103}, {0, 65181}, {1, 65236}, {0, 65260}, {1, 65309}, {0, 65336},
+    {1, 65385}, {0, 65410}, {1, 65462}, {0, 65484}, {1,     1}, {0,    25}, {1,    81}, {0,   109},
+    {1,   157}, {0,   232}, {1,   280}, {0,   306}, {1,   358}, {0,   430}, {1,   481}, {0,   505},
+    {1,   554}, {0,   584}, {1,   632}, {0,   659}, {1,   712}, {0,   782}, {1,   832}, {0,   904},
+    {1,   956}, {0,   986}, {1,  1036}, {0,  1062}, {1,  1114}, {0,  1138}, {1,  1192}, {0,  1214},
+    {1,  1267}, {0,  1297}, {1,  1345}, {0,  1373}, {1,  1425}, {0,  1455}, {1,  1507}, {0,  1537},
+    {1,  1591}, {0,  1619}, {1,  1669}, {0,  1739}, {1,  1792}, {0,  1820}, {1,  1868}, {0,  1938},
+    {1,  1994}, {0,  2024}, {1,  2080}, {0,  2152}, {1,  2208}, {0,  2280}, {1,  2329}, {0,  2396},
+    {1,  2451}, {0,  2522}, {1,  2571}, {0,  2643}, {1,  2697}, {0,  2763}, {1,  2814}, {0,  2888},
+    {1,  2939}, {0,  3011}, {1,  3059}, {0,  3082}, {1,  3137}, {0,  3206}, {1,  3256}, {0,  3322},
+    {1,  3378}, {0,  3450}, {1,  3503}, {0,  3527}, {1,  3577}
+};
+
+/** 98.7 %, -10.1 oC, with a noise spike before the response. */
+static const DhtEdge_t TRACE_FROST[] = {
+    {1,  1200}, {0,  1230}, {1,  1242}, {0,  1245}, {1,  1325}, {0,  1406}, {1,  1461}, {0,  1483},
+    {1,  1532}, {0,  1562}, {1,  1612}, {0,  1637}, {1,  1686}, {0,  1708}, {1,  1759}, {0,  1787},
+    {1,  1836}, {0,  1860}, {1,  1915}, {0,  1981}, {1,  2030}, {0,  2103}, {1,  2159}, {0,  2227},
+    {1,  2279}, {0,  2355}, {1,  2410}, {0,  2439}, {1,  2488}, {0,  2564}, {1,  2617}, {0,  2684},
+    {1,  2736}, {0,  2759}, {1,  2807}, {0,  2875}, {1,  2931}, {0,  3002}, {1,  3051}, {0,  3122},
+    {1,  3171}, {0,  3195}, {1,  3249}, {0,  3275}, {1,  3325}, {0,  3347}, {1,  3396}, {0,  3421},
+    {1,  3474}, {0,  3497}, {1,  3548}, {0,  3578}, {1,  3630}, {0,  3659}, {1,  3708}, {0,  3732},
+    {1,  3780}, {0,  3850}, {1,  3899}, {0,  3974}, {1,  4029}, {0,  4054}, {1,  4108}, {0,  4135},
+    {1,  4184}, {0,  4258}, {1,  4308}, {0,  4330}, {1,  4381}, {0,  4453}, {1,  4501}, {0,  4570},
+    {1,  4621}, {0,  4694}, {1,  4748}, {0,  4770}, {1,  4824}, {0,  4853}, {1,  4905}, {0,  4930},
+    {1,  4981}, {0,  5004}, {1,  5056}, {0,  5123}, {1,  5173}, {0,  5241}, {1,  5291}
+};
+
+/** 45.0 %, 21.3 oC, with bit 20 misread (checksum mismatch). */
+static const DhtEdge_t TRACE_GLITCH[] = {
+    {1, 30000}, {0, 30040}, {1, 30120}, {0, 30198}, {1, 30246}, {0, 30275}, {1, 30325}, {0, 30351},
+    {1, 30399}, {0, 30428}, {1, 30476}, {0, 30502}, {1, 30550}, {0, 30575}, {1, 30630}, {0, 30655},
+    {1, 30710}, {0, 30740}, {1, 30794}, {0, 30862}, {1, 30915}, {0, 30986}, {1, 31038}, {0, 31104},
+    {1, 31158}, {0, 31181}, {1, 31231}, {0, 31261}, {1, 31314}, {0, 31340}, {1, 31396}, {0, 31422},
+    {1, 31473}, {0, 31543}, {1, 31595}, {0, 31625}, {1, 31675}, {0, 31702}, {1, 31758}, {0, 31787},
+    {1, 31842}, {0, 31866}, {1, 31922}, {0, 31947}, {1, 32002}, {0, 32072}, {1, 32125}, {0, 32148},
+    {1, 32202}, {0, 32232}, {1, 32283}, {0, 32307}, {1, 32356}, {0, 32422}, {1, 32476}, {0, 32547},
+    {1, 32598}, {0, 32620}, {1, 32676}, {0, 32750}, {1, 32800}, {0, 32825}, {1, 32881}, {0, 32952},
+    {1, 33000}, {0, 33030}, {1, 33083}, {0, 33149}, {1, 33198}, {0, 33272}, {1, 33320}, {0, 33343},
+    {1, 33392}, {0, 33415}, {1, 33465}, {0, 33535}, {1, 33591}, {0, 33661}, {1, 33714}, {0, 33742},
+    {1, 33798}, {0, 33828}, {1, 33881}, {0, 33908}, {1, 33958}
+};
+
+/** 45.0 %, 21.3 oC, the capture stops before the last 3 bits. */
+static const DhtEdge_t TRACE_TRUNCATED[] = {
+    {1, 40000}, {0, 40021}, {1, 40100}, {0, 40186}, {1, 40239}, {0, 40265}, {1, 40313}, {0, 40338},
+    {1, 40389}, {0, 40411}, {1, 40460}, {0, 40487}, {1, 40539}, {0, 40561}, {1, 40614}, {0, 40637},
+    {1, 40686}, {0, 40715}, {1, 40768}, {0, 40836}, {1, 40886}, {0, 40959}, {1, 41011}, {0, 41083},
+    {1, 41137}, {0, 41164}, {1, 41214}, {0, 41242}, {1, 41294}, {0, 41319}, {1, 41375}, {0, 41400},
+    {1, 41453}, {0, 41519}, {1, 41574}, {0, 41600}, {1, 41656}, {0, 41686}, {1, 41737}, {0, 41760},
+    {1, 41810}, {0, 41835}, {1, 41887}, {0, 41917}, {1, 41967}, {0, 41996}, {1, 42044}, {0, 42070},
+    {1, 42121}, {0, 42145}, {1, 42194}, {0, 42224}, {1, 42279}, {0, 42350}, {1, 42400}, {0, 42474},
+    {1, 42528}, {0, 42551}, {1, 42604}, {0, 42673}, {1, 42727}, {0, 42751}, {1, 42806}, {0, 42878},
+    {1, 42934}, {0, 42956}, {1, 43010}, {0, 43086}, {1, 43141}, {0, 43217}, {1, 43272}, {0, 43299},
+    {1, 43350}, {0, 43376}, {1, 43424}, {0, 43491}, {1, 43540}, {0, 43608}
+};
+
+#endif // __DHT_TRACES_H__
@@ -0,0 +1,156 @@
+/**
+ * @file test_main.cpp
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief DHT22 decoder tests of the native build: replay of edge traces (see dht_traces.h) and of the frames of
+ * \ref SimulatedDht.
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#include <unity.h>
+#include "ats_01_hal.h"
+#include "dht_traces.h"
+
+static DhtDecoder decoder;
+
+/** Feed \p n edges of \p trace into \ref decoder (as the pin interrupt does). */
+static void replay(const DhtEdge_t* trace, uint8_t n) {
+    decoder.reset();
+    for (uint8_t i = 0; i < n; i++) {
+        decoder.edge(trace[i].level != 0, trace[i].us);
+    }
+}
+
+#define REPLAY(trace)                   replay(trace, (uint8_t) (sizeof(trace) / sizeof(trace[0])))
+
+void setUp(void) { }
+
+void tearDown(void) { }
+
+void test_replay_timer_wrap(void) {
+    uint8_t data[DHT_FRAME_BYTES];
+    REPLAY(TRACE_WARM);
+    TEST_ASSERT_TRUE(decoder.complete());
+    TEST_ASSERT_EQUAL_UINT8(DHT_PULSES, decoder.pulses());
+    TEST_ASSERT_TRUE(decoder.decode(data));
+    TEST_ASSERT_EQUAL_UINT16(652, dhtHumidity(data));
+    TEST_ASSERT_EQUAL_INT16(351, dhtTemperature(data));
+}
+
+void test_replay_negative_temperature_and_noise(void) {
+    uint8_t data[DHT_FRAME_BYTES];
+    REPLAY(TRACE_FROST);
+    TEST_ASSERT_TRUE(decoder.decode(data));
+    TEST_ASSERT_EQUAL_UINT16(987, dhtHumidity(data));
+    TEST_ASSERT_EQUAL_INT16(-101, dhtTemperature(data));
+}
+
+void test_replay_checksum_mismatch(void) {
+    uint8_t data[DHT_FRAME_BYTES];
+    REPLAY(TRACE_GLITCH);
+    TEST_ASSERT_TRUE(decoder.complete());
+    TEST_ASSERT_FALSE(decoder.decode(data));
+}
+
+void test_replay_truncated(void) {
+    uint8_t data[DHT_FRAME_BYTES];
+    REPLAY(TRACE_TRUNCATED);
+    TEST_ASSERT_FALSE(decoder.complete());
+    TEST_ASSERT_EQUAL_UINT8(DHT_PULSES - 3, decoder.pulses());
+    TEST_ASSERT_FALSE(decoder.decode(data));
+}
+
+void test_reset_between_frames(void) {
+    uint8_t data[DHT_FRAME_BYTES];
+
+    // A frame cut in the middle does not leak into the next one
+    replay(TRACE_GLITCH, 40);
+    REPLAY(TRACE_WARM);
+    TEST_ASSERT_TRUE(decoder.decode(data));
+    TEST_ASSERT_EQUAL_UINT16(652, dhtHumidity(data));
+
+    // Edges after a complete frame are ignored
+    decoder.edge(true, 4000);
+    decoder.edge(false, 4070);
+    TEST_ASSERT_EQUAL_UINT8(DHT_PULSES, decoder.pulses());
+    TEST_ASSERT_TRUE(decoder.decode(data));
+    TEST_ASSERT_EQUAL_INT16(351, dhtTemperature(data));
+}
+
+void test_simulated_sensor_range(void) {
+    SimulatedDht dht(2, decoder);
+    uint8_t data[DHT_FRAME_BYTES];
+    const int16_t temperatures[] = { -400, -1, 0, 1, 251, 800 };
+    const uint16_t humidities[] = { 0, 1, 500, 999, 1000 };
+
+    for (uint8_t t = 0; t < 6; t++) {
+        for (uint8_t h = 0; h < 5; h++) {
+            dht.temperature = temperatures[t];
+            dht.humidity = humidities[h];
+            dht.start();
+            TEST_ASSERT_TRUE(decoder.decode(data));
+            TEST_ASSERT_EQUAL_INT16(temperatures[t], dhtTemperature(data));
+            TEST_ASSERT_EQUAL_UINT16(humidities[h], dhtHumidity(data));
+        }
+    }
+
+    // Corrupted frames are rejected
+    dht.failEvery = 2;
+    dht.frames = 0;
+    dht.start();
+    TEST_ASSERT_TRUE(decoder.decode(data));
+    dht.start();
+    TEST_ASSERT_FALSE(decoder.decode(data));
+}
+
+void test_capture_across_adc_reads(void) {
+    // The UV and battery reads run between the DHT22 start and the end of its frame: the edges that come while
+    // the I/O clock is stopped are lost (INT0 edge detection)
+    SimulatedAdc adc;
+    const uint8_t pins[] = { A0, A1 };
+    uint16_t result;
+    uint8_t data[DHT_FRAME_BYTES];
+    uint16_t stopUs = 0;
+    uint32_t stoppedUs = 0;
+
+    decoder.reset();
+    for (uint8_t i = 0; i < (sizeof(TRACE_WARM) / sizeof(TRACE_WARM[0])); i++) {
+        if ((i == 10) || (i == 40)) {
+            uint32_t before = adc.ioStoppedUs;
+            adc.read(&pins[(i == 10) ? 0 : 1], 1, &result);
+            stopUs = TRACE_WARM[i].us;
+            stoppedUs = adc.ioStoppedUs - before;
+        }
+        if ((uint16_t) (TRACE_WARM[i].us - stopUs) < stoppedUs) {
+            continue;
+        }
+        decoder.edge(TRACE_WARM[i].level != 0, TRACE_WARM[i].us);
+    }
+    TEST_ASSERT_EQUAL_UINT32(2 * AdcSequence::conversions(1), adc.conversions);
+    TEST_ASSERT_TRUE(decoder.decode(data));
+    TEST_ASSERT_EQUAL_UINT16(652, dhtHumidity(data));
+    TEST_ASSERT_EQUAL_INT16(351, dhtTemperature(data));
+    TEST_ASSERT_EQUAL_UINT32(0, adc.ioStoppedUs);
+}
+
+int main(int argc, char** argv) {
+    (void) argc;
+    (void) argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_replay_timer_wrap);
+    RUN_TEST(test_replay_negative_temperature_and_noise);
+    RUN_TEST(test_replay_checksum_mismatch);
+    RUN_TEST(test_replay_truncated);
+    RUN_TEST(test_reset_between_frames);
+    RUN_TEST(test_simulated_sensor_range);
+    RUN_TEST(test_capture_across_adc_reads);
+    return UNITY_END();
+}
@@ -0,0 +1,325 @@
+/**
+ * @file test_main.cpp
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief Fixed-point sensor path tests of the native build: accuracy of the integer conversions against exact
+ * math, and an operation count / flash size comparison with the float path they replaced.
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ *
+ * The MCU costs are estimates: the operations of both paths are counted on the host with \ref Counted and weighted
+ * by the typical cycles and flash bytes of the avr-gcc runtime routines on the ATmega328p (\ref FLOAT_COST and
+ * \ref INT32_COST). Replace them with simulator and \c avr-size figures when an AVR toolchain is at hand.
+ */
+#include <math.h>
+#include <stdio.h>
+#include <unity.h>
+#include "ats_01_payload.h"
+#include "ats_01_station.h"
+
+uint16_t getBatteryVoltage(uint16_t adcValue);
+
+/**
+ * \def ADC_CODES
+ * Codes of an oversampled read (<tt>ADC_BITS + ADC_OVERSAMPLING_BITS</tt> bits).
+ */
+#define ADC_CODES                       (1UL << (ADC_BITS + ADC_OVERSAMPLING_BITS))
+
+/**
+ * @enum OpKind_e
+ * @brief Arithmetic operations counted by \ref Counted.
+ */
+typedef enum {
+    OP_ADD,         /**< Addition, subtraction or shift. */
+    OP_MUL,         /**< Multiplication. */
+    OP_DIV,         /**< Division. */
+    OP_CMP,         /**< Comparison. */
+    OP_CONV,        /**< Conversion between integer and float. */
+    OP_KINDS
+} OpKind_e;
+
+/**
+ * @struct OpCost_t
+ * @brief Estimated ATmega328p cost of an operation: cycles of a call and flash bytes of its runtime routine
+ * (0 if inlined).
+ */
+typedef struct {
+    uint16_t cycles;
+    uint16_t flash;
+} OpCost_t;
+
+/** Soft-float costs (avr-libc \c libm: \c __addsf3, \c __mulsf3, \c __divsf3, \c __cmpsf2, \c __floatunsisf / \c __fixsfsi). */
+static const OpCost_t FLOAT_COST[OP_KINDS] = { { 110, 360 }, { 150, 220 }, { 490, 190 }, { 50, 60 }, { 70, 230 } };
+
+/** 32 bits integer costs (inline add, shift and compare, \c __mulsi3 with the hardware multiplier, \c __udivmodsi4). */
+static const OpCost_t INT32_COST[OP_KINDS] = { { 4, 0 }, { 40, 40 }, { 600, 100 }, { 4, 0 }, { 2, 0 } };
+
+static uint32_t floatOps[OP_KINDS];
+static uint32_t intOps[OP_KINDS];
+
+/**
+ * @class Counted
+ * @brief Number of type \p T that counts its arithmetic operations (into \ref floatOps or \ref intOps).
+ */
+template <typename T>
+class Counted {
+    private:
+        T v;
+
+        static void count(OpKind_e kind) {
+            if (((T) 0.5) != 0) {
+                floatOps[kind]++;
+            } else {
+                intOps[kind]++;
+            }
+        }
+
+    public:
+        explicit Counted(T value) : v(value) { }
+
+        /** Conversion from another type (an integer to float conversion counts). */
+        template <typename U>
+        static Counted from(U value) {
+            count(OP_CONV);
+            return Counted((T) value);
+        }
+
+        /** Conversion to another type (a float to integer conversion counts). */
+        template <typename U>
+        U to() const {
+            count(OP_CONV);
+            return (U) v;
+        }
+
+        T value() const { return v; }
+
+        Counted operator+(const Counted& b) const { count(OP_ADD); return Counted(v + b.v); }
+        Counted operator-(const Counted& b) const { count(OP_ADD); return Counted(v - b.v); }
+        Counted operator*(const Counted& b) const { count(OP_MUL); return Counted(v * b.v); }
+        Counted operator/(const Counted& b) const { count(OP_DIV); return Counted(v / b.v); }
+        Counted operator>>(uint8_t n) const { count(OP_ADD); return Counted(v >> n); }
+        bool operator<(const Counted& b) const { count(OP_CMP); return v < b.v; }
+        bool operator>(const Counted& b) const { count(OP_CMP); return v > b.v; }
+        bool operator>=(const Counted& b) const { count(OP_CMP); return v >= b.v; }
+        bool operator!=(const Counted& b) const { count(OP_CMP); return v != b.v; }
+};
+
+typedef Counted<float> Float;
+typedef Counted<int32_t> Int;
+typedef Counted<uint32_t> UInt;
+
+/** Divider ratio of the float path (a compile time constant there). */
+static const float DIVIDER_RATIO = (float) voltageSensor_R2 / (float) (voltageSensor_R1 + voltageSensor_R2);
+
+/** Battery voltage factor of the fixed path (as \c batteryMvPerStepQ16). */
+static const uint32_t MV_PER_STEP_Q16 = (uint32_t) (((((uint64_t) adcVref_mV * (voltageSensor_R1 + voltageSensor_R2)) << 16) +
+    ((uint64_t) voltageSensor_R2 << (ADC_BITS + ADC_OVERSAMPLING_BITS - 1))) / ((uint64_t) voltageSensor_R2 * ADC_CODES));
+
+/**
+ * Uplink fields of a reading: air temperature (0.1 oC), air humidity (0.5 %, \c UINT8_MAX if invalid) and battery
+ * voltage (10 mV), or the record units with the packed format.
+ */
+typedef struct {
+    int16_t temperature;
+    uint16_t humidity;
+    uint16_t battery;
+} UplinkFields_t;
+
+/** Float path: \p value scaled by \p scale to a rounded non negative integer, \p invalid out of <tt>0 .. max</tt>. */
+static uint16_t floatToUInt(Float value, float scale, uint16_t max, uint16_t invalid) {
+    Float scaled = (value * Float(scale)) + Float(0.5f);
+    if ((value != value) || (scaled < Float(0.0f)) || (scaled >= Float((float) max + 1.0f))) {
+        return invalid;
+    }
+    return scaled.to<uint16_t>();
+}
+
+/**
+ * Float path of a reading, from the sensor outputs (DHT22 frame values in 0.1 units and the battery ADC read) to
+ * the uplink fields: values kept in oC, % and V, as the station did before the fixed-point record.
+ */
+static UplinkFields_t floatPath(int16_t dhtTemperature, uint16_t dhtHumidity, uint16_t adcValue) {
+    UplinkFields_t fields;
+    Float temperature = Float::from(dhtTemperature) / Float(10.0f);
+    Float humidity = Float::from(dhtHumidity) / Float(10.0f);
+    Float vout = (Float::from(adcValue) * Float(adcVref_mV / 1000.0f)) / Float((float) ADC_CODES);
+    Float battery = vout / Float(DIVIDER_RATIO);
+    if ((temperature < Float(-40.0f)) || (temperature > Float(80.0f))) {
+        temperature = Float(__FLT_MAX__);
+    }
+    if ((humidity < Float(0.0f)) || (humidity > Float(100.0f))) {
+        humidity = Float(__FLT_MAX__);
+    }
+
+    fields.temperature = INT16_MIN;
+    if ((temperature != Float(__FLT_MAX__)) && (temperature > Float(-3276.0f)) && (temperature < Float(3276.0f))) {
+        Float scaled = temperature * Float(10.0f);
+        fields.temperature = (scaled + Float((scaled < Float(0.0f)) ? -0.5f : 0.5f)).to<int16_t>();
+    }
+    fields.humidity = floatToUInt(humidity, 2.0f, 200, UINT8_MAX);
+    fields.battery = floatToUInt(battery, 100.0f, UINT16_MAX - 1, UINT16_MAX);
+    return fields;
+}
+
+/** Fixed path: integer division rounding half away from zero (as \c divRound() of \c ats_01_payload.h). */
+static Int countedDivRound(Int value, int32_t divisor) {
+    Int half(divisor / 2);
+    return ((value < Int(0)) ? (value - half) : (value + half)) / Int(divisor);
+}
+
+/** Fixed path battery voltage (in mV, as \c getBatteryVoltage()). */
+static uint16_t fixedBattery(uint16_t adcValue) {
+    return (uint16_t) (((UInt(adcValue) * UInt(MV_PER_STEP_Q16)) + UInt(0x8000UL)) >> 16).value();
+}
+
+/**
+ * Fixed path of a reading: the record fields in 0.01 oC, 0.1 % and mV (see \c readAirClimate()). The packed
+ * format sends them unchanged; with \p scaled they are scaled to the units of the float path with rounded integer
+ * divisions, as the Cayenne LPP format does.
+ */
+static UplinkFields_t fixedPath(int16_t dhtTemperature, uint16_t dhtHumidity, uint16_t adcValue, bool scaled) {
+    UplinkFields_t fields;
+    Int temperature(dhtTemperature);
+    Int humidity(dhtHumidity);
+    Int battery(fixedBattery(adcValue));
+    bool temperatureOk = !((temperature < Int(-400)) || (temperature > Int(800)));
+    bool humidityOk = !(humidity > Int(1000));
+    if (temperatureOk) {
+        temperature = temperature * Int(10);
+    }
+    if (scaled) {
+        temperature = temperatureOk ? countedDivRound(temperature, 10) : temperature;
+        humidity = humidityOk ? countedDivRound(humidity, 5) : humidity;
+        battery = countedDivRound(battery, 10);
+    }
+
+    fields.temperature = temperatureOk ? (int16_t) temperature.value() : INT16_MIN;
+    fields.humidity = humidityOk ? (uint16_t) humidity.value() : UINT8_MAX;
+    fields.battery = (uint16_t) battery.value();
+    return fields;
+}
+
+/** Estimated cycles of the operations counted in \p ops. */
+static uint32_t cycles(const uint32_t* ops, const OpCost_t* cost) {
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < OP_KINDS; i++) {
+        total += ops[i] * cost[i].cycles;
+    }
+    return total;
+}
+
+/** Estimated flash bytes of the runtime routines used by the operations counted in \p ops. */
+static uint32_t flash(const uint32_t* ops, const OpCost_t* cost) {
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < OP_KINDS; i++) {
+        total += (ops[i] > 0) ? cost[i].flash : 0;
+    }
+    return total;
+}
+
+/** Clear the operation counters. */
+static void clearOps(void) {
+    for (uint8_t i = 0; i < OP_KINDS; i++) {
+        floatOps[i] = 0;
+        intOps[i] = 0;
+    }
+}
+
+void setUp(void) {
+    clearOps();
+}
+
+void tearDown(void) { }
+
+void test_battery_voltage(void) {
+    // The counted mirror is the station conversion, within 1 mV of exact math over every ADC code
+    for (uint32_t code = 0; code < ADC_CODES; code++) {
+        double exact = ((double) code * adcVref_mV * (voltageSensor_R1 + voltageSensor_R2)) / ((double) voltageSensor_R2 * ADC_CODES);
+        TEST_ASSERT_EQUAL_UINT16(getBatteryVoltage((uint16_t) code), fixedBattery((uint16_t) code));
+        TEST_ASSERT_UINT32_WITHIN(1, (uint32_t) lround(exact), getBatteryVoltage((uint16_t) code));
+    }
+}
+
+void test_same_uplink_fields(void) {
+    // Both paths give the same uplink fields over the DHT22 range and the battery reads (the float one may round a
+    // half step the other way)
+    for (int16_t temperature = -400; temperature <= 800; temperature++) {
+        UplinkFields_t f = floatPath(temperature, (uint16_t) ((temperature + 400) % 1001), (uint16_t) (temperature + 400));
+        UplinkFields_t x = fixedPath(temperature, (uint16_t) ((temperature + 400) % 1001), (uint16_t) (temperature + 400), true);
+        TEST_ASSERT_EQUAL_INT16(f.temperature, x.temperature);
+        TEST_ASSERT_UINT32_WITHIN(1, f.humidity, x.humidity);
+        TEST_ASSERT_UINT32_WITHIN(1, f.battery, x.battery);
+    }
+
+    // Out of range DHT22 values are invalid in both
+    UplinkFields_t f = floatPath(801, 1001, 0);
+    UplinkFields_t x = fixedPath(801, 1001, 0, true);
+    TEST_ASSERT_EQUAL_INT16(INT16_MIN, f.temperature);
+    TEST_ASSERT_EQUAL_INT16(INT16_MIN, x.temperature);
+    TEST_ASSERT_EQUAL_UINT16(UINT8_MAX, f.humidity);
+    TEST_ASSERT_EQUAL_UINT16(UINT8_MAX, x.humidity);
+
+    // The counted division is the one of the encoders
+    for (int32_t value = -1000; value <= 1000; value++) {
+        TEST_ASSERT_EQUAL_INT32(divRound(value, 10), countedDivRound(Int(value), 10).value());
+        TEST_ASSERT_EQUAL_INT32(divRound(value, 5), countedDivRound(Int(value), 5).value());
+    }
+}
+
+/** Estimated cost of the operations counted since \ref clearOps(), printed with the name of the \p path. */
+static uint32_t report(const char* path, uint32_t& flashBytes) {
+    char text[128];
+    uint32_t count = 0;
+    for (uint8_t i = 0; i < OP_KINDS; i++) {
+        count += floatOps[i] + intOps[i];
+    }
+    uint32_t total = cycles(floatOps, FLOAT_COST) + cycles(intOps, INT32_COST);
+    flashBytes = flash(floatOps, FLOAT_COST) + flash(intOps, INT32_COST);
+    snprintf(text, sizeof(text), "per reading, %s: %lu ops, ~%lu cycles, ~%lu flash bytes", path,
+             (unsigned long) count, (unsigned long) total, (unsigned long) flashBytes);
+    TEST_MESSAGE(text);
+    clearOps();
+    return total;
+}
+
+void test_operation_count_and_size(void) {
+    uint32_t floatFlash;
+    uint32_t packedFlash;
+    uint32_t lppFlash;
+
+    // One reading through each path
+    floatPath(251, 600, 2800);
+    uint32_t floatCycles = report("float", floatFlash);
+    fixedPath(251, 600, 2800, false);
+    uint32_t fixedFloatOps = floatOps[OP_ADD] + floatOps[OP_MUL] + floatOps[OP_DIV] + floatOps[OP_CMP] + floatOps[OP_CONV];
+    uint32_t packedCycles = report("fixed (packed)", packedFlash);
+    fixedPath(251, 600, 2800, true);
+    fixedFloatOps += floatOps[OP_ADD] + floatOps[OP_MUL] + floatOps[OP_DIV] + floatOps[OP_CMP] + floatOps[OP_CONV];
+    uint32_t lppCycles = report("fixed (Cayenne LPP)", lppFlash);
+
+    // No float operation is left; the packed record needs no division at all, and the LPP scaling (three 32 bits
+    // divisions) still costs half of the float path
+    TEST_ASSERT_EQUAL_UINT32(0, fixedFloatOps);
+    TEST_ASSERT_LESS_THAN(floatCycles / 20, packedCycles);
+    TEST_ASSERT_LESS_THAN(floatCycles / 2, lppCycles);
+    TEST_ASSERT_LESS_THAN(floatFlash / 20, packedFlash);
+    TEST_ASSERT_LESS_THAN(floatFlash / 5, lppFlash);
+}
+
+int main(int argc, char** argv) {
+    (void) argc;
+    (void) argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_battery_voltage);
+    RUN_TEST(test_same_uplink_fields);
+    RUN_TEST(test_operation_count_and_size);
+    return UNITY_END();
+}
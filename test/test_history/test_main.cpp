@@ -0,0 +1,276 @@
+/**
+ * @file test_main.cpp
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief Reading history tests of the native build: running statistics against a floating point reference, the
+ * ring order and the update cost per sample.
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ *
+ * The statistics use the same integer widths as on the ATmega328p (\c int32_t samples, 64 bit sums), so the host
+ * results are the ones of the station.
+ */
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+#include <unity.h>
+#include "ats_01_history.h"
+
+/**
+ * \def BENCH_SAMPLES
+ * Samples of each cost measure.
+ */
+#define BENCH_SAMPLES                   2000000UL
+
+static uint32_t seed = 1;
+
+/** Pseudo-random number in <tt>0 .. range-1</tt> (LCG, the same sequence on every run). */
+static uint32_t nextRandom(uint32_t range) {
+    seed = (seed * 1103515245UL) + 12345UL;
+    return (seed >> 8) % range;
+}
+
+/** Floating point reference of \ref RunningStats (two sums). */
+class ReferenceStats {
+    private:
+        double sum = 0;
+        double squares = 0;
+        uint32_t n = 0;
+
+    public:
+        void add(int32_t value) {
+            sum += value;
+            squares += (double) value * value;
+            n++;
+        }
+        int32_t mean() const { return (int32_t) floor((sum / n) + 0.5); }
+        uint32_t variance() const { return (uint32_t) (((squares - (sum * sum / n)) / (n - 1)) + 0.5); }
+};
+
+/** Feed \p n samples of <tt>base .. base+range-1</tt> and compare with the reference. */
+static void assertStream(int32_t base, uint32_t range, uint16_t n) {
+    RunningStats stats;
+    ReferenceStats reference;
+    int32_t lowest = INT32_MAX;
+    int32_t highest = INT32_MIN;
+    for (uint16_t i = 0; i < n; i++) {
+        int32_t value = base + (int32_t) nextRandom(range);
+        stats.add(value);
+        reference.add(value);
+        lowest = (value < lowest) ? value : lowest;
+        highest = (value > highest) ? value : highest;
+    }
+    TEST_ASSERT_EQUAL_UINT16(n, stats.count());
+    TEST_ASSERT_EQUAL_INT32(lowest, stats.min());
+    TEST_ASSERT_EQUAL_INT32(highest, stats.max());
+    TEST_ASSERT_EQUAL_INT32(reference.mean(), stats.mean());
+
+    // Exact sums: only the last rounding may differ from the floating point one
+    TEST_ASSERT_UINT32_WITHIN(1, reference.variance(), stats.variance());
+}
+
+/** Reading with every field set from the pseudo-random sequence. */
+static STATION_SENSORS_T randomReading() {
+    STATION_SENSORS_T reading;
+    reading.set(SENSOR_AIR_TEMPERATURE, (int32_t) nextRandom(1200) - 400);
+    reading.set(SENSOR_AIR_HUMIDITY, (int32_t) nextRandom(1001));
+    reading.set(SENSOR_LIGHT, (int32_t) nextRandom(65536));
+    reading.set(SENSOR_UV_INDEX, (int32_t) nextRandom(12));
+    reading.set(SENSOR_BATTERY_VOLTAGE, 3000 + (int32_t) nextRandom(1300));
+    return reading;
+}
+
+void setUp(void) { }
+
+void tearDown(void) { }
+
+void test_empty_stats(void) {
+    RunningStats stats;
+    TEST_ASSERT_EQUAL_UINT16(0, stats.count());
+    TEST_ASSERT_EQUAL_INT32(0, stats.min());
+    TEST_ASSERT_EQUAL_INT32(0, stats.max());
+    TEST_ASSERT_EQUAL_UINT32(0, stats.variance());
+
+    stats.add(-123);
+    TEST_ASSERT_EQUAL_INT32(-123, stats.mean());
+    TEST_ASSERT_EQUAL_INT32(-123, stats.min());
+    TEST_ASSERT_EQUAL_INT32(-123, stats.max());
+    TEST_ASSERT_EQUAL_UINT32(0, stats.variance());
+}
+
+void test_stats_match_reference(void) {
+    // Ranges of the record fields (see RECORD_FIELD_WIDTH), short and long periods
+    const uint16_t lengths[] = { 2, 10, 60, 1440, 20000 };
+    for (uint8_t i = 0; i < (sizeof(lengths) / sizeof(lengths[0])); i++) {
+        assertStream(-400, 1200, lengths[i]);       // air temperature
+        assertStream(0, 1001, lengths[i]);          // air humidity
+        assertStream(0, 65536, lengths[i]);         // light
+        assertStream(0, 12, lengths[i]);            // UV index
+        assertStream(3000, 1300, lengths[i]);       // battery voltage
+    }
+}
+
+void test_slow_drift_is_kept(void) {
+    // A 0.1 oC step every 30 samples: the mean follows the drift instead of sticking to the first values
+    RunningStats stats;
+    ReferenceStats reference;
+    for (uint16_t i = 0; i < 1440; i++) {
+        int32_t value = 150 + (i / 30);
+        stats.add(value);
+        reference.add(value);
+    }
+    TEST_ASSERT_EQUAL_INT32(reference.mean(), stats.mean());
+    TEST_ASSERT_UINT32_WITHIN(1, reference.variance(), stats.variance());
+}
+
+void test_extremes_do_not_overflow(void) {
+    // Full scale light for a whole count: the largest sum of the deviations, squared, still fits 64 bits
+    RunningStats stats;
+    stats.add(0);
+    for (uint16_t i = 1; i < UINT16_MAX; i++) {
+        stats.add(65535);
+    }
+    TEST_ASSERT_EQUAL_UINT16(UINT16_MAX, stats.count());
+    TEST_ASSERT_EQUAL_INT32(65534, stats.mean());
+    TEST_ASSERT_EQUAL_UINT32(65535, stats.variance());
+
+    // Full scale swings (32768 zeros): the largest variance, 32767 * 32768 * 65535 / 65534
+    stats.reset();
+    for (uint16_t i = 0; i < UINT16_MAX; i++) {
+        stats.add((i % 2) ? 65535 : 0);
+    }
+    TEST_ASSERT_EQUAL_INT32(32767, stats.mean());
+    TEST_ASSERT_EQUAL_UINT32(1073725440UL, stats.variance());
+
+    // Saturated: further samples are dropped
+    stats.add(100000);
+    TEST_ASSERT_EQUAL_UINT16(UINT16_MAX, stats.count());
+    TEST_ASSERT_EQUAL_INT32(65535, stats.max());
+
+    stats.reset();
+    TEST_ASSERT_EQUAL_UINT16(0, stats.count());
+    stats.add(7);
+    TEST_ASSERT_EQUAL_INT32(7, stats.min());
+    TEST_ASSERT_EQUAL_INT32(7, stats.max());
+}
+
+void test_ring_order(void) {
+    ReadingHistory<4> history;
+    TEST_ASSERT_EQUAL_UINT8(0, history.size());
+    for (int32_t i = 0; i < 6; i++) {
+        STATION_SENSORS_T reading;
+        reading.set(SENSOR_AIR_TEMPERATURE, 100 + i);
+        history.push(reading);
+        TEST_ASSERT_EQUAL_UINT8((i < 4) ? (uint8_t) (i + 1) : 4, history.size());
+    }
+
+    // Latest first, the two oldest readings overwritten
+    for (uint8_t age = 0; age < 4; age++) {
+        TEST_ASSERT_EQUAL_INT16(105 - age, history.at(age).airTemperature());
+    }
+}
+
+void test_period_statistics(void) {
+    ReadingHistory<4> history;
+    for (int32_t i = 0; i < 6; i++) {
+        STATION_SENSORS_T reading;
+        reading.set(SENSOR_AIR_TEMPERATURE, 100 + i);
+        if (i % 2) {
+            reading.set(SENSOR_LIGHT, 1000 * i);
+        }
+        history.push(reading);
+    }
+
+    // The statistics cover every push of the period, not only the readings kept into the ring; invalid fields
+    // are not counted
+    TEST_ASSERT_EQUAL_UINT16(6, history.stats(SENSOR_AIR_TEMPERATURE).count());
+    TEST_ASSERT_EQUAL_INT32(100, history.stats(SENSOR_AIR_TEMPERATURE).min());
+    TEST_ASSERT_EQUAL_INT32(105, history.stats(SENSOR_AIR_TEMPERATURE).max());
+    TEST_ASSERT_EQUAL_UINT16(3, history.stats(SENSOR_LIGHT).count());
+    TEST_ASSERT_EQUAL_INT32(3000, history.stats(SENSOR_LIGHT).mean());
+    TEST_ASSERT_EQUAL_UINT16(0, history.stats(SENSOR_UV_INDEX).count());
+
+    STATION_SENSORS_T mean = history.mean();
+    TEST_ASSERT_TRUE(mean.isValid(SENSOR_AIR_TEMPERATURE));
+    TEST_ASSERT_EQUAL_INT16(103, mean.airTemperature());
+    TEST_ASSERT_TRUE(mean.isValid(SENSOR_LIGHT));
+    TEST_ASSERT_EQUAL_INT32(3000, mean.value(SENSOR_LIGHT));
+    TEST_ASSERT_FALSE(mean.isValid(SENSOR_UV_INDEX));
+    TEST_ASSERT_FALSE(mean.isValid(SENSOR_BATTERY_VOLTAGE));
+
+    // A new period keeps the ring
+    history.restartPeriod();
+    TEST_ASSERT_EQUAL_UINT16(0, history.stats(SENSOR_AIR_TEMPERATURE).count());
+    TEST_ASSERT_FALSE(history.mean().isValid(SENSOR_AIR_TEMPERATURE));
+    TEST_ASSERT_EQUAL_UINT8(4, history.size());
+    TEST_ASSERT_EQUAL_INT16(105, history.at(0).airTemperature());
+}
+
+void test_update_cost_per_sample(void) {
+    // Constant time per sample: the second half of a full period costs as much as the first one (the bound is
+    // loose, the host is not an AVR, but a cost growing with the count shows at once)
+    static int32_t values[4096];
+    for (uint16_t i = 0; i < 4096; i++) {
+        values[i] = (int32_t) nextRandom(65536);
+    }
+    const uint16_t half = UINT16_MAX / 2;
+    clock_t costs[2] = { 0, 0 };
+    RunningStats stats;
+    uint32_t sink = 0;
+    for (uint32_t period = 0; period < (BENCH_SAMPLES / half / 2); period++) {
+        stats.reset();
+        for (uint8_t part = 0; part < 2; part++) {
+            clock_t start = clock();
+            for (uint16_t i = 0; i < half; i++) {
+                stats.add(values[(i + part) % 4096]);
+            }
+            costs[part] += clock() - start;
+        }
+        sink += (uint32_t) stats.mean() + stats.variance();
+    }
+    TEST_ASSERT_GREATER_THAN(0, sink);
+    TEST_ASSERT_TRUE(costs[1] < ((2 * costs[0]) + (CLOCKS_PER_SEC / 100)));
+    double addCost = (double) (costs[0] + costs[1]) * 1e9 / CLOCKS_PER_SEC / ((BENCH_SAMPLES / half / 2) * 2 * half);
+
+    // Whole reading (five fields) into the ring and the period statistics
+    ReadingHistory<16> history;
+    STATION_SENSORS_T readings[64];
+    for (uint8_t i = 0; i < 64; i++) {
+        readings[i] = randomReading();
+    }
+    clock_t start = clock();
+    for (uint32_t i = 0; i < BENCH_SAMPLES; i++) {
+        if ((i % 1440) == 0) {
+            history.restartPeriod();
+        }
+        history.push(readings[i % 64]);
+    }
+    double pushCost = (double) (clock() - start) * 1e9 / CLOCKS_PER_SEC / BENCH_SAMPLES;
+    TEST_ASSERT_EQUAL_UINT8(16, history.size());
+
+    char message[64];
+    snprintf(message, sizeof(message), "per sample: add %.1f ns, push %.1f ns", addCost, pushCost);
+    TEST_MESSAGE(message);
+}
+
+int main(int argc, char** argv) {
+    (void) argc;
+    (void) argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_empty_stats);
+    RUN_TEST(test_stats_match_reference);
+    RUN_TEST(test_slow_drift_is_kept);
+    RUN_TEST(test_extremes_do_not_overflow);
+    RUN_TEST(test_ring_order);
+    RUN_TEST(test_period_statistics);
+    RUN_TEST(test_update_cost_per_sample);
+    return UNITY_END();
+}
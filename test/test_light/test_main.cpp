@@ -0,0 +1,154 @@
+/**
+ * @file test_main.cpp
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief BH1750 ranging tests of the native build: convergence of \ref LightRanger against the
+ * \ref SimulatedBH1750 model, over the whole light range and through light steps.
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#include <unity.h>
+#include "ats_01_light.h"
+
+static LightRanger ranger;
+static SimulatedBH1750 sensor;
+
+/**
+ * One reading as the station does it (see \c getLightInLux()): a conversion with the current settings, the
+ * light of its raw count and the settings of the next one.
+ * @return bool - \c false if the conversion was saturated.
+ */
+static bool measure(uint32_t& lux) {
+    sensor.setMTreg(ranger.mtreg());
+    ranger.started(sensor.mtreg);
+    uint16_t raw = sensor.convert(ranger.highRes2());
+    lux = ranger.toLux(raw);
+    return ranger.update(raw);
+}
+
+/** Largest error (in lux) allowed for a reading of \p lux: 1 % or the resolution of the most sensitive range. */
+static uint32_t tolerance(uint32_t lux) {
+    return (lux / 100) + 1;
+}
+
+void setUp(void) {
+    ranger = LightRanger();
+    sensor = SimulatedBH1750();
+}
+
+void tearDown(void) { }
+
+void test_converges_in_one_reading(void) {
+    // From the default settings, over the whole range (1 lux .. 100 klux, 10 steps per decade)
+    for (uint32_t lux = 1; lux <= 100000UL; lux += (lux < 10) ? 1 : (lux / 10)) {
+        setUp();
+        sensor.lux = lux;
+        uint32_t first;
+        uint32_t second;
+        measure(first);
+        TEST_ASSERT_TRUE(measure(second));
+        TEST_ASSERT_UINT32_WITHIN(tolerance(lux), lux, second);
+        TEST_ASSERT_GREATER_OR_EQUAL(LightRanger::MIN_SENSITIVITY, ranger.getSensitivity());
+        TEST_ASSERT_LESS_OR_EQUAL(LightRanger::MAX_SENSITIVITY, ranger.getSensitivity());
+
+        // Settled: the next conversion lands near the target count (unless the sensitivity is at a limit), within
+        // the sensitivity step (1 MTreg, or 2 in high resolution mode 2) and the sensor rounding
+        uint16_t sensitivity = ranger.getSensitivity();
+        TEST_ASSERT_TRUE(sensor.setMTreg(ranger.mtreg()));
+        uint16_t raw = sensor.convert(ranger.highRes2());
+        if ((sensitivity > LightRanger::MIN_SENSITIVITY) && (sensitivity < LightRanger::MAX_SENSITIVITY)) {
+            uint32_t step = (2 * LIGHT_RAW_TARGET) / sensitivity;
+            TEST_ASSERT_UINT32_WITHIN(step + (LIGHT_RAW_TARGET / 100), LIGHT_RAW_TARGET, raw);
+        }
+    }
+}
+
+void test_no_saturation_within_4x(void) {
+    uint32_t lux;
+    sensor.lux = 500;
+    measure(lux);
+    measure(lux);
+
+    // Light growing up to 4 times between readings never saturates
+    while (sensor.lux < 60000UL) {
+        sensor.lux = (sensor.lux * 39) / 10;
+        TEST_ASSERT_TRUE(measure(lux));
+        TEST_ASSERT_UINT32_WITHIN(tolerance(sensor.lux), sensor.lux, lux);
+    }
+}
+
+void test_recovers_from_saturation(void) {
+    uint32_t lux;
+
+    // Night, then a flash of full sun: one saturated conversion, the next one (lowest sensitivity) in range
+    sensor.lux = 1;
+    measure(lux);
+    measure(lux);
+    TEST_ASSERT_EQUAL_UINT16(LightRanger::MAX_SENSITIVITY, ranger.getSensitivity());
+    sensor.lux = 100000UL;
+    TEST_ASSERT_FALSE(measure(lux));
+    TEST_ASSERT_EQUAL_UINT16(LightRanger::MIN_SENSITIVITY, ranger.getSensitivity());
+    TEST_ASSERT_TRUE(measure(lux));
+    TEST_ASSERT_UINT32_WITHIN(tolerance(sensor.lux), sensor.lux, lux);
+}
+
+void test_rejected_mtreg(void) {
+    uint32_t lux;
+
+    // Every MTreg the ranger asks for is accepted by the sensor
+    TEST_ASSERT_FALSE(sensor.setMTreg(LIGHT_MTREG_MIN - 1));
+    TEST_ASSERT_TRUE(sensor.setMTreg(LightRanger::MIN_SENSITIVITY));
+    TEST_ASSERT_TRUE(sensor.setMTreg(LightRanger::MAX_SENSITIVITY / 2));
+
+    // A sensor that kept the MTreg of a dark reading (ex.: I2C error while writing it): the count is scaled with
+    // the MTreg it kept, and the next reading is back in range
+    sensor.lux = 2000;
+    sensor.setMTreg(LIGHT_MTREG_MAX);
+    ranger.started(sensor.mtreg);
+    uint16_t raw = sensor.convert(ranger.highRes2());
+    TEST_ASSERT_UINT32_WITHIN(tolerance(sensor.lux), sensor.lux, ranger.toLux(raw));
+    TEST_ASSERT_TRUE(ranger.update(raw));
+    TEST_ASSERT_TRUE(measure(lux));
+    TEST_ASSERT_UINT32_WITHIN(tolerance(sensor.lux), sensor.lux, lux);
+}
+
+void test_darkness_and_conversion_time(void) {
+    uint32_t lux;
+    sensor.lux = 0;
+    for (uint8_t i = 0; i < 3; i++) {
+        TEST_ASSERT_TRUE(measure(lux));
+        TEST_ASSERT_EQUAL_UINT32(0, lux);
+    }
+    TEST_ASSERT_EQUAL_UINT16(LightRanger::MAX_SENSITIVITY, ranger.getSensitivity());
+    TEST_ASSERT_TRUE(ranger.highRes2());
+
+    // A day of readings costs on average less than the longest conversion
+    sensor = SimulatedBH1750();
+    for (uint16_t minute = 0; minute < 1440; minute++) {
+        uint32_t hour = minute / 60;
+        sensor.lux = ((hour >= 6) && (hour < 18)) ? (1000UL + (hour - 6) * 8000UL) : 0;
+        measure(lux);
+    }
+    TEST_ASSERT_EQUAL_UINT32(1440, sensor.conversions);
+    TEST_ASSERT_LESS_THAN(1440UL * ((120UL * LIGHT_MTREG_MAX) / LIGHT_MTREG_DEFAULT), sensor.busyMs);
+}
+
+int main(int argc, char** argv) {
+    (void) argc;
+    (void) argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_converges_in_one_reading);
+    RUN_TEST(test_no_saturation_within_4x);
+    RUN_TEST(test_recovers_from_saturation);
+    RUN_TEST(test_rejected_mtreg);
+    RUN_TEST(test_darkness_and_conversion_time);
+    return UNITY_END();
+}
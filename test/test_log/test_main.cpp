@@ -0,0 +1,323 @@
+/**
+ * @file test_main.cpp
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief Reading log tests of the native build: order, reboots, power loss recovery and EEPROM wear
+ * (see \ref EmulatedEeprom).
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#include <stdio.h>
+#include <time.h>
+#include <unity.h>
+#include "ats_01_log.h"
+
+/**
+ * \def EEPROM_CYCLES
+ * Write cycles of an ATmega328p EEPROM cell (data sheet endurance).
+ */
+#define EEPROM_CYCLES                   100000UL
+
+/**
+ * \def EEPROM_WRITE_US
+ * Time (in us) of an ATmega328p EEPROM byte write (erase and write).
+ */
+#define EEPROM_WRITE_US                 3400UL
+
+/** Small EEPROM, so the log wraps often (10 slots). */
+typedef EmulatedEeprom<10 * LOG_SLOT_SIZE> TestEeprom;
+typedef RecordLog<TestEeprom> TestLog;
+
+/** Reading number \p i (its light field). */
+static STATION_SENSORS_T reading(uint16_t i) {
+    STATION_SENSORS_T data;
+    data.set(SENSOR_LIGHT, i);
+    return data;
+}
+
+/** Light field of a packed frame. */
+static uint16_t lightOf(const uint8_t frame[PAYLOAD_SIZE]) {
+    STATION_SENSORS_T data;
+    memcpy(data.bytes, frame, PAYLOAD_SIZE);
+    return data.light();
+}
+
+/**
+ * Send the whole log in batches of up to \p max readings, as the station does.
+ * @return uint16_t - readings sent (their lights are written into \p lights).
+ */
+static uint16_t drain(TestLog& log, uint8_t max, uint16_t* lights, uint16_t capacity) {
+    uint8_t frames[TestLog::SLOTS][PAYLOAD_SIZE];
+    uint16_t sent = 0;
+    uint16_t firstSeq = 0;
+    for (uint8_t guard = 0; (log.pending() > 0) && (guard < (2 * TestLog::SLOTS)); guard++) {
+        uint8_t n = log.peek(frames, max, firstSeq);
+        if (n == 0) {
+            // Only allowed when the corrupted records left nothing pending
+            TEST_ASSERT_EQUAL_UINT8(0, log.pending());
+            break;
+        }
+        for (uint8_t i = 0; (i < n) && (sent < capacity); i++) {
+            lights[sent++] = lightOf(frames[i]);
+        }
+        log.commit(firstSeq, n);
+    }
+    TEST_ASSERT_EQUAL_UINT8(0, log.pending());
+    return sent;
+}
+
+void setUp(void) { }
+
+void tearDown(void) { }
+
+void test_order_and_reboot(void) {
+    TestEeprom eeprom;
+    TestLog log(eeprom);
+    log.begin();
+    TEST_ASSERT_EQUAL_UINT8(0, log.pending());
+    for (uint16_t i = 1; i <= 4; i++) {
+        log.append(reading(i));
+    }
+
+    uint8_t frames[2][PAYLOAD_SIZE];
+    uint16_t firstSeq;
+    TEST_ASSERT_EQUAL_UINT8(2, log.peek(frames, 2, firstSeq));
+    TEST_ASSERT_EQUAL_UINT16(0, firstSeq);
+    TEST_ASSERT_EQUAL_UINT16(1, lightOf(frames[0]));
+    TEST_ASSERT_EQUAL_UINT16(2, lightOf(frames[1]));
+    log.commit(firstSeq, 2);
+    TEST_ASSERT_EQUAL_UINT8(2, log.pending());
+
+    // After a reboot the pending readings (and the sequence) go on
+    TestLog rebooted(eeprom);
+    rebooted.begin();
+    TEST_ASSERT_EQUAL_UINT8(2, rebooted.pending());
+    rebooted.append(reading(5));
+    uint16_t lights[8];
+    TEST_ASSERT_EQUAL_UINT16(3, drain(rebooted, 6, lights, 8));
+    TEST_ASSERT_EQUAL_UINT16(3, lights[0]);
+    TEST_ASSERT_EQUAL_UINT16(5, lights[2]);
+}
+
+void test_full_log_keeps_newest(void) {
+    TestEeprom eeprom;
+    TestLog log(eeprom);
+    log.begin();
+    for (uint16_t i = 1; i <= (TestLog::SLOTS + 3); i++) {
+        log.append(reading(i));
+    }
+    TEST_ASSERT_EQUAL_UINT8(TestLog::SLOTS, log.pending());
+    uint16_t lights[TestLog::SLOTS];
+    TEST_ASSERT_EQUAL_UINT16(TestLog::SLOTS, drain(log, 6, lights, TestLog::SLOTS));
+    TEST_ASSERT_EQUAL_UINT16(4, lights[0]);
+    TEST_ASSERT_EQUAL_UINT16(TestLog::SLOTS + 3, lights[TestLog::SLOTS - 1]);
+}
+
+void test_corrupted_oldest_record_is_skipped(void) {
+    TestEeprom eeprom;
+    TestLog log(eeprom);
+    log.begin();
+    for (uint16_t i = 1; i <= 3; i++) {
+        log.append(reading(i));
+    }
+
+    // Bit flip into the oldest pending record: it can not block the log
+    eeprom.cells[5] ^= 0x10;
+    uint8_t frames[6][PAYLOAD_SIZE];
+    uint16_t firstSeq;
+    TEST_ASSERT_EQUAL_UINT8(2, log.peek(frames, 6, firstSeq));
+    TEST_ASSERT_EQUAL_UINT16(1, firstSeq);
+    TEST_ASSERT_EQUAL_UINT16(2, lightOf(frames[0]));
+    TEST_ASSERT_EQUAL_UINT8(2, log.pending());
+    TEST_ASSERT_EQUAL_UINT16(1, log.corrupted());
+    log.commit(firstSeq, 2);
+    TEST_ASSERT_EQUAL_UINT8(0, log.pending());
+}
+
+void test_corrupted_middle_record_is_skipped(void) {
+    TestEeprom eeprom;
+    TestLog log(eeprom);
+    log.begin();
+    for (uint16_t i = 1; i <= 5; i++) {
+        log.append(reading(i));
+    }
+    eeprom.cells[(2 * LOG_SLOT_SIZE) + 4] ^= 0x01;
+
+    // The batch stops before the corrupted record, which is released by the next one
+    uint16_t lights[5];
+    TEST_ASSERT_EQUAL_UINT16(4, drain(log, 6, lights, 5));
+    TEST_ASSERT_EQUAL_UINT16(1, lights[0]);
+    TEST_ASSERT_EQUAL_UINT16(2, lights[1]);
+    TEST_ASSERT_EQUAL_UINT16(4, lights[2]);
+    TEST_ASSERT_EQUAL_UINT16(5, lights[3]);
+    TEST_ASSERT_EQUAL_UINT16(1, log.corrupted());
+}
+
+void test_power_loss_while_running(void) {
+    // Power loss (brown-out) at every byte of a record write, the MCU going on without reboot
+    for (uint8_t cut = 0; cut < LOG_SLOT_SIZE; cut++) {
+        TestEeprom eeprom;
+        TestLog log(eeprom);
+        log.begin();
+        eeprom.powerLossAfter = eeprom.writes + cut;
+        log.append(reading(1));
+        eeprom.powerLossAfter = UINT32_MAX;
+        log.append(reading(2));
+        log.append(reading(3));
+
+        uint16_t lights[3];
+        uint16_t sent = drain(log, 6, lights, 3);
+        TEST_ASSERT_GREATER_OR_EQUAL(2, sent);
+        TEST_ASSERT_EQUAL_UINT16(3, lights[sent - 1]);
+        TEST_ASSERT_EQUAL_UINT16(3 - sent, log.corrupted());
+    }
+}
+
+void test_power_loss_and_reboot(void) {
+    // Power loss at every byte of a write over a full (wrapped) log, then reboot
+    for (uint8_t cut = 0; cut <= LOG_SLOT_SIZE; cut++) {
+        TestEeprom eeprom;
+        TestLog log(eeprom);
+        log.begin();
+        for (uint16_t i = 1; i <= (TestLog::SLOTS + 4); i++) {
+            log.append(reading(i));
+        }
+        eeprom.powerLossAfter = eeprom.writes + cut;
+        log.append(reading(100));
+
+        eeprom.powerLossAfter = UINT32_MAX;
+        TestLog rebooted(eeprom);
+        rebooted.begin();
+        TEST_ASSERT_GREATER_THAN(0, rebooted.pending());
+        rebooted.append(reading(200));
+
+        // Everything still pending is sent, in order, ending with the newest reading
+        uint16_t lights[TestLog::SLOTS];
+        uint16_t sent = drain(rebooted, 6, lights, TestLog::SLOTS);
+        TEST_ASSERT_GREATER_THAN(0, sent);
+        for (uint16_t i = 1; i < sent; i++) {
+            TEST_ASSERT_LESS_THAN(lights[i], lights[i - 1]);
+        }
+        TEST_ASSERT_EQUAL_UINT16(200, lights[sent - 1]);
+    }
+}
+
+void test_power_loss_does_not_resend(void) {
+    // Power loss at every byte of a write over a sent record while newer ones are pending: after the reboot the
+    // sent record is never pending again
+    for (uint8_t cut = 0; cut <= (LOG_SLOT_SIZE + 1); cut++) {
+        TestEeprom eeprom;
+        TestLog log(eeprom);
+        log.begin();
+        for (uint16_t i = 1; i <= TestLog::SLOTS; i++) {
+            log.append(reading(i));
+        }
+        uint8_t frames[1][PAYLOAD_SIZE];
+        uint16_t firstSeq;
+        TEST_ASSERT_EQUAL_UINT8(1, log.peek(frames, 1, firstSeq));
+        log.commit(firstSeq, 1);
+        eeprom.powerLossAfter = eeprom.writes + cut;
+        log.append(reading(100));
+
+        eeprom.powerLossAfter = UINT32_MAX;
+        TestLog rebooted(eeprom);
+        rebooted.begin();
+        uint16_t lights[TestLog::SLOTS];
+        uint16_t sent = drain(rebooted, 6, lights, TestLog::SLOTS);
+        TEST_ASSERT_GREATER_OR_EQUAL(TestLog::SLOTS - 1, sent);
+        TEST_ASSERT_EQUAL_UINT16(2, lights[0]);
+        for (uint16_t i = 1; i < sent; i++) {
+            TEST_ASSERT_LESS_THAN(lights[i], lights[i - 1]);
+        }
+    }
+}
+
+void test_wear_is_spread(void) {
+    TestEeprom eeprom;
+    TestLog log(eeprom);
+    log.begin();
+    const uint16_t laps = 50;
+    uint8_t frames[1][PAYLOAD_SIZE];
+    uint16_t firstSeq;
+    for (uint16_t i = 0; i < (laps * TestLog::SLOTS); i++) {
+        log.append(reading(i));
+        if ((i % 3) == 2) {
+            while (log.peek(frames, 1, firstSeq) > 0) {
+                log.commit(firstSeq, 1);
+            }
+        }
+    }
+
+    // Every cell is written at most twice per lap (the state byte: pending, then sent)
+    uint32_t most = 0;
+    uint32_t least = UINT32_MAX;
+    for (uint16_t addr = 0; addr < (TestLog::SLOTS * LOG_SLOT_SIZE); addr++) {
+        most = (eeprom.wear[addr] > most) ? eeprom.wear[addr] : most;
+        least = (eeprom.wear[addr] < least) ? eeprom.wear[addr] : least;
+    }
+    TEST_ASSERT_LESS_OR_EQUAL(2 * laps, most);
+    TEST_ASSERT_GREATER_THAN(0, least);
+}
+
+void test_throughput_and_wear(void) {
+    // Station EEPROM with the radio down (every reading logged, one per minute) and then drained in batches: host
+    // time and bytes written per reading, MCU write time and the life of the most worn cell
+    typedef EmulatedEeprom<1024> StationEeprom;
+    static StationEeprom eeprom;
+    RecordLog<StationEeprom> log(eeprom);
+    log.begin();
+    const uint32_t readings = 100UL * RecordLog<StationEeprom>::SLOTS;
+    uint8_t frames[6][PAYLOAD_SIZE];
+    uint16_t firstSeq;
+    clock_t start = clock();
+    for (uint32_t i = 0; i < readings; i++) {
+        log.append(reading((uint16_t) i));
+        if ((i % RecordLog<StationEeprom>::SLOTS) == (RecordLog<StationEeprom>::SLOTS - 1)) {
+            uint8_t n;
+            while ((n = log.peek(frames, 6, firstSeq)) > 0) {
+                log.commit(firstSeq, n);
+            }
+        }
+    }
+    double hostNs = (double) (clock() - start) * 1e9 / CLOCKS_PER_SEC / readings;
+
+    uint32_t written = 0;
+    uint32_t most = 0;
+    for (uint16_t addr = 0; addr < StationEeprom::SIZE; addr++) {
+        written += eeprom.wear[addr];
+        most = (eeprom.wear[addr] > most) ? eeprom.wear[addr] : most;
+    }
+    double bytesPerReading = (double) written / readings;
+    TEST_ASSERT_TRUE(bytesPerReading <= (LOG_SLOT_SIZE + 2));
+    TEST_ASSERT_LESS_OR_EQUAL(2 * (readings / RecordLog<StationEeprom>::SLOTS), most);
+
+    double lifeYears = ((double) EEPROM_CYCLES * readings / most) / (60.0 * 24.0 * 365.0);
+    char text[112];
+    snprintf(text, sizeof(text), "per reading: %.0f ns host, %.1f bytes (%.0f ms on the MCU); log life at 1/min: %.1f years",
+             hostNs, bytesPerReading, (bytesPerReading * EEPROM_WRITE_US) / 1000.0, lifeYears);
+    TEST_MESSAGE(text);
+}
+
+int main(int argc, char** argv) {
+    (void) argc;
+    (void) argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_order_and_reboot);
+    RUN_TEST(test_full_log_keeps_newest);
+    RUN_TEST(test_corrupted_oldest_record_is_skipped);
+    RUN_TEST(test_corrupted_middle_record_is_skipped);
+    RUN_TEST(test_power_loss_while_running);
+    RUN_TEST(test_power_loss_and_reboot);
+    RUN_TEST(test_power_loss_does_not_resend);
+    RUN_TEST(test_wear_is_spread);
+    RUN_TEST(test_throughput_and_wear);
+    return UNITY_END();
+}
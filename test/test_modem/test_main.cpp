@@ -0,0 +1,351 @@
+/**
+ * @file test_main.cpp
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief LoRa driver tests of the native build against the emulated RHF0M003 (see \ref ModemEmulator).
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ *
+ * Time is the simulated \c millis() of the station (\ref SimulatedSleep), which goes on while the driver waits. The
+ * latency tests bound every command exchange by the reply latency of the modem, the serial time of the reply bytes
+ * and one poll period, so a wait longer than the reply (ex.: a fixed delay or a read timeout) fails them.
+ */
+#include <stdio.h>
+#include <time.h>
+#include <unity.h>
+#include "ats_01_station.h"
+
+/**
+ * \def POLL_SLACK_MS
+ * Time (in ms) a command exchange may take beyond the modem reply: the poll period of the driver plus the rounding
+ * of the serial time.
+ */
+#define POLL_SLACK_MS                   2
+
+/**
+ * \def THROUGHPUT_UPLINKS
+ * Uplinks of the send path throughput test.
+ */
+#define THROUGHPUT_UPLINKS              200
+
+/**
+ * @class CountingSerial
+ * @brief Modem port of the driver under test: forwards to \ref EmulatedModemSerial and counts the reply bytes.
+ */
+class CountingSerial : public Stream {
+    private:
+        EmulatedModemSerial& port;
+
+    public:
+        uint32_t received = 0;          /**< Reply bytes read by the driver. */
+
+        explicit CountingSerial(EmulatedModemSerial& modemPort) : port(modemPort) { }
+        int available() override { return port.available(); }
+        int peek() override { return port.peek(); }
+        int read() override {
+            int c = port.read();
+            if (c >= 0) {
+                received++;
+            }
+            return c;
+        }
+        size_t write(uint8_t value) override { return port.write(value); }
+        using Print::write;
+};
+
+static NullOutput dropped;
+static EmulatedModemSerial modemSerial;
+static CountingSerial countingSerial(modemSerial);
+static LoRa radio(countingSerial, dropped);
+static uint32_t budgetNow = 0;
+static const uint8_t MESSAGE_PORT = 1;
+
+/** Clock of the airtime budget of \ref radio (moved by the tests). */
+static uint32_t budgetClock() {
+    return budgetNow;
+}
+static const uint8_t message[] = { 0x01, 0x02, 0x03, 0x04 };
+
+/**
+ * Poll \p radio until a transmission result, for at most \p ms.
+ * @return LoRaState_e - the result, or the last state on timeout.
+ */
+static LoRaState_e waitResult(uint32_t ms) {
+    LoRaState_e state = radio.poll();
+    for (uint32_t i = 0; (i < ms) && (state != LORA_DONE) && (state != LORA_ERROR); i++) {
+        sleepPlatform.idle();
+        state = radio.poll();
+    }
+    return state;
+}
+
+/** Serial time (in ms, rounded up) of \p bytes received from the modem. */
+static uint32_t serialMs(uint32_t bytes) {
+    return ((bytes * 10000UL) + MODEM_EMU_DEFAULT.baud - 1) / MODEM_EMU_DEFAULT.baud;
+}
+
+/**
+ * @struct Exchange_t
+ * @brief Commands written, reply bytes read and time spent (in ms) by a driver call.
+ */
+typedef struct {
+    uint32_t commands;
+    uint32_t received;
+    uint32_t elapsed;
+} Exchange_t;
+
+/** Start measuring an exchange. */
+static Exchange_t startExchange() {
+    Exchange_t exchange = { modemSerial.modem.commands, countingSerial.received, (uint32_t) millis() };
+    return exchange;
+}
+
+/** Stop measuring \p exchange. */
+static void endExchange(Exchange_t& exchange) {
+    exchange.commands = modemSerial.modem.commands - exchange.commands;
+    exchange.received = countingSerial.received - exchange.received;
+    exchange.elapsed = (uint32_t) millis() - exchange.elapsed;
+}
+
+/** Longest time (in ms) of \p exchange: the reply latency of every command and the serial time of the replies. */
+static uint32_t replyBound(const Exchange_t& exchange) {
+    return (exchange.commands * (MODEM_EMU_DEFAULT.replyLatency + POLL_SLACK_MS)) + serialMs(exchange.received);
+}
+
+/**
+ * Send \ref message with \p cfg and wait for its result.
+ * @return Exchange_t - exchange from the send call to the result.
+ */
+static Exchange_t timedUplink(const LoRaConfig_t& cfg) {
+    budgetNow += LORA_BUDGET_WINDOW;
+    Exchange_t exchange = startExchange();
+    TEST_ASSERT_TRUE(radio.sendNoAckMsgBin(cfg, MESSAGE_PORT, message, sizeof(message)));
+    TEST_ASSERT_EQUAL(LORA_DONE, waitResult(LORA_TX_TIMEOUT));
+    endExchange(exchange);
+    return exchange;
+}
+
+void setUp(void) { }
+
+void tearDown(void) { }
+
+void test_boot(void) {
+    Exchange_t boot = startExchange();
+    TEST_ASSERT_TRUE(radio.initModem(loraCfg));
+    endExchange(boot);
+    TEST_ASSERT_EQUAL(AU920, modemSerial.modem.loraBand());
+    TEST_ASSERT_EQUAL(LORA_IDLE, radio.getState());
+
+    // ABP boot: 17 configuration commands, each one waiting only for its reply
+    TEST_ASSERT_EQUAL_UINT32(17, boot.commands);
+    TEST_ASSERT_LESS_OR_EQUAL(replyBound(boot), boot.elapsed);
+    TEST_ASSERT_LESS_OR_EQUAL(MODEM_EMU_DEFAULT.replyLatency + POLL_SLACK_MS + serialMs(MODEM_EMU_LINE_SIZE),
+                              radio.getCmdLatency());
+
+    char text[80];
+    snprintf(text, sizeof(text), "boot: %lu commands, %lu reply bytes, %lu ms", (unsigned long) boot.commands,
+             (unsigned long) boot.received, (unsigned long) boot.elapsed);
+    TEST_MESSAGE(text);
+}
+
+void test_result_is_reported_once(void) {
+    TEST_ASSERT_TRUE(radio.sendNoAckMsgBin(loraCfg, MESSAGE_PORT, message, sizeof(message)));
+    TEST_ASSERT_TRUE(radio.isBusy());
+    TEST_ASSERT_EQUAL(LORA_DONE, waitResult(LORA_TX_TIMEOUT));
+
+    // The result is gone: later polls (and late lines) leave the driver idle
+    TEST_ASSERT_EQUAL(LORA_IDLE, radio.getState());
+    for (uint16_t i = 0; i < 100; i++) {
+        sleepPlatform.idle();
+        TEST_ASSERT_EQUAL(LORA_IDLE, radio.poll());
+    }
+}
+
+void test_error_is_reported_once(void) {
+    modemSerial.modem.inject("MSGHEX", MODEM_FAULT_ERROR);
+    TEST_ASSERT_TRUE(radio.sendNoAckMsgBin(loraCfg, MESSAGE_PORT, message, sizeof(message)));
+    TEST_ASSERT_EQUAL(LORA_ERROR, waitResult(LORA_TX_TIMEOUT));
+    TEST_ASSERT_EQUAL(LORA_IDLE, radio.poll());
+
+    // The next message runs as usual
+    TEST_ASSERT_TRUE(radio.sendNoAckMsgBin(loraCfg, MESSAGE_PORT, message, sizeof(message)));
+    TEST_ASSERT_EQUAL(LORA_DONE, waitResult(LORA_TX_TIMEOUT));
+    TEST_ASSERT_EQUAL(LORA_IDLE, radio.poll());
+}
+
+void test_oversize_message(void) {
+    uint8_t large[12] = {0};
+    uint32_t uplinks = modemSerial.modem.uplinks;
+
+    // The driver refuses a message longer than the data rate allows (11 bytes at AU920 DR0)
+    TEST_ASSERT_EQUAL_UINT8(11, loraMaxPayload(loraCfg.band, loraCfg.uplink_dr));
+    TEST_ASSERT_FALSE(radio.sendNoAckMsgBin(loraCfg, MESSAGE_PORT, large, sizeof(large)));
+    TEST_ASSERT_EQUAL(LORA_IDLE, radio.getState());
+
+    // The modem rejects it as well, without sending it
+    modemSerial.println(F("AT+MSGHEX=\"000000000000000000000000\""));
+    char line[40];
+    uint8_t len = 0;
+    for (uint16_t i = 0; (i < 1000) && ((len == 0) || (line[len - 1] != '\n')); i++) {
+        sleepPlatform.idle();
+        while ((modemSerial.available() > 0) && (len < (sizeof(line) - 1))) {
+            line[len++] = (char) modemSerial.read();
+        }
+    }
+    line[len] = '\0';
+    TEST_ASSERT_EQUAL_STRING("+MSGHEX: Length error 11\r\n", line);
+    TEST_ASSERT_EQUAL_UINT32(uplinks, modemSerial.modem.uplinks);
+    TEST_ASSERT_EQUAL_UINT32(1, modemSerial.modem.rejected);
+
+    // An 11 bytes message is sent (with a new budget window)
+    budgetNow += LORA_BUDGET_WINDOW;
+    TEST_ASSERT_TRUE(radio.sendNoAckMsgBin(loraCfg, MESSAGE_PORT, large, 11));
+    TEST_ASSERT_EQUAL(LORA_DONE, waitResult(LORA_TX_TIMEOUT));
+    TEST_ASSERT_EQUAL_UINT32(uplinks + 1, modemSerial.modem.uplinks);
+}
+
+void test_confirmed_retries_are_charged(void) {
+    // Every transmission a confirmed message may take is charged: the first one and the AT+RETRY retries
+    budgetNow += LORA_BUDGET_WINDOW;
+    uint8_t transmissions = loraConfirmedTransmissions(loraCfg.retry);
+    TEST_ASSERT_EQUAL_UINT8(4, transmissions);
+
+    // At AU920 DR0, four transmissions of the 4 bytes message (330 ms each) do not fit the fair use budget
+    TEST_ASSERT_GREATER_THAN(LORA_BUDGET_FAIR_USE, transmissions * loraWanAirtimeMs(loraCfg.band, loraCfg.uplink_dr, 4));
+    TEST_ASSERT_FALSE(radio.sendAckMsgBin(loraCfg, MESSAGE_PORT, message, sizeof(message)));
+    TEST_ASSERT_EQUAL(LORA_IDLE, radio.getState());
+
+    // A 1 byte message does
+    uint32_t airtime = transmissions * loraWanAirtimeMs(loraCfg.band, loraCfg.uplink_dr, 1);
+    TEST_ASSERT_TRUE(radio.sendAckMsgBin(loraCfg, MESSAGE_PORT, message, 1));
+    TEST_ASSERT_EQUAL_UINT32(airtime, radio.getLastAirtime());
+    TEST_ASSERT_EQUAL_UINT32(LORA_BUDGET_FAIR_USE - airtime, radio.getAirtimeAvailable());
+    TEST_ASSERT_EQUAL(LORA_DONE, waitResult(LORA_ACK_TX_TIMEOUT));
+
+    // Unconfirmed messages are charged once
+    budgetNow += LORA_BUDGET_WINDOW;
+    TEST_ASSERT_TRUE(radio.sendNoAckMsgBin(loraCfg, MESSAGE_PORT, message, sizeof(message)));
+    TEST_ASSERT_EQUAL_UINT32(loraWanAirtimeMs(loraCfg.band, loraCfg.uplink_dr, 4), radio.getLastAirtime());
+    TEST_ASSERT_EQUAL(LORA_DONE, waitResult(LORA_TX_TIMEOUT));
+}
+
+void test_send_path(void) {
+    LoRaConfig_t cfg = loraCfg;
+    const ModemEmulatorSettings_t& emu = MODEM_EMU_DEFAULT;
+
+    // Data rate change: set before the port
+    LoRaConfig_t fast = loraCfg;
+    fast.uplink_dr = DR2;
+    Exchange_t uplink = timedUplink(fast);
+    uint32_t airtime = loraWanAirtimeMs(fast.band, fast.uplink_dr, sizeof(message));
+    TEST_ASSERT_EQUAL_UINT32(3, uplink.commands);
+    TEST_ASSERT_EQUAL(DR2, modemSerial.modem.dataRate());
+    TEST_ASSERT_LESS_OR_EQUAL(replyBound(uplink) + airtime + emu.rxWindows, uplink.elapsed);
+
+    // First uplink after a boot: the data rate set by the boot is not set again, only the port and the message
+    TEST_ASSERT_TRUE(radio.initModem(cfg));
+    TEST_ASSERT_EQUAL(cfg.uplink_dr, modemSerial.modem.dataRate());
+    uplink = timedUplink(cfg);
+    airtime = loraWanAirtimeMs(cfg.band, cfg.uplink_dr, sizeof(message));
+    TEST_ASSERT_EQUAL_UINT32(2, uplink.commands);
+    TEST_ASSERT_GREATER_OR_EQUAL(airtime + emu.rxWindows, uplink.elapsed);
+    TEST_ASSERT_LESS_OR_EQUAL(replyBound(uplink) + airtime + emu.rxWindows, uplink.elapsed);
+    TEST_ASSERT_EQUAL_UINT32(uplink.elapsed, radio.getStageLatency(LORA_SENDING) + radio.getStageLatency(LORA_WAITING_DONE));
+
+    // Link check and downlink: answered in the first receive window, where the uplink ends
+    const uint8_t downlink[] = { 0xAB, 0xCD };
+    radio.requestLinkCheck();
+    modemSerial.modem.queueDownlink(3, downlink, sizeof(downlink));
+    uplink = timedUplink(cfg);
+    TEST_ASSERT_EQUAL_UINT32(3, uplink.commands);
+    TEST_ASSERT_GREATER_OR_EQUAL(airtime + (emu.rxWindows / 2), uplink.elapsed);
+    TEST_ASSERT_LESS_OR_EQUAL(replyBound(uplink) + airtime + (emu.rxWindows / 2), uplink.elapsed);
+    uint8_t margin;
+    uint8_t gateways;
+    TEST_ASSERT_TRUE(radio.getLinkCheck(margin, gateways));
+    TEST_ASSERT_EQUAL_UINT8(emu.linkMargin, margin);
+    TEST_ASSERT_EQUAL_UINT8(emu.gateways, gateways);
+    int16_t rssi;
+    int16_t snr;
+    TEST_ASSERT_TRUE(radio.getRxQuality(rssi, snr));
+    TEST_ASSERT_EQUAL_INT16(emu.rssi, rssi);
+    TEST_ASSERT_EQUAL_INT16(emu.snr, snr);
+    uint8_t port;
+    const uint8_t* data;
+    uint8_t len;
+    TEST_ASSERT_TRUE(radio.getDownlink(port, data, len));
+    TEST_ASSERT_EQUAL_UINT8(3, port);
+    TEST_ASSERT_EQUAL_UINT8(sizeof(downlink), len);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(downlink, data, sizeof(downlink));
+
+    // The next uplink has no feedback left from the previous one
+    uplink = timedUplink(cfg);
+    TEST_ASSERT_EQUAL_UINT32(2, uplink.commands);
+    TEST_ASSERT_FALSE(radio.getLinkCheck(margin, gateways));
+    TEST_ASSERT_FALSE(radio.getDownlink(port, data, len));
+}
+
+void test_send_path_throughput(void) {
+    // Back to back uplinks at AU920 DR3 (SF7): every one within its bound, and the host cost of the driver and the
+    // emulator per uplink
+    LoRaConfig_t cfg = loraCfg;
+    cfg.uplink_dr = DR3;
+    uint32_t airtime = loraWanAirtimeMs(cfg.band, cfg.uplink_dr, sizeof(message));
+    uint32_t simulated = 0;
+    clock_t start = clock();
+    for (uint16_t i = 0; i < THROUGHPUT_UPLINKS; i++) {
+        Exchange_t uplink = timedUplink(cfg);
+        TEST_ASSERT_LESS_OR_EQUAL(replyBound(uplink) + airtime + MODEM_EMU_DEFAULT.rxWindows, uplink.elapsed);
+        simulated += uplink.elapsed;
+    }
+    double hostUs = (double) (clock() - start) * 1e6 / CLOCKS_PER_SEC / THROUGHPUT_UPLINKS;
+
+    char text[80];
+    snprintf(text, sizeof(text), "uplink at DR3: %lu ms on the link, %.1f us of host time",
+             (unsigned long) (simulated / THROUGHPUT_UPLINKS), hostUs);
+    TEST_MESSAGE(text);
+}
+
+void test_otaa_boot_latency(void) {
+    // OTAA: the keys, then the join (one failed attempt first), reported by poll()
+    LoRaConfig_t cfg = loraCfg;
+    cfg.auth_mode = LWOTAA;
+    modemSerial.modem.failJoins(1);
+    Exchange_t boot = startExchange();
+    TEST_ASSERT_TRUE(radio.initModem(cfg));
+    TEST_ASSERT_EQUAL(LORA_ERROR, waitResult(LORA_JOIN_TIMEOUT));
+    TEST_ASSERT_FALSE(modemSerial.modem.isJoined());
+    TEST_ASSERT_TRUE(radio.initModem(cfg));
+    TEST_ASSERT_EQUAL(LORA_DONE, waitResult(LORA_JOIN_TIMEOUT));
+    endExchange(boot);
+    TEST_ASSERT_TRUE(modemSerial.modem.isJoined());
+
+    // Two boots of 16 commands (AppKey and JOIN instead of the ABP keys), with the join delay of each attempt
+    TEST_ASSERT_EQUAL_UINT32(2 * 16, boot.commands);
+    TEST_ASSERT_LESS_OR_EQUAL(replyBound(boot) + (2 * MODEM_EMU_DEFAULT.joinDelay), boot.elapsed);
+}
+
+int main(int argc, char** argv) {
+    (void) argc;
+    (void) argv;
+    setup();
+    radio.setBudgetClock(budgetClock);
+    UNITY_BEGIN();
+    RUN_TEST(test_boot);
+    RUN_TEST(test_result_is_reported_once);
+    RUN_TEST(test_error_is_reported_once);
+    RUN_TEST(test_oversize_message);
+    RUN_TEST(test_confirmed_retries_are_charged);
+    RUN_TEST(test_send_path);
+    RUN_TEST(test_send_path_throughput);
+    RUN_TEST(test_otaa_boot_latency);
+    return UNITY_END();
+}
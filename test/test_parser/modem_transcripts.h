@@ -0,0 +1,179 @@
+/**
+ * @file modem_transcripts.h
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief RHF0M003 reply transcripts (bytes as read from the modem serial port) with the events they decode to,
+ * replayed by the modem parser tests.
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ *
+ * Lines end with CR LF as sent by the modem; the boot transcript also has the blank lines of the modem banner.
+ */
+#ifndef __MODEM_TRANSCRIPTS_H__
+#define __MODEM_TRANSCRIPTS_H__
+
+#include "AgroTechLab_ModemParser.h"
+
+/**
+ * @struct ExpectedEvent_t
+ * @brief Event of a transcript line. The values depend on the type: error code (\ref MODEM_EVENT_ERROR), RSSI and
+ * SNR (\ref MODEM_EVENT_RX_QUALITY), margin and gateways (\ref MODEM_EVENT_LINK_CHECK), port and payload size
+ * (\ref MODEM_EVENT_DOWNLINK).
+ */
+typedef struct {
+    ModemEventType_e type;
+    ModemTag_e tag;
+    int16_t first;
+    int16_t second;
+} ExpectedEvent_t;
+
+/**
+ * @struct Transcript_t
+ * @brief Reply bytes and their events.
+ */
+typedef struct {
+    const char* name;
+    const char* text;
+    const ExpectedEvent_t* events;
+    uint8_t count;
+} Transcript_t;
+
+/** Configuration at boot (\c LoRa::initModem()). */
+static const char BOOT_TEXT[] =
+    "\r\n+AT: OK\r\n"
+    "+ID: DevAddr, 26:01:1B:25\r\n"
+    "+MODE: LWABP\r\n"
+    "+DR: AU920\r\n"
+    "+CLASS: A\r\n"
+    "+POWER: 14\r\n"
+    "+ADR: OFF\r\n"
+    "+RXWIN2: 923.3, DR8\r\n"
+    "+RETRY: 3\r\n"
+    "+DR: DR0\r\n"
+    "+DR: AU920 DR0  SF10 BW125K \r\n";
+static const ExpectedEvent_t BOOT_EVENTS[] = {
+    {MODEM_EVENT_OK, MODEM_TAG_AT, 0, 0},
+    {MODEM_EVENT_LINE, MODEM_TAG_OTHER, 0, 0},
+    {MODEM_EVENT_LINE, MODEM_TAG_OTHER, 0, 0},
+    {MODEM_EVENT_LINE, MODEM_TAG_DR, 0, 0},
+    {MODEM_EVENT_LINE, MODEM_TAG_OTHER, 0, 0},
+    {MODEM_EVENT_LINE, MODEM_TAG_OTHER, 0, 0},
+    {MODEM_EVENT_LINE, MODEM_TAG_OTHER, 0, 0},
+    {MODEM_EVENT_LINE, MODEM_TAG_OTHER, 0, 0},
+    {MODEM_EVENT_LINE, MODEM_TAG_OTHER, 0, 0},
+    {MODEM_EVENT_LINE, MODEM_TAG_DR, 0, 0},
+    {MODEM_EVENT_LINE, MODEM_TAG_DR, 0, 0}
+};
+
+/** Unconfirmed uplink without downlink. */
+static const char UPLINK_TEXT[] =
+    "+PORT: 1\r\n"
+    "+MSGHEX: Start\r\n"
+    "+MSGHEX: Done\r\n";
+static const ExpectedEvent_t UPLINK_EVENTS[] = {
+    {MODEM_EVENT_LINE, MODEM_TAG_PORT, 0, 0},
+    {MODEM_EVENT_START, MODEM_TAG_MSG, 0, 0},
+    {MODEM_EVENT_DONE, MODEM_TAG_MSG, 0, 0}
+};
+
+/** Unconfirmed uplink with a link check request, answered with a downlink. */
+static const char LINK_CHECK_TEXT[] =
+    "+LW: LCR\r\n"
+    "+PORT: 1\r\n"
+    "+MSGHEX: Start\r\n"
+    "+MSGHEX: Link 20, 1\r\n"
+    "+MSGHEX: PORT: 2; RX: \"0A0b\"\r\n"
+    "+MSGHEX: RXWIN1, RSSI -106, SNR -12.5\r\n"
+    "+MSGHEX: Done\r\n";
+static const ExpectedEvent_t LINK_CHECK_EVENTS[] = {
+    {MODEM_EVENT_LINE, MODEM_TAG_LW, 0, 0},
+    {MODEM_EVENT_LINE, MODEM_TAG_PORT, 0, 0},
+    {MODEM_EVENT_START, MODEM_TAG_MSG, 0, 0},
+    {MODEM_EVENT_LINK_CHECK, MODEM_TAG_MSG, 20, 1},
+    {MODEM_EVENT_DOWNLINK, MODEM_TAG_MSG, 2, 2},
+    {MODEM_EVENT_RX_QUALITY, MODEM_TAG_MSG, -106, -125},
+    {MODEM_EVENT_DONE, MODEM_TAG_MSG, 0, 0}
+};
+
+/** Confirmed uplink, acknowledged in the second receive window. */
+static const char CONFIRMED_TEXT[] =
+    "+CMSGHEX: Start\r\n"
+    "+CMSGHEX: Wait ACK\r\n"
+    "+CMSGHEX: ACK Received\r\n"
+    "+CMSGHEX: RXWIN2, RSSI -72, SNR 8.5\r\n"
+    "+CMSGHEX: Done\r\n";
+static const ExpectedEvent_t CONFIRMED_EVENTS[] = {
+    {MODEM_EVENT_START, MODEM_TAG_CMSG, 0, 0},
+    {MODEM_EVENT_LINE, MODEM_TAG_CMSG, 0, 0},
+    {MODEM_EVENT_LINE, MODEM_TAG_CMSG, 0, 0},
+    {MODEM_EVENT_RX_QUALITY, MODEM_TAG_CMSG, -72, 85},
+    {MODEM_EVENT_DONE, MODEM_TAG_CMSG, 0, 0}
+};
+
+/** OTAA join, failed once. */
+static const char JOIN_TEXT[] =
+    "+JOIN: Start\r\n"
+    "+JOIN: NORMAL\r\n"
+    "+JOIN: Join failed\r\n"
+    "+JOIN: Done\r\n"
+    "+JOIN: Start\r\n"
+    "+JOIN: NORMAL\r\n"
+    "+JOIN: Network joined\r\n"
+    "+JOIN: NetID 000013 DevAddr 26:01:1B:25\r\n"
+    "+JOIN: Done\r\n"
+    "+JOIN: Joined already\r\n";
+static const ExpectedEvent_t JOIN_EVENTS[] = {
+    {MODEM_EVENT_START, MODEM_TAG_JOIN, 0, 0},
+    {MODEM_EVENT_LINE, MODEM_TAG_JOIN, 0, 0},
+    {MODEM_EVENT_FAILED, MODEM_TAG_JOIN, 0, 0},
+    {MODEM_EVENT_DONE, MODEM_TAG_JOIN, 0, 0},
+    {MODEM_EVENT_START, MODEM_TAG_JOIN, 0, 0},
+    {MODEM_EVENT_LINE, MODEM_TAG_JOIN, 0, 0},
+    {MODEM_EVENT_JOINED, MODEM_TAG_JOIN, 0, 0},
+    {MODEM_EVENT_LINE, MODEM_TAG_JOIN, 0, 0},
+    {MODEM_EVENT_DONE, MODEM_TAG_JOIN, 0, 0},
+    {MODEM_EVENT_JOINED, MODEM_TAG_JOIN, 0, 0}
+};
+
+/** Faults: command errors, busy modem, no free channel and a message too long for the data rate. */
+static const char FAULTS_TEXT[] =
+    "+PORT: ERROR(-1)\r\n"
+    "+MSGHEX: LoRaWAN modem is busy\r\n"
+    "+MSGHEX: No free channel\r\n"
+    "+MSGHEX: Done\r\n"
+    "+MSGHEX: Length error 11\r\n"
+    "+CMSGHEX: ERROR(-12)\r\n"
+    "+DR: ERROR(-10)\r\n";
+static const ExpectedEvent_t FAULTS_EVENTS[] = {
+    {MODEM_EVENT_ERROR, MODEM_TAG_PORT, -1, 0},
+    {MODEM_EVENT_FAILED, MODEM_TAG_MSG, 0, 0},
+    {MODEM_EVENT_FAILED, MODEM_TAG_MSG, 0, 0},
+    {MODEM_EVENT_DONE, MODEM_TAG_MSG, 0, 0},
+    {MODEM_EVENT_ERROR, MODEM_TAG_MSG, 0, 0},
+    {MODEM_EVENT_ERROR, MODEM_TAG_CMSG, -12, 0},
+    {MODEM_EVENT_ERROR, MODEM_TAG_DR, -10, 0}
+};
+
+#define TRANSCRIPT(name, prefix) { name, prefix##_TEXT, prefix##_EVENTS, sizeof(prefix##_EVENTS) / sizeof(ExpectedEvent_t) }
+
+/** Every transcript. */
+static const Transcript_t TRANSCRIPTS[] = {
+    TRANSCRIPT("boot", BOOT),
+    TRANSCRIPT("uplink", UPLINK),
+    TRANSCRIPT("link check", LINK_CHECK),
+    TRANSCRIPT("confirmed", CONFIRMED),
+    TRANSCRIPT("join", JOIN),
+    TRANSCRIPT("faults", FAULTS)
+};
+
+#undef TRANSCRIPT
+
+#endif // __MODEM_TRANSCRIPTS_H__
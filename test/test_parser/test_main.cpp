@@ -0,0 +1,252 @@
+/**
+ * @file test_main.cpp
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief Modem parser tests of the native build: transcript replay, number parsing, fuzzing and throughput.
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unity.h>
+#include "modem_transcripts.h"
+
+/**
+ * \def FUZZ_ROUNDS
+ * Mutated transcripts fed by the fuzz test.
+ */
+#define FUZZ_ROUNDS                     20000
+
+/**
+ * \def THROUGHPUT_BYTES
+ * Transcript bytes fed by the throughput test (at least).
+ */
+#define THROUGHPUT_BYTES                20000000UL
+
+/**
+ * \def MODEM_BYTES_PER_S
+ * Byte rate of the modem serial port (9600 baud, 10 bits per byte).
+ */
+#define MODEM_BYTES_PER_S               960UL
+
+static const uint8_t TRANSCRIPT_COUNT = sizeof(TRANSCRIPTS) / sizeof(TRANSCRIPTS[0]);
+
+static uint32_t seed = 1;
+
+/** Pseudo-random number in <tt>0 .. range-1</tt> (LCG, the same sequence on every run). */
+static uint32_t nextRandom(uint32_t range) {
+    seed = (seed * 1103515245UL) + 12345UL;
+    return (seed >> 8) % range;
+}
+
+/** Check the fields of \p event that hold for any input. */
+static void assertSane(const ModemEvent_t& event) {
+    TEST_ASSERT_TRUE(event.type <= MODEM_EVENT_DOWNLINK);
+    TEST_ASSERT_TRUE(event.tag <= MODEM_TAG_OTHER);
+    TEST_ASSERT_LESS_OR_EQUAL(MODEM_DOWNLINK_SIZE, event.len);
+    TEST_ASSERT_NOT_NULL(event.data);
+}
+
+/** Feed \p transcript into \p parser and compare its events with the expected ones. */
+static void assertTranscript(ModemParser& parser, const Transcript_t& transcript) {
+    uint8_t events = 0;
+    for (const char* c = transcript.text; *c != '\0'; c++) {
+        if (!parser.feed(*c)) {
+            continue;
+        }
+        TEST_ASSERT_EQUAL_MESSAGE('\n', *c, transcript.name);
+        TEST_ASSERT_LESS_THAN_MESSAGE(transcript.count, events, transcript.name);
+        const ExpectedEvent_t& expected = transcript.events[events++];
+        const ModemEvent_t& event = parser.event();
+        assertSane(event);
+        TEST_ASSERT_EQUAL_MESSAGE(expected.type, event.type, transcript.name);
+        TEST_ASSERT_EQUAL_MESSAGE(expected.tag, event.tag, transcript.name);
+        switch (expected.type) {
+            case MODEM_EVENT_ERROR:
+                TEST_ASSERT_EQUAL_INT16(expected.first, event.error);
+                break;
+            case MODEM_EVENT_RX_QUALITY:
+                TEST_ASSERT_EQUAL_INT16(expected.first, event.rssi);
+                TEST_ASSERT_EQUAL_INT16(expected.second, event.snr);
+                break;
+            case MODEM_EVENT_LINK_CHECK:
+                TEST_ASSERT_EQUAL_UINT8(expected.first, event.margin);
+                TEST_ASSERT_EQUAL_UINT8(expected.second, event.gateways);
+                break;
+            case MODEM_EVENT_DOWNLINK:
+                TEST_ASSERT_EQUAL_UINT8(expected.first, event.port);
+                TEST_ASSERT_EQUAL_UINT8(expected.second, event.len);
+                break;
+            default:
+                break;
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT8_MESSAGE(transcript.count, events, transcript.name);
+}
+
+void setUp(void) { }
+
+void tearDown(void) { }
+
+void test_transcripts(void) {
+    // One parser for the whole session, as on the station
+    ModemParser parser;
+    for (uint8_t i = 0; i < TRANSCRIPT_COUNT; i++) {
+        assertTranscript(parser, TRANSCRIPTS[i]);
+    }
+
+    // Downlink payload of the link check transcript
+    ModemParser downlink;
+    for (const char* c = LINK_CHECK_TEXT; *c != '\0'; c++) {
+        if (downlink.feed(*c) && (downlink.event().type == MODEM_EVENT_DOWNLINK)) {
+            const uint8_t expected[] = { 0x0A, 0x0B };
+            TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, downlink.event().data, sizeof(expected));
+        }
+    }
+}
+
+void test_tags(void) {
+    ModemParser parser;
+    const char* line = "+MSGHEX: Done\n";
+    while (!parser.feed(*line++)) { }
+    TEST_ASSERT_TRUE(parser.isTag("MSGHEX", 6));
+    TEST_ASSERT_FALSE(parser.isTag("MSG", 3));
+
+    // An error is never overridden by a later keyword of the line
+    line = "+DR: ERROR(-10) Done\n";
+    while (!parser.feed(*line++)) { }
+    TEST_ASSERT_EQUAL(MODEM_EVENT_ERROR, parser.event().type);
+    TEST_ASSERT_EQUAL_INT16(-10, parser.event().error);
+
+    // Tags and words longer than the parser keeps
+    line = "+VERYLONGTAGNAME: RSSIRSSIRSSIRSSI -5\n";
+    while (!parser.feed(*line++)) { }
+    TEST_ASSERT_EQUAL(MODEM_TAG_OTHER, parser.event().tag);
+    TEST_ASSERT_FALSE(parser.isTag("VERYLONGT", 9));
+    TEST_ASSERT_EQUAL(MODEM_EVENT_LINE, parser.event().type);
+}
+
+void test_parse_tenths(void) {
+    int16_t value = 0;
+    TEST_ASSERT_TRUE(parseTenths("12", value));
+    TEST_ASSERT_EQUAL_INT16(120, value);
+    TEST_ASSERT_TRUE(parseTenths("  -12.5", value));
+    TEST_ASSERT_EQUAL_INT16(-125, value);
+    TEST_ASSERT_TRUE(parseTenths("4.56", value));
+    TEST_ASSERT_EQUAL_INT16(45, value);
+    TEST_ASSERT_TRUE(parseTenths("-0.5", value));
+    TEST_ASSERT_EQUAL_INT16(-5, value);
+    TEST_ASSERT_TRUE(parseTenths("7.", value));
+    TEST_ASSERT_EQUAL_INT16(70, value);
+    TEST_ASSERT_FALSE(parseTenths("-", value));
+    TEST_ASSERT_FALSE(parseTenths("SNR", value));
+    TEST_ASSERT_FALSE(parseTenths("", value));
+
+    // Out of range numbers saturate instead of wrapping
+    TEST_ASSERT_TRUE(parseTenths("3276.7", value));
+    TEST_ASSERT_EQUAL_INT16(INT16_MAX, value);
+    TEST_ASSERT_TRUE(parseTenths("3277", value));
+    TEST_ASSERT_EQUAL_INT16(INT16_MAX, value);
+    TEST_ASSERT_TRUE(parseTenths("-999999999", value));
+    TEST_ASSERT_EQUAL_INT16(-INT16_MAX, value);
+}
+
+void test_fuzz(void) {
+    // Mutated transcripts (bytes replaced, inserted or dropped, random bytes included): every event stays within
+    // its ranges, and the next clean transcript is parsed exactly once a line ends
+    static char mutated[512];
+    ModemParser parser;
+    uint32_t lines = 0;
+    for (uint16_t round = 0; round < FUZZ_ROUNDS; round++) {
+        const Transcript_t& transcript = TRANSCRIPTS[nextRandom(TRANSCRIPT_COUNT)];
+        size_t len = 0;
+        for (const char* c = transcript.text; (*c != '\0') && (len < (sizeof(mutated) - 2)); c++) {
+            switch (nextRandom(32)) {
+                case 0:
+                    mutated[len++] = (char) nextRandom(256);
+                    break;
+                case 1:
+                    mutated[len++] = (char) nextRandom(256);
+                    mutated[len++] = *c;
+                    break;
+                case 2:
+                    break;
+                case 3:
+                    mutated[len++] = "+:\"\n-.,; "[nextRandom(9)];
+                    break;
+                default:
+                    mutated[len++] = *c;
+                    break;
+            }
+        }
+        for (size_t i = 0; i < len; i++) {
+            if (parser.feed(mutated[i])) {
+                assertSane(parser.event());
+                lines++;
+            }
+        }
+        parser.feed('\n');
+        assertTranscript(parser, TRANSCRIPTS[nextRandom(TRANSCRIPT_COUNT)]);
+    }
+    TEST_ASSERT_GREATER_THAN(FUZZ_ROUNDS, lines);
+
+    // Long lines without terminator, then random bytes only
+    for (uint16_t i = 0; i < 1000; i++) {
+        parser.feed('"');
+        parser.feed('A');
+    }
+    for (uint32_t i = 0; i < 1000000UL; i++) {
+        if (parser.feed((char) nextRandom(256))) {
+            assertSane(parser.event());
+        }
+    }
+    parser.feed('\n');
+    assertTranscript(parser, TRANSCRIPTS[2]);
+}
+
+void test_throughput(void) {
+    // The parser runs from the receive path, so a byte must cost far less than its time on the wire
+    ModemParser parser;
+    uint32_t bytes = 0;
+    uint32_t lines = 0;
+    clock_t start = clock();
+    while (bytes < THROUGHPUT_BYTES) {
+        for (uint8_t i = 0; i < TRANSCRIPT_COUNT; i++) {
+            for (const char* c = TRANSCRIPTS[i].text; *c != '\0'; c++) {
+                lines += parser.feed(*c) ? 1 : 0;
+                bytes++;
+            }
+        }
+    }
+    double seconds = (double) (clock() - start) / CLOCKS_PER_SEC;
+    TEST_ASSERT_GREATER_THAN(0, lines);
+
+    double rate = bytes / ((seconds > 0) ? seconds : 1e-9);
+    TEST_ASSERT_TRUE(rate > (1000.0 * MODEM_BYTES_PER_S));
+
+    char message[80];
+    snprintf(message, sizeof(message), "%.1f MB/s, %.1f ns per byte, %lu lines", rate / 1e6, 1e9 / rate,
+             (unsigned long) lines);
+    TEST_MESSAGE(message);
+}
+
+int main(int argc, char** argv) {
+    (void) argc;
+    (void) argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_transcripts);
+    RUN_TEST(test_tags);
+    RUN_TEST(test_parse_tenths);
+    RUN_TEST(test_fuzz);
+    RUN_TEST(test_throughput);
+    return UNITY_END();
+}
@@ -0,0 +1,269 @@
+/**
+ * @file test_main.cpp
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief Uplink payload tests of the native build: encode / decode round trips of every field at its limits and
+ * with its invalid flag, for the packed, delta and Cayenne LPP formats.
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#include <unity.h>
+#include "AgroTechLab_Airtime.h"
+#include "ats_01_payload.h"
+
+/** Lowest value of each field (see \ref STATION_SENSORS_T). */
+static const int32_t FIELD_MIN[SENSOR_FIELDS] = { -8192, 0, 0, 0, 0 };
+
+/** Highest value of each field. */
+static const int32_t FIELD_MAX[SENSOR_FIELDS] = { 8191, 1023, 65535, 15, 16383 };
+
+/** A typical reading (all fields valid). */
+static STATION_SENSORS_T typical() {
+    STATION_SENSORS_T data;
+    data.set(SENSOR_AIR_TEMPERATURE, 2150);
+    data.set(SENSOR_AIR_HUMIDITY, 655);
+    data.set(SENSOR_LIGHT, 12000);
+    data.set(SENSOR_UV_INDEX, 3);
+    data.set(SENSOR_BATTERY_VOLTAGE, 3900);
+    return data;
+}
+
+/** Check that \p actual holds the same readings (and flags) as \p expected. */
+static void assertSameReading(const STATION_SENSORS_T& expected, const STATION_SENSORS_T& actual) {
+    for (uint8_t i = 0; i < SENSOR_FIELDS; i++) {
+        SensorField_e field = (SensorField_e) i;
+        TEST_ASSERT_EQUAL(expected.isValid(field), actual.isValid(field));
+        TEST_ASSERT_EQUAL_INT32(expected.value(field), actual.value(field));
+    }
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected.bytes, actual.bytes, STATION_RECORD_SIZE);
+}
+
+/** Encode \p data as a packed frame, decode it and compare. */
+static void assertPackedRoundTrip(const STATION_SENSORS_T& data) {
+    uint8_t buf[PayloadEncoder<PAYLOAD_PACKED>::MAX_SIZE];
+    PayloadEncoder<PAYLOAD_PACKED> encoder;
+    STATION_SENSORS_T decoded;
+    TEST_ASSERT_EQUAL_UINT8(PAYLOAD_SIZE, encoder.encode(data, buf));
+    TEST_ASSERT_TRUE(decodePayload(buf, PAYLOAD_SIZE, decoded));
+    assertSameReading(data, decoded);
+}
+
+void setUp(void) { }
+
+void tearDown(void) { }
+
+void test_packed_field_limits(void) {
+    for (uint8_t i = 0; i < SENSOR_FIELDS; i++) {
+        SensorField_e field = (SensorField_e) i;
+        const int32_t limits[] = { FIELD_MIN[i], FIELD_MAX[i] };
+        for (uint8_t k = 0; k < 2; k++) {
+            // Alone and among the other fields
+            STATION_SENSORS_T alone;
+            TEST_ASSERT_TRUE(alone.set(field, limits[k]));
+            assertPackedRoundTrip(alone);
+            TEST_ASSERT_EQUAL_INT32(limits[k], alone.value(field));
+
+            STATION_SENSORS_T full = typical();
+            TEST_ASSERT_TRUE(full.set(field, limits[k]));
+            assertPackedRoundTrip(full);
+        }
+
+        // All other fields at their limits (no bits of a neighbour leak into the field)
+        STATION_SENSORS_T extremes;
+        for (uint8_t j = 0; j < SENSOR_FIELDS; j++) {
+            extremes.set((SensorField_e) j, ((j % 2) == 0) ? FIELD_MAX[j] : FIELD_MIN[j]);
+        }
+        extremes.set(field, FIELD_MIN[i]);
+        assertPackedRoundTrip(extremes);
+        extremes.set(field, FIELD_MAX[i]);
+        assertPackedRoundTrip(extremes);
+    }
+}
+
+void test_packed_out_of_range_is_invalid(void) {
+    for (uint8_t i = 0; i < SENSOR_FIELDS; i++) {
+        SensorField_e field = (SensorField_e) i;
+        STATION_SENSORS_T data = typical();
+        TEST_ASSERT_FALSE(data.set(field, FIELD_MAX[i] + 1));
+        TEST_ASSERT_FALSE(data.isValid(field));
+        TEST_ASSERT_EQUAL_UINT16(0, data.get(field));
+        assertPackedRoundTrip(data);
+
+        data = typical();
+        TEST_ASSERT_FALSE(data.set(field, FIELD_MIN[i] - 1));
+        TEST_ASSERT_FALSE(data.isValid(field));
+        assertPackedRoundTrip(data);
+    }
+}
+
+void test_packed_invalid_flag(void) {
+    // Every combination of validity flags
+    for (uint8_t flags = 0; flags < (1 << SENSOR_FIELDS); flags++) {
+        STATION_SENSORS_T data = typical();
+        for (uint8_t i = 0; i < SENSOR_FIELDS; i++) {
+            if ((flags & (1 << i)) == 0) {
+                data.invalidate((SensorField_e) i);
+            }
+        }
+        TEST_ASSERT_EQUAL_UINT8(flags, data.bytes[0] & ((1 << SENSOR_FIELDS) - 1));
+        assertPackedRoundTrip(data);
+    }
+
+    // An invalid field has no bits, so equal readings have equal bytes
+    STATION_SENSORS_T a = typical();
+    STATION_SENSORS_T b = typical();
+    b.set(SENSOR_LIGHT, 1);
+    a.invalidate(SENSOR_LIGHT);
+    b.invalidate(SENSOR_LIGHT);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(a.bytes, b.bytes, STATION_RECORD_SIZE);
+}
+
+void test_packed_rejects_malformed(void) {
+    uint8_t buf[PAYLOAD_SIZE];
+    STATION_SENSORS_T decoded;
+    encodePayload(typical(), buf);
+    TEST_ASSERT_FALSE(decodePayload(buf, PAYLOAD_SIZE - 1, decoded));
+    TEST_ASSERT_FALSE(decodePayload(buf, PAYLOAD_SIZE + 1, decoded));
+    buf[PAYLOAD_SIZE - 1] |= 0x80;      // spare bit
+    TEST_ASSERT_FALSE(decodePayload(buf, PAYLOAD_SIZE, decoded));
+}
+
+void test_delta_round_trip(void) {
+    PayloadEncoder<PAYLOAD_DELTA> encoder;
+    PayloadDeltaDecoder decoder;
+    uint8_t buf[PayloadEncoder<PAYLOAD_DELTA>::MAX_SIZE];
+    STATION_SENSORS_T decoded;
+
+    // Jumps between the limits of every field, and fields turning invalid and valid again
+    STATION_SENSORS_T data = typical();
+    uint8_t frames = 0;
+    for (uint8_t i = 0; i < SENSOR_FIELDS; i++) {
+        SensorField_e field = (SensorField_e) i;
+        const int32_t steps[] = { FIELD_MIN[i], FIELD_MAX[i], FIELD_MIN[i], -1, FIELD_MAX[i] };
+        for (uint8_t k = 0; k < 5; k++) {
+            if (steps[k] == -1) {
+                data.invalidate(field);
+            } else {
+                data.set(field, steps[k]);
+            }
+            uint8_t len = encoder.encode(data, buf);
+            TEST_ASSERT_LESS_OR_EQUAL(PayloadEncoder<PAYLOAD_DELTA>::MAX_SIZE, len);
+            TEST_ASSERT_EQUAL((frames % (PAYLOAD_DELTA_KEYFRAME_PERIOD + 1)) == 0, buf[0] == PAYLOAD_DELTA_KEYFRAME);
+            TEST_ASSERT_TRUE(decoder.decode(buf, len, decoded));
+            assertSameReading(data, decoded);
+            frames++;
+        }
+    }
+
+    // An unchanged reading is the header only
+    uint8_t len = encoder.encode(data, buf);
+    if (buf[0] != PAYLOAD_DELTA_KEYFRAME) {
+        TEST_ASSERT_EQUAL_UINT8(1, len);
+    }
+    TEST_ASSERT_TRUE(decoder.decode(buf, len, decoded));
+    assertSameReading(data, decoded);
+}
+
+void test_delta_reset_and_malformed(void) {
+    PayloadEncoder<PAYLOAD_DELTA> encoder;
+    PayloadDeltaDecoder decoder;
+    uint8_t buf[PayloadEncoder<PAYLOAD_DELTA>::MAX_SIZE];
+    STATION_SENSORS_T decoded;
+    STATION_SENSORS_T data = typical();
+
+    uint8_t len = encoder.encode(data, buf);
+    TEST_ASSERT_EQUAL_HEX8(PAYLOAD_DELTA_KEYFRAME, buf[0]);
+    TEST_ASSERT_FALSE(decoder.decode(buf, len - 1, decoded));
+    TEST_ASSERT_TRUE(decoder.decode(buf, len, decoded));
+
+    // A delta frame with a truncated varint loses the sync until the next key frame
+    data.set(SENSOR_LIGHT, 60000);
+    len = encoder.encode(data, buf);
+    TEST_ASSERT_NOT_EQUAL(PAYLOAD_DELTA_KEYFRAME, buf[0]);
+    TEST_ASSERT_FALSE(decoder.decode(buf, len - 1, decoded));
+    data.set(SENSOR_LIGHT, 100);
+    len = encoder.encode(data, buf);
+    TEST_ASSERT_FALSE(decoder.decode(buf, len, decoded));
+
+    // After a failed uplink the encoder restarts with a key frame
+    encoder.reset();
+    len = encoder.encode(data, buf);
+    TEST_ASSERT_EQUAL_HEX8(PAYLOAD_DELTA_KEYFRAME, buf[0]);
+    TEST_ASSERT_TRUE(decoder.decode(buf, len, decoded));
+    assertSameReading(data, decoded);
+
+    // Delta frames before any key frame are rejected
+    PayloadDeltaDecoder fresh;
+    data.set(SENSOR_UV_INDEX, 7);
+    len = encoder.encode(data, buf);
+    TEST_ASSERT_FALSE(fresh.decode(buf, len, decoded));
+    TEST_ASSERT_FALSE(fresh.decode(buf, 0, decoded));
+}
+
+void test_cayenne_limits_and_invalid(void) {
+    PayloadEncoder<PAYLOAD_CAYENNE_LPP> encoder;
+    uint8_t buf[PayloadEncoder<PAYLOAD_CAYENNE_LPP>::MAX_SIZE];
+
+    // All fields valid: the largest frame
+    STATION_SENSORS_T data;
+    data.set(SENSOR_AIR_TEMPERATURE, FIELD_MIN[SENSOR_AIR_TEMPERATURE]);
+    data.set(SENSOR_AIR_HUMIDITY, 1000);
+    data.set(SENSOR_LIGHT, FIELD_MAX[SENSOR_LIGHT]);
+    data.set(SENSOR_UV_INDEX, FIELD_MAX[SENSOR_UV_INDEX]);
+    data.set(SENSOR_BATTERY_VOLTAGE, FIELD_MAX[SENSOR_BATTERY_VOLTAGE]);
+    const uint8_t expected[] = {
+        LPP_CH_AIR_TEMPERATURE, LPP_TYPE_TEMPERATURE, 0xFC, 0xCD,       // -819.2 => -819 (0.1 oC)
+        LPP_CH_AIR_HUMIDITY, LPP_TYPE_HUMIDITY, 200,                    // 100.0 %
+        LPP_CH_LIGHT, LPP_TYPE_LUMINOSITY, 0xFF, 0xFF,
+        LPP_CH_UV_INDEX, LPP_TYPE_ANALOG_INPUT, 0x05, 0xDC,             // 15.00
+        LPP_CH_BATTERY_VOLTAGE, LPP_TYPE_ANALOG_INPUT, 0x06, 0x66       // 16.38 V
+    };
+    TEST_ASSERT_EQUAL_UINT8(sizeof(expected), encoder.encode(data, buf));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, buf, sizeof(expected));
+
+    // Invalid fields (and a humidity above the LPP range) are omitted
+    data.set(SENSOR_AIR_HUMIDITY, FIELD_MAX[SENSOR_AIR_HUMIDITY]);
+    data.invalidate(SENSOR_LIGHT);
+    TEST_ASSERT_EQUAL_UINT8(12, encoder.encode(data, buf));
+    TEST_ASSERT_EQUAL_UINT8(LPP_CH_UV_INDEX, buf[4]);
+
+    STATION_SENSORS_T none;
+    TEST_ASSERT_EQUAL_UINT8(0, encoder.encode(none, buf));
+}
+
+void test_formats_fit_the_uplink(void) {
+    // AU920 DR0 uplinks carry 11 bytes: only the packed frame fits, the other formats are refused at boot
+    uint8_t au920Dr0 = loraMaxPayload(AU920, DR0);
+    TEST_ASSERT_TRUE(payloadFits<PAYLOAD_PACKED>(au920Dr0));
+    TEST_ASSERT_FALSE(payloadFits<PAYLOAD_CAYENNE_LPP>(au920Dr0));
+    TEST_ASSERT_FALSE(payloadFits<PAYLOAD_DELTA>(au920Dr0));
+
+    // EU868 DR0 uplinks carry 51 bytes
+    uint8_t eu868Dr0 = loraMaxPayload(EU868, DR0);
+    TEST_ASSERT_TRUE(payloadFits<PAYLOAD_PACKED>(eu868Dr0));
+    TEST_ASSERT_TRUE(payloadFits<PAYLOAD_CAYENNE_LPP>(eu868Dr0));
+    TEST_ASSERT_TRUE(payloadFits<PAYLOAD_DELTA>(eu868Dr0));
+}
+
+int main(int argc, char** argv) {
+    (void) argc;
+    (void) argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_packed_field_limits);
+    RUN_TEST(test_packed_out_of_range_is_invalid);
+    RUN_TEST(test_packed_invalid_flag);
+    RUN_TEST(test_packed_rejects_malformed);
+    RUN_TEST(test_delta_round_trip);
+    RUN_TEST(test_delta_reset_and_malformed);
+    RUN_TEST(test_cayenne_limits_and_invalid);
+    RUN_TEST(test_formats_fit_the_uplink);
+    return UNITY_END();
+}
@@ -0,0 +1,255 @@
+/**
+ * @file test_main.cpp
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief Report-on-change tests of the native build: deadbands and heartbeat of \ref ReportPolicy, and the uplinks
+ * of day traces replayed through \ref ReportSimulator against the fixed cadence.
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#include <math.h>
+#include <stdio.h>
+#include <unity.h>
+#include "ats_01_report.h"
+
+/**
+ * \def DAY_READINGS
+ * Readings of a day trace (one per minute).
+ */
+#define DAY_READINGS                    1440
+
+/**
+ * \def SAMPLE_PERIOD
+ * Sampling period of the day traces (in ms).
+ */
+#define SAMPLE_PERIOD                   60000UL
+
+/**
+ * \def HEARTBEAT
+ * Longest interval without a report (in ms).
+ */
+#define HEARTBEAT                       3600000UL
+
+/** Deadbands of the station (see \c reportDeadband in \c ats_01.h). */
+static const ReportDeadband_t STATION_DEADBAND = {
+    { 30, 20, 5, 1, 100 },
+    { 0, 0, 10, 0, 0 },
+    HEARTBEAT
+};
+
+/** The station deadbands with a relative band of 10 % on the air temperature too. */
+static const ReportDeadband_t RELATIVE_DEADBAND = {
+    { 30, 20, 5, 1, 100 },
+    { 10, 0, 10, 0, 0 },
+    HEARTBEAT
+};
+
+static uint32_t seed = 1;
+
+/** Pseudo-random number in <tt>0 .. range-1</tt> (LCG, the same sequence on every run). */
+static uint32_t nextRandom(uint32_t range) {
+    seed = (seed * 1103515245UL) + 12345UL;
+    return (seed >> 8) % range;
+}
+
+/** A reading with every field valid. */
+static STATION_SENSORS_T reading(int32_t temperature, int32_t humidity, int32_t light, int32_t uv, int32_t battery) {
+    STATION_SENSORS_T data;
+    data.set(SENSOR_AIR_TEMPERATURE, temperature);
+    data.set(SENSOR_AIR_HUMIDITY, humidity);
+    data.set(SENSOR_LIGHT, light);
+    data.set(SENSOR_UV_INDEX, uv);
+    data.set(SENSOR_BATTERY_VOLTAGE, battery);
+    return data;
+}
+
+/** Reference reading of the deadband tests: 20 oC, 60 % RH, 1000 lux, UV index 3, 4 V. */
+static STATION_SENSORS_T base() {
+    return reading(2000, 600, 1000, 3, 4000);
+}
+
+/**
+ * Reading \p i of a day trace as the station simulation (\c ats_01_sim.cpp) makes it: temperature peak at 15 h,
+ * light and UV peak at noon and the battery discharging. A cloudy day has passing clouds (light down to a fifth
+ * and UV index one lower) and DHT noise of one step.
+ */
+static STATION_SENSORS_T dayReading(uint16_t i, bool cloudy, bool& cloud) {
+    const double PI_12 = 3.14159265358979 / 12.0;
+    double hour = i / 60.0;
+    double sun = sin((hour - 6.0) * PI_12);
+    double warmth = sin((hour - 9.0) * PI_12);
+    int32_t noise = cloudy ? ((int32_t) nextRandom(3) - 1) : 0;
+    if (cloudy && (nextRandom(15) == 0)) {
+        cloud = !cloud;
+    }
+    double shade = cloud ? 0.2 : 1.0;
+    return reading(10 * (lround(180.0 + (80.0 * warmth)) + noise), lround(700.0 - (200.0 * warmth)) - noise,
+                   (sun > 0.0) ? lround(60000.0 * sun * shade) : 0,
+                   (sun > 0.0) ? (lround(10.0 * sun) - (cloud ? 1 : 0)) : 0, 4100 - (i / 60));
+}
+
+/** Replay a day trace through \p simulator. */
+static void replayDay(ReportSimulator& simulator, bool cloudy) {
+    bool cloud = false;
+    seed = 1;
+    for (uint16_t i = 0; i < DAY_READINGS; i++) {
+        simulator.feed(dayReading(i, cloudy, cloud));
+    }
+}
+
+void setUp(void) { }
+
+void tearDown(void) { }
+
+void test_first_reading_is_due(void) {
+    ReportPolicy policy(STATION_DEADBAND);
+    TEST_ASSERT_TRUE(policy.due(base(), 0));
+    TEST_ASSERT_TRUE(policy.due(base(), 123456UL));
+
+    policy.reported(base(), 0);
+    TEST_ASSERT_FALSE(policy.changed(base()));
+    TEST_ASSERT_FALSE(policy.due(base(), SAMPLE_PERIOD));
+
+    // After a lost uplink the next reading is reported whatever it is
+    policy.reset();
+    TEST_ASSERT_TRUE(policy.due(base(), SAMPLE_PERIOD));
+}
+
+void test_absolute_deadband(void) {
+    ReportPolicy policy(STATION_DEADBAND);
+    policy.reported(base(), 0);
+
+    // 0.3 oC: a move of 0.29 oC is not reported, 0.3 oC is (up or down)
+    TEST_ASSERT_FALSE(policy.changed(reading(2029, 600, 1000, 3, 4000)));
+    TEST_ASSERT_FALSE(policy.changed(reading(1971, 600, 1000, 3, 4000)));
+    TEST_ASSERT_TRUE(policy.changed(reading(2030, 600, 1000, 3, 4000)));
+    TEST_ASSERT_TRUE(policy.changed(reading(1970, 600, 1000, 3, 4000)));
+
+    // Every field has its own band: 2 % RH, any UV index step and 100 mV
+    TEST_ASSERT_FALSE(policy.changed(reading(2000, 619, 1000, 3, 3901)));
+    TEST_ASSERT_TRUE(policy.changed(reading(2000, 620, 1000, 3, 4000)));
+    TEST_ASSERT_TRUE(policy.changed(reading(2000, 600, 1000, 2, 4000)));
+    TEST_ASSERT_TRUE(policy.changed(reading(2000, 600, 1000, 3, 3900)));
+
+    // Small moves of every field at once are still not reported
+    TEST_ASSERT_FALSE(policy.changed(reading(2029, 581, 1099, 3, 4099)));
+}
+
+void test_relative_deadband(void) {
+    ReportPolicy policy(STATION_DEADBAND);
+
+    // 10 % of 1000 lux is larger than the absolute band (5 lux)
+    policy.reported(base(), 0);
+    TEST_ASSERT_FALSE(policy.changed(reading(2000, 600, 1099, 3, 4000)));
+    TEST_ASSERT_FALSE(policy.changed(reading(2000, 600, 901, 3, 4000)));
+    TEST_ASSERT_TRUE(policy.changed(reading(2000, 600, 1100, 3, 4000)));
+    TEST_ASSERT_TRUE(policy.changed(reading(2000, 600, 900, 3, 4000)));
+
+    // 10 % of 20 lux is smaller: the absolute band applies
+    policy.reported(reading(2000, 600, 20, 3, 4000), 0);
+    TEST_ASSERT_FALSE(policy.changed(reading(2000, 600, 24, 3, 4000)));
+    TEST_ASSERT_TRUE(policy.changed(reading(2000, 600, 25, 3, 4000)));
+    TEST_ASSERT_TRUE(policy.changed(reading(2000, 600, 15, 3, 4000)));
+
+    // Darkness: any light above the absolute band is reported
+    policy.reported(reading(2000, 600, 0, 0, 4000), 0);
+    TEST_ASSERT_FALSE(policy.changed(reading(2000, 600, 4, 0, 4000)));
+    TEST_ASSERT_TRUE(policy.changed(reading(2000, 600, 5, 0, 4000)));
+
+    // The relative band is taken from the magnitude of a negative reference (-10 oC: 1 oC)
+    ReportPolicy relative(RELATIVE_DEADBAND);
+    relative.reported(reading(-1000, 600, 1000, 3, 4000), 0);
+    TEST_ASSERT_FALSE(relative.changed(reading(-1099, 600, 1000, 3, 4000)));
+    TEST_ASSERT_FALSE(relative.changed(reading(-901, 600, 1000, 3, 4000)));
+    TEST_ASSERT_TRUE(relative.changed(reading(-1100, 600, 1000, 3, 4000)));
+    TEST_ASSERT_TRUE(relative.changed(reading(-900, 600, 1000, 3, 4000)));
+}
+
+void test_validity_transitions(void) {
+    ReportPolicy policy(STATION_DEADBAND);
+    STATION_SENSORS_T failed = base();
+    failed.invalidate(SENSOR_AIR_TEMPERATURE);
+    failed.invalidate(SENSOR_AIR_HUMIDITY);
+
+    // A field that fails or comes back is reported, whatever its value
+    policy.reported(base(), 0);
+    TEST_ASSERT_TRUE(policy.changed(failed));
+    policy.reported(failed, 0);
+    TEST_ASSERT_TRUE(policy.changed(base()));
+
+    // A field that stays invalid is not compared
+    STATION_SENSORS_T stillFailed = reading(0, 0, 1000, 3, 4000);
+    stillFailed.invalidate(SENSOR_AIR_TEMPERATURE);
+    stillFailed.invalidate(SENSOR_AIR_HUMIDITY);
+    TEST_ASSERT_FALSE(policy.changed(stillFailed));
+
+    // A value that does not fit its field is invalid too
+    STATION_SENSORS_T outOfRange = base();
+    TEST_ASSERT_FALSE(outOfRange.set(SENSOR_AIR_HUMIDITY, 2000));
+    policy.reported(base(), 0);
+    TEST_ASSERT_TRUE(policy.changed(outOfRange));
+}
+
+void test_heartbeat_wrap(void) {
+    ReportPolicy policy(STATION_DEADBAND);
+
+    // The heartbeat is measured across the wrap of the 32 bits clock (49.7 days)
+    uint32_t last = UINT32_MAX - (HEARTBEAT / 2);
+    policy.reported(base(), last);
+    TEST_ASSERT_FALSE(policy.due(base(), last + SAMPLE_PERIOD));
+    TEST_ASSERT_FALSE(policy.due(base(), last + HEARTBEAT - 1));
+    TEST_ASSERT_TRUE(policy.due(base(), last + HEARTBEAT));
+    TEST_ASSERT_TRUE(policy.due(base(), last + HEARTBEAT + SAMPLE_PERIOD));
+
+    // A change is due at once
+    TEST_ASSERT_TRUE(policy.due(reading(2030, 600, 1000, 3, 4000), last + 1));
+}
+
+void test_day_traces(void) {
+    char text[96];
+
+    // Steady readings: only the heartbeat (one uplink per hour, the first reading included)
+    ReportSimulator steady(STATION_DEADBAND, SAMPLE_PERIOD);
+    for (uint16_t i = 0; i < DAY_READINGS; i++) {
+        steady.feed(base());
+    }
+    TEST_ASSERT_EQUAL_UINT32(DAY_READINGS, steady.samples);
+    TEST_ASSERT_EQUAL_UINT32(DAY_READINGS / 60, steady.uplinks);
+    TEST_ASSERT_EQUAL_UINT32((DAY_READINGS / 60) - 1, steady.heartbeats);
+
+    // Clear and cloudy days: report on change sends about an eighth of the fixed cadence uplinks (one per
+    // reading); the readings change within every hour, so the heartbeat only fires in the night
+    const uint32_t uplinks[2] = { 162, 197 };
+    for (uint8_t cloudy = 0; cloudy < 2; cloudy++) {
+        ReportSimulator day(STATION_DEADBAND, SAMPLE_PERIOD);
+        replayDay(day, cloudy != 0);
+        TEST_ASSERT_EQUAL_UINT32(DAY_READINGS, day.samples);
+        TEST_ASSERT_EQUAL_UINT32(uplinks[cloudy], day.uplinks);
+        TEST_ASSERT_EQUAL_UINT32(1, day.heartbeats);
+        snprintf(text, sizeof(text), "%s day: %lu uplinks (%lu heartbeats) against %lu at fixed cadence",
+                 cloudy ? "cloudy" : "clear", (unsigned long) day.uplinks, (unsigned long) day.heartbeats,
+                 (unsigned long) day.samples);
+        TEST_MESSAGE(text);
+    }
+}
+
+int main(int argc, char** argv) {
+    (void) argc;
+    (void) argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_first_reading_is_due);
+    RUN_TEST(test_absolute_deadband);
+    RUN_TEST(test_relative_deadband);
+    RUN_TEST(test_validity_transitions);
+    RUN_TEST(test_heartbeat_wrap);
+    RUN_TEST(test_day_traces);
+    return UNITY_END();
+}
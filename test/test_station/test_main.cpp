@@ -0,0 +1,137 @@
+/**
+ * @file test_main.cpp
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief Station tests of the native build: boot, a day of uplinks and modem faults (simulated devices).
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ *
+ * The tests share the station objects and run in order, like one station switched on once.
+ */
+#include <unity.h>
+#include "ats_01_station.h"
+
+/** Run \c loop() for \p ms of wall clock time. */
+static void runFor(uint32_t ms) {
+    uint32_t end = sleepPlatform.realMs + ms;
+    while (sleepPlatform.realMs < end) {
+        loop();
+    }
+}
+
+/** Set steady sensor inputs (20 oC, 65 %, 1000 lux, UV index 1, about 3.9 V). */
+static void steadyWeather() {
+    dht.temperature = 200;
+    dht.humidity = 650;
+    light.sensor.lux = 1000;
+    adc.codes[UVM30A_PIN - A0] = 50;
+    adc.codes[VOLTAGE_SENSOR_PIN - A0] = 326;
+}
+
+void setUp(void) { }
+
+void tearDown(void) { }
+
+void test_boot_configures_modem(void) {
+    steadyWeather();
+    setup();
+    TEST_ASSERT_FALSE(configError);
+    unsigned long start = millis();
+    TEST_ASSERT_TRUE(lora.initModem(loraCfg));
+    TEST_ASSERT_EQUAL(AU920, loraSerial.modem.loraBand());
+    TEST_ASSERT_LESS_THAN(1000UL, millis() - start);
+    TEST_ASSERT_EQUAL(LORA_IDLE, lora.getState());
+}
+
+void test_debug_output_stays_off_the_modem(void) {
+    // Without the debug serial port the driver messages are dropped: a boot in debug mode writes the same commands
+    // into the modem port as a quiet one
+    uint32_t commands = loraSerial.modem.commands;
+    TEST_ASSERT_TRUE(lora.initModem(loraCfg));
+    uint32_t quiet = loraSerial.modem.commands - commands;
+
+    loraCfg.debug = true;
+    commands = loraSerial.modem.commands;
+    bool booted = lora.initModem(loraCfg);
+    loraCfg.debug = SERIAL_DEBUG;
+    TEST_ASSERT_TRUE(booted);
+    TEST_ASSERT_EQUAL_UINT32(quiet, loraSerial.modem.commands - commands);
+}
+
+void test_day_of_uplinks(void) {
+    uint32_t uplinks = loraSerial.modem.uplinks;
+    uint32_t airtime = loraSerial.modem.airtime;
+    uint16_t dhtReads = dhtStats.reads;
+    uint32_t results = rateController.results();
+    runFor(24UL * 3600000UL);
+
+    // Steady readings: the first one and the hourly heartbeats
+    TEST_ASSERT_UINT32_WITHIN(2, 25, loraSerial.modem.uplinks - uplinks);
+    TEST_ASSERT_LESS_OR_EQUAL(24UL * LORA_BUDGET_FAIR_USE, loraSerial.modem.airtime - airtime);
+    TEST_ASSERT_EQUAL_UINT16(0, recordLog.pending());
+    TEST_ASSERT_UINT32_WITHIN(1, 1440, dhtStats.reads - dhtReads);
+    TEST_ASSERT_EQUAL_UINT16(0, dhtStats.failures);
+    TEST_ASSERT_EQUAL_UINT32(loraSerial.modem.uplinks - uplinks, rateController.results() - results);
+}
+
+void test_feedback_once_per_uplink(void) {
+    // Three hours of readings changing every 10 min, with a downlink queued every 30 min: every uplink result is
+    // fed once into the data rate controller (a downlink SNR, a link check margin or no feedback), not once per
+    // loop() pass
+    const uint8_t downlink[] = { 0x01 };
+    uint32_t uplinks = loraSerial.modem.uplinks;
+    uint32_t results = rateController.results();
+    for (uint8_t i = 0; i < 18; i++) {
+        if (i % 3 == 0) {
+            loraSerial.modem.queueDownlink(2, downlink, sizeof(downlink));
+        }
+        dht.temperature = (int16_t) (dht.temperature + 10);
+        runFor(600000UL);
+    }
+    TEST_ASSERT_GREATER_OR_EQUAL(uplinks + 9, loraSerial.modem.uplinks);
+    TEST_ASSERT_EQUAL_UINT32(loraSerial.modem.uplinks - uplinks, rateController.results() - results);
+    TEST_ASSERT_EQUAL_UINT16(0, recordLog.pending());
+}
+
+void test_modem_faults_do_not_stall(void) {
+    const ModemFault_e faults[] = { MODEM_FAULT_ERROR, MODEM_FAULT_SILENT, MODEM_FAULT_BUSY, MODEM_FAULT_NO_CHANNEL };
+    const char* commands[] = { "MSGHEX", "PORT" };
+
+    // Changing temperature: a report every sampling period, one fault per report
+    for (uint8_t i = 0; i < 8; i++) {
+        loraSerial.modem.inject(commands[i % 2], faults[i % 4]);
+        dht.temperature = (int16_t) (dht.temperature + 10);
+        runFor(60000UL);
+    }
+    TEST_ASSERT_GREATER_THAN(0, recordLog.pending());
+
+    // The readings kept into the log are sent as soon as the radio works again, within the airtime budget: at
+    // AU920 DR0 a backlog uplink carries one reading, so about two readings of the log are drained per hour
+    uint32_t uplinks = loraSerial.modem.uplinks;
+    runFor(6UL * 3600000UL);
+    TEST_ASSERT_GREATER_THAN(uplinks, loraSerial.modem.uplinks);
+    TEST_ASSERT_EQUAL_UINT16(0, recordLog.pending());
+    TEST_ASSERT_EQUAL_UINT32(0, loraSerial.modem.rejected);
+}
+
+int main(int argc, char** argv) {
+    (void) argc;
+    (void) argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_boot_configures_modem);
+#if (SERIAL_DEBUG == false)
+    RUN_TEST(test_debug_output_stays_off_the_modem);
+#endif
+    RUN_TEST(test_day_of_uplinks);
+    RUN_TEST(test_feedback_once_per_uplink);
+    RUN_TEST(test_modem_faults_do_not_stall);
+    return UNITY_END();
+}
@@ -0,0 +1,183 @@
+/**
+ * @file test_main.cpp
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief Task dispatcher tests of the native build: dispatch order, phases, skipped runs, timer wrap-around and
+ * the jitter of a sleeping station (see \ref SimulatedSleep).
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#include <unity.h>
+#include "ats_01_sleep.h"
+#include "ats_01_tasks.h"
+
+#define TRACE_SIZE                      64
+
+static char trace[TRACE_SIZE + 1];      /**< Tasks run (one letter each). */
+static uint8_t traced = 0;
+static uint32_t busyMs = 0;             /**< Time taken by task B (in ms, see \ref taskB). */
+static SimulatedSleep sim;
+
+static void mark(char id) {
+    if (traced < TRACE_SIZE) {
+        trace[traced++] = id;
+        trace[traced] = '\0';
+    }
+}
+
+static void taskA() { mark('A'); }
+
+/** Task B takes \ref busyMs of awake time. */
+static void taskB() {
+    mark('B');
+    for (uint32_t i = 0; i < busyMs; i++) {
+        sim.idle();
+    }
+}
+
+static void taskC() { mark('C'); }
+
+static const PeriodicTask_t taskTable[] = {
+    { taskA, 1000, 0 },
+    { taskB, 2000, 0 },
+    { taskC, 1000, 500 }
+};
+
+void setUp(void) {
+    traced = 0;
+    trace[0] = '\0';
+    busyMs = 0;
+}
+
+void tearDown(void) { }
+
+void test_table_order_and_phases(void) {
+    TaskDispatcher<3> dispatcher(taskTable);
+    dispatcher.begin(0);
+    TEST_ASSERT_EQUAL_UINT32(0, dispatcher.nextDue(0));
+
+    // Tasks due together run in table order, a phase delays the first run
+    TEST_ASSERT_EQUAL_UINT8(2, dispatcher.dispatch(0));
+    TEST_ASSERT_EQUAL_STRING("AB", trace);
+    TEST_ASSERT_EQUAL_UINT32(500, dispatcher.nextDue(0));
+    TEST_ASSERT_EQUAL_UINT8(0, dispatcher.dispatch(499));
+    TEST_ASSERT_EQUAL_UINT8(1, dispatcher.dispatch(500));
+    TEST_ASSERT_EQUAL_UINT8(1, dispatcher.dispatch(1000));
+    TEST_ASSERT_EQUAL_UINT8(1, dispatcher.dispatch(1500));
+    TEST_ASSERT_EQUAL_UINT8(2, dispatcher.dispatch(2000));
+    TEST_ASSERT_EQUAL_STRING("ABCACAB", trace);
+    for (uint8_t i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL_UINT32(0, dispatcher.getMaxJitter(i));
+    }
+}
+
+void test_late_dispatch_skips_missed_runs(void) {
+    TaskDispatcher<3> dispatcher(taskTable);
+    dispatcher.begin(0);
+    dispatcher.dispatch(0);
+
+    // 3.2 s late: every task runs once and keeps its phase
+    TEST_ASSERT_EQUAL_UINT8(3, dispatcher.dispatch(3700));
+    TEST_ASSERT_EQUAL_STRING("ABABC", trace);
+    TEST_ASSERT_EQUAL_UINT32(2700, dispatcher.getMaxJitter(0));
+    TEST_ASSERT_EQUAL_UINT32(1700, dispatcher.getMaxJitter(1));
+    TEST_ASSERT_EQUAL_UINT32(3200, dispatcher.getMaxJitter(2));
+    TEST_ASSERT_EQUAL_UINT32(4000, dispatcher.nextDue(3700));
+    TEST_ASSERT_EQUAL_UINT8(2, dispatcher.dispatch(4000));
+    TEST_ASSERT_EQUAL_UINT8(1, dispatcher.dispatch(4500));
+    TEST_ASSERT_EQUAL_STRING("ABABCABC", trace);
+}
+
+void test_timer_wrap_around(void) {
+    TaskDispatcher<3> dispatcher(taskTable);
+    uint32_t start = UINT32_MAX - 1200;
+    dispatcher.begin(start);
+    dispatcher.dispatch(start);
+    TEST_ASSERT_EQUAL_UINT32(start + 500, dispatcher.nextDue(start));
+
+    // Due times past the wrap-around of the ms counter are still in the future
+    TEST_ASSERT_EQUAL_UINT8(1, dispatcher.dispatch(start + 500));
+    TEST_ASSERT_EQUAL_UINT32(start + 1000, dispatcher.nextDue(start + 500));
+    TEST_ASSERT_EQUAL_UINT8(0, dispatcher.dispatch(start + 999));
+    TEST_ASSERT_EQUAL_UINT8(1, dispatcher.dispatch(start + 1000));
+    TEST_ASSERT_EQUAL_UINT8(1, dispatcher.dispatch(start + 1500));
+    TEST_ASSERT_EQUAL_UINT8(2, dispatcher.dispatch(start + 2000));
+    TEST_ASSERT_EQUAL_STRING("ABCACAB", trace);
+    for (uint8_t i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL_UINT32(0, dispatcher.getMaxJitter(i));
+    }
+}
+
+void test_sleeping_station_jitter(void) {
+    // A watchdog 10 % slower than nominal, calibrated at boot, and a task taking 30 ms
+    sim = SimulatedSleep();
+    sim.wdtUs = 17600;
+    busyMs = 30;
+    SleepScheduler<SimulatedSleep> scheduler(sim);
+    scheduler.begin();
+    TaskDispatcher<3> dispatcher(taskTable);
+    dispatcher.begin(scheduler.now());
+
+    uint32_t runs = 0;
+    while (sim.realMs < 3600000UL) {
+        uint32_t now = scheduler.now();
+        if ((int32_t) (dispatcher.nextDue(now) - now) <= 0) {
+            runs += dispatcher.dispatch(now);
+        }
+        scheduler.sleepUntil(dispatcher.nextDue(scheduler.now()));
+    }
+
+    // One hour: 3600 runs of A and C and 1800 of B, nearly all of it powered down
+    TEST_ASSERT_UINT32_WITHIN(3, 9000, runs);
+    TEST_ASSERT_EQUAL_UINT32(0, dispatcher.getMaxJitter(0));
+    TEST_ASSERT_EQUAL_UINT32(0, dispatcher.getMaxJitter(1));
+    TEST_ASSERT_LESS_OR_EQUAL(busyMs, dispatcher.getMaxJitter(2));
+    TEST_ASSERT_GREATER_THAN(sim.realMs * 9 / 10, sim.poweredDownMs);
+
+    // The logical time follows the wall clock
+    TEST_ASSERT_UINT32_WITHIN(20, sim.realMs, scheduler.now());
+}
+
+void test_interrupts_while_powered_down(void) {
+    // Interrupts every 700 ms wake the MCU while it is powered down: the time slept is still counted, so the
+    // logical time and the task deadlines do not drift late
+    sim = SimulatedSleep();
+    sim.interruptMs = 700;
+    busyMs = 0;
+    SleepScheduler<SimulatedSleep> scheduler(sim);
+    scheduler.begin();
+    TaskDispatcher<3> dispatcher(taskTable);
+    dispatcher.begin(scheduler.now());
+
+    uint32_t runs = 0;
+    while (sim.realMs < 3600000UL) {
+        uint32_t now = scheduler.now();
+        if ((int32_t) (dispatcher.nextDue(now) - now) <= 0) {
+            runs += dispatcher.dispatch(now);
+        }
+        scheduler.sleepUntil(dispatcher.nextDue(scheduler.now()));
+    }
+    TEST_ASSERT_GREATER_THAN(3600000UL / sim.interruptMs / 2, sim.earlyWakes);
+    TEST_ASSERT_UINT32_WITHIN(3, 9000, runs);
+    TEST_ASSERT_UINT32_WITHIN(20, sim.realMs, scheduler.now());
+}
+
+int main(int argc, char** argv) {
+    (void) argc;
+    (void) argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_table_order_and_phases);
+    RUN_TEST(test_late_dispatch_skips_missed_runs);
+    RUN_TEST(test_timer_wrap_around);
+    RUN_TEST(test_sleeping_station_jitter);
+    RUN_TEST(test_interrupts_while_powered_down);
+    return UNITY_END();
+}
@@ -0,0 +1,85 @@
+/**
+ * @file test_main.cpp
+ * @author Robson Costa (robson.costa@ifsc.edu.br)
+ * @brief UV index lookup tests of the native build: the compile time table against a direct scan of
+ * \ref UV_INDEX_MV for every ADC code.
+ * @version 0.1.0
+ * @since 2026-10-17
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021 - Robson Costa\n
+ * Licensed under the Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International Unported License (the <em>"License"</em>).
+ * You may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * \url{https://creativecommons.org/licenses/by-nc-sa/4.0/legalcode}. Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an <em>"as is" basis, without warranties or
+ * conditions of any kind</em>, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#include <unity.h>
+#include "ats_01_uv.h"
+
+#define UV_LEVELS                       (sizeof(UV_INDEX_MV) / sizeof(UV_INDEX_MV[0]))
+
+/** UV index of an ADC code by a run time scan (the voltage at the middle of the code, in whole mV). */
+static uint8_t scanIndex(uint16_t code) {
+    uint16_t mv = (uint16_t) (((code + 0.5) * UV_ADC_VREF_MV) / UV_ADC_CODES);
+    uint8_t index = 0;
+    while ((index < UV_LEVELS) && (mv > UV_INDEX_MV[index])) {
+        index++;
+    }
+    return index;
+}
+
+void setUp(void) { }
+
+void tearDown(void) { }
+
+void test_every_adc_code(void) {
+    for (uint16_t code = 0; code < UV_ADC_CODES; code++) {
+        TEST_ASSERT_EQUAL_UINT8_MESSAGE(scanIndex(code), uvIndexOfAdc(code), "ADC code");
+    }
+}
+
+void test_monotonic_and_complete(void) {
+    // The index never decreases and takes every value 0 .. 12 (no UV level is skipped by the ADC resolution)
+    uint16_t first[UV_LEVELS + 1];
+    uint8_t previous = 0;
+    for (uint8_t i = 0; i <= UV_LEVELS; i++) {
+        first[i] = UINT16_MAX;
+    }
+    for (uint16_t code = 0; code < UV_ADC_CODES; code++) {
+        uint8_t index = uvIndexOfAdc(code);
+        TEST_ASSERT_GREATER_OR_EQUAL(previous, index);
+        TEST_ASSERT_LESS_OR_EQUAL(previous + 1, index);
+        if (first[index] == UINT16_MAX) {
+            first[index] = code;
+        }
+        previous = index;
+    }
+    for (uint8_t i = 0; i <= UV_LEVELS; i++) {
+        TEST_ASSERT_NOT_EQUAL(UINT16_MAX, first[i]);
+    }
+
+    // Each level starts at the first code above the bound of the previous one
+    for (uint8_t i = 1; i <= UV_LEVELS; i++) {
+        TEST_ASSERT_GREATER_THAN(UV_INDEX_MV[i - 1], adcCodeToMv(first[i]));
+        TEST_ASSERT_LESS_OR_EQUAL(UV_INDEX_MV[i - 1], adcCodeToMv(first[i] - 1));
+    }
+}
+
+void test_codes_above_range_are_clamped(void) {
+    TEST_ASSERT_EQUAL_UINT8(0, uvIndexOfAdc(0));
+    TEST_ASSERT_EQUAL_UINT8(UV_LEVELS, uvIndexOfAdc(UV_ADC_CODES - 1));
+    TEST_ASSERT_EQUAL_UINT8(UV_LEVELS, uvIndexOfAdc(UV_ADC_CODES));
+    TEST_ASSERT_EQUAL_UINT8(UV_LEVELS, uvIndexOfAdc(UINT16_MAX));
+}
+
+int main(int argc, char** argv) {
+    (void) argc;
+    (void) argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_every_adc_code);
+    RUN_TEST(test_monotonic_and_complete);
+    RUN_TEST(test_codes_above_range_are_clamped);
+    return UNITY_END();
+}